@@ -1,6 +1,7 @@
 #include <chrono>
 #include <cstdlib>
 #include <ctime>
+#include <filesystem>
 #include <format>
 #include <fstream>
 #include <iomanip>
@@ -18,6 +19,9 @@ using namespace evolab;
 namespace {
 constexpr int DEFAULT_RANDOM_CITIES = 100;
 constexpr double DEFAULT_MAX_COORD = 1000.0;
+
+// Candidate list size of factory::make_tsp_ga_advanced, stored in its instance caches
+constexpr int ADVANCED_CANDIDATE_K = 20;
 } // namespace
 
 /// Command-line arguments structure
@@ -35,6 +39,16 @@ struct CLIConfig {
     std::string output_file;
     bool json_output = false;
     std::string json_file;
+    bool lazy_distances = false;
+    problems::CityOrdering city_ordering = problems::CityOrdering::Original;
+    std::string cache_dir; // Empty: default_cache_dir()
+    bool use_cache = true;
+    std::size_t islands = 1; // More than one runs core::IslandModel
+    std::size_t migration_interval = 50;
+    bool async_migration = false;
+    std::string checkpoint_file; // Empty: [logging] checkpoint_path of the configuration
+    std::size_t checkpoint_interval = 0; // 0: [logging] checkpoint_interval
+    bool track_operators = false;        // Or [logging] track_operator_performance
 
     // Runtime warnings for JSON output transparency
     mutable std::vector<std::string> warnings;
@@ -126,6 +140,19 @@ void print_usage(const char* program_name) {
               << "  -o, --output FILE       Output file for best tour\n"
               << "  --json                  Enable JSON output format\n"
               << "  --json-file FILE        Write JSON results to file\n"
+              << "  --lazy-distances        Compute distances from coordinates (O(n) memory)\n"
+              << "  --reorder CURVE         Renumber cities for locality: none, hilbert, morton\n"
+              << "                          (default: none; bypasses the instance cache)\n"
+              << "  --cache-dir DIR         Binary instance cache directory (default:\n"
+              << "                          $EVOLAB_CACHE_DIR or $XDG_CACHE_HOME/evolab)\n"
+              << "  --no-cache              Always parse the instance file\n"
+              << "  --islands N             Island model with N islands of --population each\n"
+              << "                          (default: 1, a single population)\n"
+              << "  --migration-interval G  Generations between migrations (default: 50)\n"
+              << "  --async-migration       Migrate through lock-free queues, without barriers\n"
+              << "  --checkpoint FILE       Resume from FILE if it exists and checkpoint to it\n"
+              << "  --checkpoint-interval G Generations between checkpoints (default: 100)\n"
+              << "  --track-operators       Report the time spent in each phase of a generation\n"
               << "\nExamples:\n"
               << "  " << program_name << " --config config/basic.toml --instance data/pr76.tsp\n"
               << "  " << program_name << " --algorithm advanced --population 512\n"
@@ -173,6 +200,41 @@ CLIConfig parse_args(int argc, char** argv) {
         } else if (arg == "--json-file" && i + 1 < argc) {
             config.json_file = argv[++i];
             config.json_output = true;
+        } else if (arg == "--lazy-distances") {
+            config.lazy_distances = true;
+        } else if (arg == "--reorder" && i + 1 < argc) {
+            const std::string curve = argv[++i];
+            if (curve == "none") {
+                config.city_ordering = problems::CityOrdering::Original;
+            } else if (curve == "hilbert") {
+                config.city_ordering = problems::CityOrdering::Hilbert;
+            } else if (curve == "morton") {
+                config.city_ordering = problems::CityOrdering::Morton;
+            } else {
+                std::cerr << "Unknown reorder curve: " << curve << "\n";
+                print_usage(argv[0]);
+                std::exit(1);
+            }
+        } else if (arg == "--cache-dir" && i + 1 < argc) {
+            config.cache_dir = argv[++i];
+        } else if (arg == "--no-cache") {
+            config.use_cache = false;
+        } else if (arg == "--islands" && i + 1 < argc) {
+            config.islands = std::stoull(argv[++i]);
+            if (config.islands == 0) {
+                std::cerr << "--islands must be at least 1\n";
+                std::exit(1);
+            }
+        } else if (arg == "--migration-interval" && i + 1 < argc) {
+            config.migration_interval = std::stoull(argv[++i]);
+        } else if (arg == "--async-migration") {
+            config.async_migration = true;
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            config.checkpoint_file = argv[++i];
+        } else if (arg == "--checkpoint-interval" && i + 1 < argc) {
+            config.checkpoint_interval = std::stoull(argv[++i]);
+        } else if (arg == "--track-operators") {
+            config.track_operators = true;
         } else {
             std::cerr << "Unknown argument: " << arg << "\n";
             print_usage(argv[0]);
@@ -183,6 +245,98 @@ CLIConfig parse_args(int argc, char** argv) {
     return config;
 }
 
+/// Default directory for binary instance caches; empty if none can be determined
+std::filesystem::path default_cache_dir() {
+    if (const char* dir = std::getenv("EVOLAB_CACHE_DIR"); dir != nullptr && *dir != '\0') {
+        return dir;
+    }
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg != nullptr && *xdg != '\0') {
+        return std::filesystem::path(xdg) / "evolab";
+    }
+    if (const char* home = std::getenv("HOME"); home != nullptr && *home != '\0') {
+        return std::filesystem::path(home) / ".cache" / "evolab";
+    }
+    return {};
+}
+
+/// Cache file for an instance, keyed by its content hash and the storage it needs;
+/// empty if no cache directory is available
+std::filesystem::path instance_cache_path(const CLIConfig& cli_config, std::uint64_t source_hash,
+                                          int candidate_k) {
+    const auto dir = cli_config.cache_dir.empty() ? default_cache_dir()
+                                                   : std::filesystem::path(cli_config.cache_dir);
+    std::error_code error;
+    if (dir.empty() || (std::filesystem::create_directories(dir, error), error)) {
+        return {};
+    }
+    return dir / std::format("{:016x}-{}-k{}.evc", source_hash,
+                             cli_config.lazy_distances ? "lazy" : "matrix", candidate_k);
+}
+
+/// Load a TSPLIB instance through the binary instance cache
+///
+/// A valid cache is memory-mapped without parsing the TSPLIB file or rebuilding the distance
+/// matrix. Otherwise the file is parsed and the cache written for the next run; cache errors
+/// are reported as warnings and never prevent loading the instance. Renumbered instances
+/// (--reorder) are always built from the file, since caches hold source city ids only.
+problems::TSP load_tsplib_problem(CLIConfig& cli_config) {
+    const int candidate_k = cli_config.algorithm == "advanced" ? ADVANCED_CANDIDATE_K : 0;
+    const problems::DistanceOptions options{
+        .mode = cli_config.lazy_distances ? problems::DistanceMode::Lazy
+                                          : problems::DistanceMode::Matrix,
+        .ordering = cli_config.city_ordering};
+    auto report = [&](const io::TSPInstance& instance, bool cached) {
+        if (!cli_config.json_output) {
+            std::cout << "Loaded: " << instance.name << " (" << instance.dimension << " cities"
+                      << (cached ? ", from cache" : "") << ")\n";
+            if (!instance.comment.empty()) {
+                std::cout << "Comment: " << instance.comment << "\n";
+            }
+        }
+    };
+    auto warn = [&](const std::string& message) {
+        std::cerr << message << "\n";
+        cli_config.warnings.push_back(message);
+    };
+
+    std::filesystem::path cache_path;
+    std::uint64_t source_hash = 0;
+    try {
+        // A missing instance file is reported by the parser below
+        if (cli_config.use_cache && options.ordering == problems::CityOrdering::Original &&
+            std::filesystem::is_regular_file(cli_config.instance_file)) {
+            source_hash = io::hash_file(cli_config.instance_file);
+            cache_path = instance_cache_path(cli_config, source_hash, candidate_k);
+        }
+        if (!cache_path.empty() && std::filesystem::exists(cache_path)) {
+            const io::InstanceCache cache(cache_path.string());
+            if (cache.source_hash() == source_hash) {
+                report(cache.instance(), true);
+                return problems::TSP::from_cache(cache);
+            }
+        }
+    } catch (const std::exception& e) {
+        warn("Ignoring instance cache " + cache_path.string() + ": " + e.what());
+    }
+
+    io::TSPLIBParser parser;
+    const auto instance = parser.parse_file(cli_config.instance_file);
+    report(instance, false);
+    if (!cache_path.empty()) {
+        try {
+            {
+                const auto built = problems::TSP::from_tsplib(instance, options);
+                built.write_cache(cache_path.string(), instance, source_hash, candidate_k);
+            }
+            // Reopen so this run shares the mapped pages with later runs
+            return problems::TSP::from_cache(io::InstanceCache(cache_path.string()));
+        } catch (const std::exception& e) {
+            warn("Could not write instance cache " + cache_path.string() + ": " + e.what());
+        }
+    }
+    return problems::TSP::from_tsplib(instance, options);
+}
+
 /// Create TSP problem from CLI config
 problems::TSP create_problem(CLIConfig& cli_config, std::uint64_t seed) {
     if (cli_config.instance_file.empty()) {
@@ -198,16 +352,7 @@ problems::TSP create_problem(CLIConfig& cli_config, std::uint64_t seed) {
             std::cout << "Loading TSPLIB instance: " << cli_config.instance_file << "\n";
         }
         try {
-            io::TSPLIBParser parser;
-            auto instance = parser.parse_file(cli_config.instance_file);
-            if (!cli_config.json_output) {
-                std::cout << "Loaded: " << instance.name << " (" << instance.dimension
-                          << " cities)\n";
-                if (!instance.comment.empty()) {
-                    std::cout << "Comment: " << instance.comment << "\n";
-                }
-            }
-            return problems::TSP::from_tsplib(instance);
+            return load_tsplib_problem(cli_config);
         } catch (const std::exception& e) {
             // Always output to stderr for debugging (RFC 9457 best practice)
             std::cerr << "Failed to load TSPLIB file: " << e.what() << "\n";
@@ -270,6 +415,9 @@ void write_json_output(const auto& result, const CLIConfig& cli_config, const co
     // Configuration section
     output["configuration"] = {{"instance_file", cli_config.instance_file},
                                {"algorithm", cli_config.algorithm},
+                               {"islands", cli_config.islands},
+                               {"migration_interval", cli_config.migration_interval},
+                               {"async_migration", cli_config.async_migration},
                                {"population_size", cfg.ga.population_size},
                                {"max_generations", cfg.ga.max_generations},
                                {"crossover_probability", cfg.operators.crossover.probability},
@@ -277,7 +425,10 @@ void write_json_output(const auto& result, const CLIConfig& cli_config, const co
                                {"seed", cfg.ga.seed}};
 
     // Problem section
-    output["problem"] = {{"type", "TSP"}, {"dimension", tsp.num_cities()}};
+    // best_tour_sample is in source city ids even when renumbered
+    output["problem"] = {{"type", "TSP"},
+                         {"dimension", tsp.num_cities()},
+                         {"renumbered", tsp.is_renumbered()}};
 
     // Warnings section for error transparency (RFC 9457 best practice)
     if (!cli_config.warnings.empty()) {
@@ -306,6 +457,20 @@ void write_json_output(const auto& result, const CLIConfig& cli_config, const co
     }
     results["best_tour_sample"] = tour_sample;
     results["tour_length"] = result.best_genome.size();
+    if (cfg.logging.track_operator_performance) {
+        json phases;
+        for (std::size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            const auto phase = static_cast<core::Phase>(p);
+            const auto& stats = result.operator_stats[phase];
+            phases[std::string(core::phase_name(phase))] = {
+                {"executions", stats.executions},
+                {"total_ms", static_cast<double>(stats.total_time.count()) / 1e6},
+                {"average_ms", stats.average_time_ms()},
+                {"successes", stats.successes},
+                {"average_improvement", stats.average_improvement}};
+        }
+        results["operator_stats"] = phases;
+    }
     output["results"] = results;
 
     // Evolution history section (last 5 entries)
@@ -347,6 +512,25 @@ void print_stats(const auto& result, const CLIConfig& cli_config, double runtime
     std::cout << "Runtime: " << std::fixed << std::setprecision(3) << runtime << " seconds\n";
     std::cout << "Converged: " << (result.converged ? "Yes" : "No") << "\n";
 
+    // Only recorded with operator tracking enabled
+    const auto tracked_time = result.operator_stats.total_time();
+    if (tracked_time.count() > 0) {
+        std::cout << "\n=== Operator Timings ===\n";
+        std::cout << std::setw(14) << "Phase" << std::setw(14) << "Executions" << std::setw(14)
+                  << "Total(ms)" << std::setw(10) << "Share\n";
+        std::cout << std::string(52, '-') << "\n";
+        for (std::size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            const auto phase = static_cast<core::Phase>(p);
+            const auto& stats = result.operator_stats[phase];
+            const double total_ms = static_cast<double>(stats.total_time.count()) / 1e6;
+            const double share = 100.0 * static_cast<double>(stats.total_time.count()) /
+                                 static_cast<double>(tracked_time.count());
+            std::cout << std::setw(14) << core::phase_name(phase) << std::setw(14)
+                      << stats.executions << std::setw(14) << std::fixed << std::setprecision(2)
+                      << total_ms << std::setw(9) << std::setprecision(1) << share << "%\n";
+        }
+    }
+
     if (cli_config.verbose && !result.history.empty()) {
         std::cout << "\n=== Evolution History ===\n";
         std::cout << std::setw(10) << "Gen" << std::setw(15) << "Best" << std::setw(15) << "Mean"
@@ -402,6 +586,16 @@ int main(int argc, char** argv) {
             std::cout << "Problem size: " << tsp.num_cities() << " cities\n";
         }
 
+        if (!cli_config.checkpoint_file.empty()) {
+            cfg.logging.checkpoint_path = cli_config.checkpoint_file;
+        }
+        if (cli_config.checkpoint_interval > 0) {
+            cfg.logging.checkpoint_interval = cli_config.checkpoint_interval;
+        }
+        if (cli_config.track_operators) {
+            cfg.logging.track_operator_performance = true;
+        }
+
         // Get GA configuration
         auto ga_config = cfg.to_ga_config();
 
@@ -409,16 +603,36 @@ int main(int argc, char** argv) {
             std::cout << "Population: " << ga_config.population_size << "\n";
             std::cout << "Generations: " << ga_config.max_generations << "\n";
             std::cout << "Algorithm: " << cli_config.algorithm << "\n";
+            if (cli_config.islands > 1) {
+                std::cout << "Islands: " << cli_config.islands
+                          << (cli_config.async_migration ? " (asynchronous" : " (synchronous")
+                          << " migration every " << cli_config.migration_interval
+                          << " generations)\n";
+            }
             std::cout << "Seed: " << ga_config.seed << "\n\n";
             std::cout << "Starting evolution...\n";
         }
         auto start_time = std::chrono::high_resolution_clock::now();
 
+        // Run a GA directly or as an island model
+        auto evolve = [&](auto ga) {
+            if (cli_config.islands > 1) {
+                auto model = core::make_island_model(
+                    std::move(ga), {.islands = cli_config.islands,
+                                    .migration_interval = cli_config.migration_interval,
+                                    .mode = cli_config.async_migration
+                                                ? core::MigrationMode::Asynchronous
+                                                : core::MigrationMode::Synchronous});
+                return model.run(tsp, ga_config);
+            }
+            return ga.run(tsp, ga_config);
+        };
+
         // Run GA based on algorithm selection
         auto result = [&]() {
             if (cli_config.algorithm == "advanced") {
                 auto ga = factory::make_tsp_ga_advanced();
-                return ga.run(tsp, ga_config);
+                return evolve(std::move(ga));
             } else if (cli_config.algorithm == "config") {
                 // Explicit validation: config algorithm requires configuration file
                 if (cli_config.config_file.empty()) {
@@ -438,32 +652,32 @@ int main(int argc, char** argv) {
                     // Local search enabled - select appropriate crossover with local search
                     if (crossover_type == "EAX") {
                         auto ga = factory::make_tsp_ga_eax_with_local_search_from_config(cfg);
-                        return ga.run(tsp, ga_config);
+                        return evolve(std::move(ga));
                     } else if (crossover_type == "OX") {
                         auto ga = factory::make_tsp_ga_ox_with_local_search_from_config(cfg);
-                        return ga.run(tsp, ga_config);
+                        return evolve(std::move(ga));
                     } else {
                         // Default to PMX
                         auto ga = factory::make_tsp_ga_with_local_search_from_config(cfg);
-                        return ga.run(tsp, ga_config);
+                        return evolve(std::move(ga));
                     }
                 } else {
                     // No local search - select appropriate crossover
                     if (crossover_type == "EAX") {
                         auto ga = factory::make_tsp_ga_eax_from_config(cfg);
-                        return ga.run(tsp, ga_config);
+                        return evolve(std::move(ga));
                     } else if (crossover_type == "OX") {
                         auto ga = factory::make_tsp_ga_ox_from_config(cfg);
-                        return ga.run(tsp, ga_config);
+                        return evolve(std::move(ga));
                     } else {
                         // Default to PMX
                         auto ga = factory::make_tsp_ga_from_config(cfg);
-                        return ga.run(tsp, ga_config);
+                        return evolve(std::move(ga));
                     }
                 }
             } else {
                 auto ga = factory::make_tsp_ga_basic();
-                return ga.run(tsp, ga_config);
+                return evolve(std::move(ga));
             }
         }();
 
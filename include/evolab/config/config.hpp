@@ -22,11 +22,14 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <toml.hpp>
@@ -85,7 +88,13 @@ struct OperatorsConfig {
 };
 
 /// Local search configuration for memetic algorithms
+///
+/// type selects the engine: "2-opt" (full neighborhood, bounded by max_iterations), "or-opt"
+/// (2-opt + Or-opt over candidate lists) or "LK" (Lin-Kernighan style chains over candidate
+/// lists). The candidate-based engines use candidate_list_size neighbors per city.
 struct LocalSearchConfig {
+    static constexpr std::array<std::string_view, 3> TYPES = {"2-opt", "or-opt", "LK"};
+
     bool enabled = false;                 // Disabled by default for basic GA
     std::string type = "2-opt";           // 2-opt as standard local search
     std::size_t max_iterations = 100;     // Iteration limit to control runtime
@@ -117,7 +126,10 @@ struct LoggingConfig {
     bool verbose = false;                    // Detailed output disabled by default
     bool save_evolution_curve = false;       // CSV output disabled by default
     bool track_operator_performance = false; // Track operator execution times and efficiency
-    bool save_population_snapshots = false;  // Save population state at intervals
+    bool save_population_snapshots = false;  // Keep every checkpoint, not just the latest
+    std::string checkpoint_path;             // Resume from/write checkpoints; empty disables
+    std::size_t checkpoint_interval = 100;   // Checkpoint every N generations (0 = off)
+    double checkpoint_period_minutes = 0.0;  // Also checkpoint every N minutes (0 = off)
 };
 
 /// Parallel execution configuration
@@ -129,10 +141,13 @@ struct ParallelConfig {
 
 /// Population diversity maintenance configuration
 struct DiversityConfig {
+    static constexpr std::array<std::string_view, 2> MEASURES = {"hamming", "edge_entropy"};
+
     bool enabled = false;                  // Diversity tracking disabled by default
     double minimum_diversity = 0.1;        // Minimum required population diversity
     double restart_threshold = 0.05;       // Diversity threshold for population restart
     std::size_t measurement_interval = 10; // Measure diversity every N generations
+    std::string measure = "hamming";       // "hamming" or "edge_entropy" (tours only)
 };
 
 /// Command-line override structure
@@ -322,6 +337,22 @@ inline void Config::validate() const {
         throw ConfigValidationError("Local search iterations must be positive when enabled");
     }
 
+    if (std::ranges::find(LocalSearchConfig::TYPES, local_search.type) ==
+        LocalSearchConfig::TYPES.end()) {
+        throw ConfigValidationError("Unknown local search type: " + local_search.type);
+    }
+
+    if (local_search.enabled && local_search.type != "2-opt" &&
+        local_search.candidate_list_size == 0) {
+        throw ConfigValidationError("Candidate list size must be positive for " +
+                                    local_search.type);
+    }
+
+    if (std::ranges::find(DiversityConfig::MEASURES, diversity.measure) ==
+        DiversityConfig::MEASURES.end()) {
+        throw ConfigValidationError("Unknown diversity measure: " + diversity.measure);
+    }
+
     // Validate scheduler configuration
     if (scheduler.enabled && scheduler.operators.empty()) {
         throw ConfigValidationError("Scheduler requires at least one operator");
@@ -336,6 +367,10 @@ inline void Config::validate() const {
         throw ConfigValidationError("Time limit cannot be negative");
     }
 
+    if (logging.checkpoint_period_minutes < 0.0) {
+        throw ConfigValidationError("Checkpoint period cannot be negative");
+    }
+
     // Validate parallel configuration
     // threads = 0 is valid (auto-detect), but negative is not
     if (parallel.chunk_size == 0) {
@@ -534,6 +569,18 @@ inline LoggingConfig Config::parse_logging(const toml::value& data) {
         log.save_population_snapshots = toml::find<bool>(log_table, "save_population_snapshots");
     }
 
+    if (log_table.contains("checkpoint_path")) {
+        log.checkpoint_path = toml::find<std::string>(log_table, "checkpoint_path");
+    }
+
+    if (log_table.contains("checkpoint_interval")) {
+        log.checkpoint_interval = toml::find<std::size_t>(log_table, "checkpoint_interval");
+    }
+
+    if (log_table.contains("checkpoint_period_minutes")) {
+        log.checkpoint_period_minutes = toml::find<double>(log_table, "checkpoint_period_minutes");
+    }
+
     return log;
 }
 
@@ -576,6 +623,10 @@ inline DiversityConfig Config::parse_diversity(const toml::value& data) {
         div.measurement_interval = toml::find<std::size_t>(div_table, "measurement_interval");
     }
 
+    if (div_table.contains("measure")) {
+        div.measure = toml::find<std::string>(div_table, "measure");
+    }
+
     return div;
 }
 
@@ -651,6 +702,9 @@ inline std::string Config::to_toml() const {
     log_table["save_evolution_curve"] = logging.save_evolution_curve;
     log_table["track_operator_performance"] = logging.track_operator_performance;
     log_table["save_population_snapshots"] = logging.save_population_snapshots;
+    log_table["checkpoint_path"] = logging.checkpoint_path;
+    log_table["checkpoint_interval"] = logging.checkpoint_interval;
+    log_table["checkpoint_period_minutes"] = logging.checkpoint_period_minutes;
     root["logging"] = log_table;
 
     // Parallel section
@@ -666,6 +720,7 @@ inline std::string Config::to_toml() const {
     div_table["minimum_diversity"] = diversity.minimum_diversity;
     div_table["restart_threshold"] = diversity.restart_threshold;
     div_table["measurement_interval"] = diversity.measurement_interval;
+    div_table["measure"] = diversity.measure;
     root["diversity"] = div_table;
 
     std::stringstream ss;
@@ -751,15 +806,28 @@ inline core::GAConfig Config::to_ga_config() const {
     ga_config.enable_diversity_tracking = diversity.enabled;
     ga_config.track_operator_performance = logging.track_operator_performance;
     ga_config.save_population_snapshots = logging.save_population_snapshots;
+    ga_config.enable_checkpoints = !logging.checkpoint_path.empty();
+    ga_config.checkpoint_path = logging.checkpoint_path;
+    ga_config.checkpoint_interval = logging.checkpoint_interval;
+    ga_config.checkpoint_period = std::chrono::milliseconds(
+        static_cast<long long>(logging.checkpoint_period_minutes * 60 * 1000));
 
     // Diversity parameters from configuration
     if (diversity.enabled) {
         ga_config.diversity_threshold = diversity.restart_threshold;
         ga_config.diversity_max_samples = diversity.measurement_interval;
+        ga_config.diversity_measure = diversity.measure == "edge_entropy"
+                                          ? core::DiversityMeasure::EdgeEntropy
+                                          : core::DiversityMeasure::Hamming;
     }
 
     // Diversity tracking is now controlled only by diversity.enabled
 
+    // Parallel offspring generation
+    ga_config.parallel_generation = parallel.enabled;
+    ga_config.num_threads = parallel.threads;
+    ga_config.parallel_chunk_size = parallel.chunk_size;
+
     return ga_config;
 }
 
@@ -0,0 +1,361 @@
+#pragma once
+
+/// @file checkpoint.hpp
+/// @brief Binary checkpoints of a GA run and a background writer for them
+///
+/// A checkpoint holds everything GeneticAlgorithm::run() needs to continue a run exactly as if
+/// it had not been interrupted: the population, the best individual, the generation, evaluation
+/// and stagnation counters and the generator state. CheckpointWriter writes checkpoints on a
+/// background thread from one of two snapshot buffers, so the generation loop only pays for
+/// copying the population into the other buffer.
+///
+/// Layout (native byte order, checked on load): a 96-byte header followed by the fitness values
+/// (population_size doubles), the genomes (population_size × genome_length genes, row-major),
+/// the best genome (genome_length genes) and the generator state as text.
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace evolab::core {
+
+/// Format version; bumped whenever the layout changes so stale checkpoints are rejected
+inline constexpr std::uint32_t CHECKPOINT_VERSION = 1;
+
+/// Thrown when a checkpoint is truncated, from another version or configuration, or otherwise
+/// malformed
+class CheckpointError : public std::runtime_error {
+  public:
+    explicit CheckpointError(const std::string& message)
+        : std::runtime_error("Checkpoint error: " + message) {}
+};
+
+/// Genomes that can be checkpointed: resizable contiguous arrays of trivially copyable genes
+template <typename G>
+concept CheckpointableGenome =
+    std::ranges::contiguous_range<G> && std::ranges::sized_range<G> &&
+    std::is_trivially_copyable_v<std::ranges::range_value_t<G>> &&
+    requires(G genome, std::size_t n) { genome.resize(n); };
+
+/// State of a GA run between two generations, with genomes flattened
+template <typename Gene>
+struct Checkpoint {
+    std::uint64_t config_hash = 0; // Identifies the run configuration, see GeneticAlgorithm
+    std::uint64_t generation = 0;
+    std::uint64_t evaluations = 0;
+    std::uint64_t stagnation_count = 0;
+    std::size_t genome_length = 0;
+    std::vector<double> fitness; // One per individual
+    std::vector<Gene> genes;     // Individual i at [i * genome_length, (i + 1) * genome_length)
+    std::vector<Gene> best_genome;
+    double best_fitness = 0.0;
+    std::mt19937 rng;
+
+    [[nodiscard]] std::size_t population_size() const noexcept { return fitness.size(); }
+};
+
+namespace detail {
+
+inline constexpr std::array<char, 8> CHECKPOINT_MAGIC{'E', 'V', 'O', 'L', 'A', 'B', 'C', 'P'};
+inline constexpr std::uint32_t CHECKPOINT_BYTE_ORDER_MARK = 0x01020304;
+
+struct CheckpointHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t config_hash;
+    std::uint64_t generation;
+    std::uint64_t evaluations;
+    std::uint64_t stagnation_count;
+    std::uint64_t population_size;
+    std::uint64_t genome_length;
+    std::uint32_t gene_size;
+    std::array<std::uint32_t, 3> reserved;
+    double best_fitness;
+    std::uint64_t rng_bytes;
+};
+static_assert(sizeof(CheckpointHeader) == 96,
+              "Checkpoint header layout must not change silently");
+
+template <typename T>
+void write_array(std::ofstream& file, const std::vector<T>& values) {
+    file.write(reinterpret_cast<const char*>(values.data()),
+               static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <typename T>
+void read_array(std::ifstream& file, std::vector<T>& values, std::size_t count) {
+    values.resize(count);
+    file.read(reinterpret_cast<char*>(values.data()),
+              static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+} // namespace detail
+
+/// Write a checkpoint file
+///
+/// The file is written under a temporary name and renamed into place, so an interrupted write
+/// leaves the previous checkpoint intact.
+/// @throws std::invalid_argument if the genome arrays do not match the population size
+/// @throws std::system_error if the file cannot be written
+template <typename Gene>
+void write_checkpoint(const std::string& path, const Checkpoint<Gene>& checkpoint) {
+    if (checkpoint.genes.size() != checkpoint.population_size() * checkpoint.genome_length ||
+        checkpoint.best_genome.size() != checkpoint.genome_length) {
+        throw std::invalid_argument("Checkpoint genomes must all have genome_length genes");
+    }
+
+    std::ostringstream rng_text;
+    rng_text << checkpoint.rng;
+    const std::string rng_state = rng_text.str();
+
+    detail::CheckpointHeader header{};
+    header.magic = detail::CHECKPOINT_MAGIC;
+    header.version = CHECKPOINT_VERSION;
+    header.byte_order = detail::CHECKPOINT_BYTE_ORDER_MARK;
+    header.config_hash = checkpoint.config_hash;
+    header.generation = checkpoint.generation;
+    header.evaluations = checkpoint.evaluations;
+    header.stagnation_count = checkpoint.stagnation_count;
+    header.population_size = checkpoint.population_size();
+    header.genome_length = checkpoint.genome_length;
+    header.gene_size = sizeof(Gene);
+    header.best_fitness = checkpoint.best_fitness;
+    header.rng_bytes = rng_state.size();
+
+    const std::string temporary =
+        path + ".tmp" + std::to_string(std::random_device{}() & 0xFFFFFFu);
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::system_error(std::make_error_code(std::errc::io_error),
+                                    "Cannot create " + temporary);
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        detail::write_array(file, checkpoint.fitness);
+        detail::write_array(file, checkpoint.genes);
+        detail::write_array(file, checkpoint.best_genome);
+        file.write(rng_state.data(), static_cast<std::streamsize>(rng_state.size()));
+        if (!file.flush()) {
+            file.close();
+            std::filesystem::remove(temporary);
+            throw std::system_error(std::make_error_code(std::errc::io_error),
+                                    "Cannot write " + temporary);
+        }
+    }
+    std::filesystem::rename(temporary, path);
+}
+
+/// Read a checkpoint file
+/// @throws std::system_error if the file cannot be opened
+/// @throws CheckpointError if it is not a valid checkpoint of this version and gene type
+template <typename Gene>
+[[nodiscard]] Checkpoint<Gene> read_checkpoint(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory),
+                                "Cannot open " + path);
+    }
+
+    detail::CheckpointHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw CheckpointError(path + " is truncated");
+    }
+    if (header.magic != detail::CHECKPOINT_MAGIC) {
+        throw CheckpointError(path + " is not a checkpoint");
+    }
+    if (header.version != CHECKPOINT_VERSION) {
+        throw CheckpointError(path + " has version " + std::to_string(header.version) +
+                              ", expected " + std::to_string(CHECKPOINT_VERSION));
+    }
+    if (header.byte_order != detail::CHECKPOINT_BYTE_ORDER_MARK) {
+        throw CheckpointError(path + " was written with a different byte order");
+    }
+    if (header.gene_size != sizeof(Gene)) {
+        throw CheckpointError(path + " holds genes of a different type");
+    }
+
+    // Reject sizes the file cannot hold before allocating for them
+    const auto file_bytes = static_cast<std::uint64_t>(std::filesystem::file_size(path));
+    const std::uint64_t n = header.population_size;
+    const std::uint64_t length = header.genome_length;
+    const std::uint64_t limit = file_bytes / std::max<std::uint64_t>(sizeof(Gene), 1);
+    if (n > file_bytes / sizeof(double) || length > limit || (length > 0 && n > limit / length) ||
+        header.rng_bytes > file_bytes) {
+        throw CheckpointError(path + " is truncated");
+    }
+    const std::uint64_t expected = sizeof(header) + n * sizeof(double) +
+                                   (n + 1) * length * sizeof(Gene) + header.rng_bytes;
+    if (file_bytes != expected) {
+        throw CheckpointError(path + " is truncated");
+    }
+
+    Checkpoint<Gene> checkpoint;
+    checkpoint.config_hash = header.config_hash;
+    checkpoint.generation = header.generation;
+    checkpoint.evaluations = header.evaluations;
+    checkpoint.stagnation_count = header.stagnation_count;
+    checkpoint.genome_length = length;
+    checkpoint.best_fitness = header.best_fitness;
+    detail::read_array(file, checkpoint.fitness, n);
+    detail::read_array(file, checkpoint.genes, n * length);
+    detail::read_array(file, checkpoint.best_genome, length);
+
+    std::string rng_state(header.rng_bytes, '\0');
+    file.read(rng_state.data(), static_cast<std::streamsize>(rng_state.size()));
+    std::istringstream rng_text(rng_state);
+    rng_text >> checkpoint.rng;
+    if (!file || !rng_text) {
+        throw CheckpointError(path + " is truncated");
+    }
+    return checkpoint;
+}
+
+/// Writes checkpoints on a background thread
+///
+/// The producer fills buffer(), then hands it over with publish() and carries on. Of the two
+/// buffers, one may be in the middle of being written; buffer() always returns the other, so
+/// the producer never waits for the disk. A published checkpoint that the writer has not
+/// started yet is replaced by the next one published.
+///
+/// buffer() and publish() must be called from one thread. A write error is rethrown by the
+/// next publish() or wait().
+template <typename Gene>
+class CheckpointWriter {
+  public:
+    /// @param keep_snapshots Also keep each checkpoint as `<path>.<generation>`
+    explicit CheckpointWriter(std::string path, bool keep_snapshots = false)
+        : path_(std::move(path)), keep_snapshots_(keep_snapshots),
+          thread_([this] { write_loop(); }) {}
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    /// Writes the pending checkpoint, if any, before returning
+    ~CheckpointWriter() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        changed_.notify_all();
+    }
+
+    /// Buffer to fill with the next checkpoint; keeps its storage from earlier checkpoints
+    Checkpoint<Gene>& buffer() {
+        std::lock_guard lock(mutex_);
+        if (pending_ >= 0) {
+            filling_ = pending_; // Not started yet: replace it
+            pending_ = -1;
+        } else {
+            filling_ = writing_ == 0 ? 1 : 0;
+        }
+        return buffers_[filling_];
+    }
+
+    /// Queue the buffer last returned by buffer() for writing
+    void publish() {
+        {
+            std::lock_guard lock(mutex_);
+            rethrow_error();
+            pending_ = filling_;
+        }
+        changed_.notify_all();
+    }
+
+    /// Block until every published checkpoint has been written
+    void wait() {
+        std::unique_lock lock(mutex_);
+        changed_.wait(lock, [this] { return pending_ < 0 && writing_ < 0; });
+        rethrow_error();
+    }
+
+    [[nodiscard]] const std::string& path() const noexcept { return path_; }
+
+  private:
+    void write_loop() {
+        std::unique_lock lock(mutex_);
+        for (;;) {
+            changed_.wait(lock, [this] { return pending_ >= 0 || stopping_; });
+            if (pending_ < 0)
+                return;
+            writing_ = pending_;
+            pending_ = -1;
+            lock.unlock();
+
+            try {
+                const auto& checkpoint = buffers_[writing_];
+                write_checkpoint(path_, checkpoint);
+                if (keep_snapshots_) {
+                    std::filesystem::copy_file(
+                        path_, path_ + "." + std::to_string(checkpoint.generation),
+                        std::filesystem::copy_options::overwrite_existing);
+                }
+            } catch (...) {
+                lock.lock();
+                error_ = std::current_exception();
+                lock.unlock();
+            }
+
+            lock.lock();
+            writing_ = -1;
+            changed_.notify_all();
+        }
+    }
+
+    void rethrow_error() {
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+    std::string path_;
+    bool keep_snapshots_;
+    std::array<Checkpoint<Gene>, 2> buffers_;
+    std::mutex mutex_; // Guards the indices, stopping_ and error_
+    std::condition_variable changed_;
+    int filling_ = 0;  // Buffer owned by the producer
+    int pending_ = -1; // Published, not yet picked up by the writer
+    int writing_ = -1; // Being written
+    bool stopping_ = false;
+    std::exception_ptr error_;
+    std::jthread thread_; // Last: starts after, and joins before, the members above
+};
+
+namespace detail {
+
+template <typename GenomeT>
+struct checkpoint_writer_for {
+    using type = std::monostate;
+};
+
+template <CheckpointableGenome GenomeT>
+struct checkpoint_writer_for<GenomeT> {
+    using type = CheckpointWriter<std::ranges::range_value_t<GenomeT>>;
+};
+
+} // namespace detail
+
+/// CheckpointWriter for genomes of type GenomeT, or std::monostate if they cannot be
+/// checkpointed
+template <typename GenomeT>
+using CheckpointWriterFor = typename detail::checkpoint_writer_for<GenomeT>::type;
+
+} // namespace evolab::core
@@ -2,6 +2,7 @@
 
 #include <compare>
 #include <concepts>
+#include <cstddef>
 #include <random>
 #include <span>
 #include <utility>
@@ -48,6 +49,41 @@ concept Problem = requires(const P& problem, const typename P::GenomeT& genome)
     { problem.size() } -> std::convertible_to<std::size_t>;
 };
 
+/// Concept for problems with a batch evaluation path
+///
+/// evaluate_batch(genomes, out) must write out[i] == evaluate(genomes[i]). It lets a problem
+/// amortize per-call setup (storage dispatch, kernel selection) over many genomes.
+template <typename P>
+concept BatchEvaluableProblem =
+    Problem<P> && requires(const P& problem, std::span<const typename P::GenomeT> genomes,
+                           std::span<Fitness> out) {
+        { problem.evaluate_batch(genomes, out) } -> std::same_as<void>;
+    };
+
+/// Concept for problems that evaluate a row-major matrix of fixed-length genomes
+///
+/// evaluate_batch(matrix, out) reads genome i from matrix[i * size(), (i + 1) * size()) and
+/// must write out[i] == evaluate() of that genome (see MatrixPopulation).
+template <typename P>
+concept MatrixEvaluableProblem =
+    Problem<P> && requires(const P& problem, std::span<const typename P::Gene> matrix,
+                           std::span<Fitness> out) {
+        { problem.evaluate_batch(matrix, out) } -> std::same_as<void>;
+    };
+
+/// Evaluate genomes into out, using the problem's batch path when it has one
+template <Problem P>
+void evaluate_all(const P& problem, std::span<const typename P::GenomeT> genomes,
+                  std::span<Fitness> out) {
+    if constexpr (BatchEvaluableProblem<P>) {
+        problem.evaluate_batch(genomes, out);
+    } else {
+        for (std::size_t i = 0; i < genomes.size(); ++i) {
+            out[i] = problem.evaluate(genomes[i]);
+        }
+    }
+}
+
 /// Concept for genetic operators
 template <typename Op, typename P>
 concept GeneticOperator =
@@ -133,6 +169,22 @@ concept CrossoverOperator =
         } -> std::same_as<std::pair<typename P::GenomeT, typename P::GenomeT>>;
     };
 
+/// Concept for crossover operators that can write offspring into existing genomes
+///
+/// cross_into() must produce the same children and consume the same random numbers as
+/// cross(). Children are resized as needed and must not alias the parents; reusing their
+/// storage lets the GA breed a generation without allocating genomes.
+template <typename C, typename P>
+concept InPlaceCrossoverOperator =
+    CrossoverOperator<C, P> &&
+    requires(const C& crossover, const P& problem, const typename P::GenomeT& parent1,
+             const typename P::GenomeT& parent2, typename P::GenomeT& child1,
+             typename P::GenomeT& child2, std::mt19937& rng) {
+        {
+            crossover.cross_into(problem, parent1, parent2, child1, child2, rng)
+        } -> std::same_as<void>;
+    };
+
 /// Concept for mutation operators
 template <typename M, typename P>
 concept MutationOperator = Problem<P> && requires(const M& mutator, const P& problem,
@@ -141,6 +193,34 @@ concept MutationOperator = Problem<P> && requires(const M& mutator, const P& pro
     { mutator.mutate(problem, genome, rng) } -> std::same_as<void>;
 };
 
+/// Concept for problems that score elementary permutation moves without a full evaluation
+///
+/// Each hook returns fitness(after) - fitness(before) for a move on genome, which is left
+/// unmodified:
+/// - swap_delta(g, i, j): exchange g[i] and g[j]
+/// - reversal_delta(g, first, last): reverse g[first..last] (first <= last)
+/// - segment_move_delta(g, first, last, pos): remove g[first..last] and reinsert it before
+///   index pos of the remaining sequence
+template <typename P>
+concept PermutationDeltaProblem =
+    Problem<P> && requires(const P& problem, const typename P::GenomeT& genome, std::size_t i,
+                           std::size_t j, std::size_t k) {
+        { problem.swap_delta(genome, i, j) } -> std::convertible_to<double>;
+        { problem.reversal_delta(genome, i, j) } -> std::convertible_to<double>;
+        { problem.segment_move_delta(genome, i, j, k) } -> std::convertible_to<double>;
+    };
+
+/// Concept for mutation operators that report the fitness change of the move they apply
+///
+/// mutate_with_delta() must produce the same genome and consume the same random numbers as
+/// mutate(), so a child of a parent with known fitness can be scored as parent + delta.
+template <typename M, typename P>
+concept DeltaMutationOperator =
+    MutationOperator<M, P> && requires(const M& mutator, const P& problem,
+                                       typename P::GenomeT& genome, std::mt19937& rng) {
+        { mutator.mutate_with_delta(problem, genome, rng) } -> std::convertible_to<double>;
+    };
+
 /// Concept for local search operators
 template <typename L, typename P>
 concept LocalSearchOperator =
@@ -0,0 +1,267 @@
+#pragma once
+
+/// @file edge_frequency.hpp
+/// @brief Population edge frequencies and edge entropy, maintained incrementally
+///
+/// Comparing tours position by position says little about how different they are: a rotated
+/// or reversed copy of a tour matches it in no position, yet it is the same solution. What
+/// tours have in common are edges. EdgeFrequencyTable counts how many individuals of a
+/// population contain each edge and keeps the population's edge entropy up to date as
+/// individuals are replaced, updating only the counts of edges that change.
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+namespace evolab::core {
+
+/// Genomes that can be read as tours: contiguous sequences of city indices
+template <typename GenomeT>
+concept TourGenome = std::ranges::contiguous_range<GenomeT> &&
+                     std::ranges::sized_range<GenomeT> &&
+                     std::integral<std::ranges::range_value_t<GenomeT>>;
+
+/// Number of individuals containing each undirected edge, over a fixed number of slots
+///
+/// Each slot stands for one individual (initially none). The table keeps no copy of the
+/// tours: insert(slot, tour) counts the edges of a slot's first tour, and replace(slot,
+/// previous, tour) is called by whoever overwrites the individual, while the tour it held is
+/// still at hand. The adjacency of the two tours is compared in linear passes over contiguous
+/// arrays, and only the counts of edges that one has and the other lacks change. A tour
+/// replaced by itself, or by a rotation or reversal of itself, changes no count.
+///
+/// For P occupied slots and F(e) individuals containing edge e, the edge entropy is
+/// H = -sum_e F(e)/P log(F(e)/P). It is 0 when all tours are equal and n log P when no two
+/// share an edge. The table keeps S = sum_e F(e) log F(e) and computes H = n log P - S/P, so
+/// a count change costs O(1). Counts live in an open-addressing hash table sized to the
+/// edges in use, so a diverse population costs no more per change than a converged one.
+class EdgeFrequencyTable {
+  public:
+    EdgeFrequencyTable() = default;
+
+    /// @throws std::invalid_argument if cities < 3
+    EdgeFrequencyTable(std::size_t slots, std::size_t cities) { reset(slots, cities); }
+
+    /// Empty all slots and set the table's shape
+    /// @throws std::invalid_argument if cities < 3
+    void reset(std::size_t slots, std::size_t cities) {
+        if (cities < 3) {
+            throw std::invalid_argument("EdgeFrequencyTable: tours need at least 3 cities");
+        }
+        slots_ = slots;
+        cities_ = cities;
+        occupied_ = 0;
+        filled_.assign(slots, 0);
+        counts_.assign(std::bit_ceil(4 * cities), Entry{});
+        edges_in_use_ = 0;
+        new_adjacency_.resize(2 * cities);
+        old_adjacency_.resize(2 * cities);
+        sum_f_log_f_ = 0.0;
+        f_log_f_.resize(slots + 1);
+        for (std::size_t f = 0; f <= slots; ++f) {
+            f_log_f_[f] = f > 0 ? static_cast<double>(f) * std::log(static_cast<double>(f)) : 0.0;
+        }
+    }
+
+    [[nodiscard]] std::size_t slots() const noexcept { return slots_; }
+    [[nodiscard]] std::size_t cities() const noexcept { return cities_; }
+
+    /// Slots that hold a tour
+    [[nodiscard]] std::size_t occupied() const noexcept { return occupied_; }
+
+    /// Count the edges of `tour`, a permutation of 0..cities()-1, as the individual of the
+    /// empty slot `slot`
+    /// @throws std::invalid_argument if the tour's length is not cities()
+    template <TourGenome Tour>
+    void insert(std::size_t slot, const Tour& tour) {
+        check_length(tour);
+        assert(slot < slots_ && !filled_[slot]);
+        filled_[slot] = 1;
+        ++occupied_;
+        std::ranges::fill(old_adjacency_, -1); // No edges to remove
+        adjacency(std::ranges::data(tour), new_adjacency_);
+        apply_changes();
+    }
+
+    /// Replace `previous`, the tour last inserted into or replaced in `slot`, by `tour`
+    /// @throws std::invalid_argument if a tour's length is not cities()
+    template <TourGenome Previous, TourGenome Tour>
+    void replace(std::size_t slot, const Previous& previous, const Tour& tour) {
+        check_length(previous);
+        check_length(tour);
+        assert(slot < slots_ && filled_[slot]);
+        if (std::ranges::equal(previous, tour))
+            return;
+        adjacency(std::ranges::data(previous), old_adjacency_);
+        adjacency(std::ranges::data(tour), new_adjacency_);
+        apply_changes();
+    }
+
+    /// Number of tours containing the edge {a, b}
+    [[nodiscard]] std::uint32_t frequency(int a, int b) const noexcept {
+        if (counts_.empty())
+            return 0;
+        return counts_[find(edge_key(std::min(a, b), std::max(a, b)))].count;
+    }
+
+    /// Edge entropy H of the occupied slots
+    [[nodiscard]] double entropy() const noexcept {
+        if (occupied_ < 2)
+            return 0.0;
+        const double p = static_cast<double>(occupied_);
+        return std::max(0.0, static_cast<double>(cities_) * std::log(p) - sum_f_log_f_ / p);
+    }
+
+    /// Edge entropy scaled to [0, 1]: 0 when all tours are equal, 1 when no two share an edge
+    [[nodiscard]] double diversity() const noexcept {
+        if (occupied_ < 2)
+            return 0.0;
+        const double maximum =
+            static_cast<double>(cities_) * std::log(static_cast<double>(occupied_));
+        return std::min(1.0, entropy() / maximum);
+    }
+
+  private:
+    struct Entry {
+        std::uint64_t key = EMPTY_KEY;
+        std::uint32_t count = 0;
+    };
+
+    static constexpr std::uint64_t EMPTY_KEY = std::numeric_limits<std::uint64_t>::max();
+
+    std::size_t slots_ = 0;
+    std::size_t cities_ = 0;
+    std::size_t occupied_ = 0;
+    std::vector<unsigned char> filled_; // Whether a slot holds a tour
+    std::vector<Entry> counts_;         // Linear probing, at most half full
+    std::size_t edges_in_use_ = 0;
+    std::vector<int> new_adjacency_; // Scratch: neighbors of city c at 2c and 2c + 1
+    std::vector<int> old_adjacency_;
+    std::vector<double> f_log_f_; // f log f for f in [0, slots_]
+    double sum_f_log_f_ = 0.0;
+
+    template <TourGenome Tour>
+    void check_length(const Tour& tour) const {
+        if (std::ranges::size(tour) != cities_) {
+            throw std::invalid_argument("EdgeFrequencyTable: tour length differs from the table's");
+        }
+    }
+
+    /// Neighbors of every city of `tour`, the smaller one first so that orientation and
+    /// starting point do not matter
+    template <typename City>
+    void adjacency(const City* tour, std::vector<int>& out) const noexcept {
+        const std::size_t n = cities_;
+        for (std::size_t i = 0; i < n; ++i) {
+            const int prev = static_cast<int>(tour[i == 0 ? n - 1 : i - 1]);
+            const int next = static_cast<int>(tour[i + 1 == n ? 0 : i + 1]);
+            int* pair = out.data() + 2 * static_cast<std::size_t>(tour[i]);
+            pair[0] = std::min(prev, next);
+            pair[1] = std::max(prev, next);
+        }
+    }
+
+    /// Move the counts from the edges of old_adjacency_ to those of new_adjacency_
+    void apply_changes() {
+        // Each edge is handled at its smaller endpoint
+        const int* old_pairs = old_adjacency_.data();
+        const int* new_pairs = new_adjacency_.data();
+        for (std::size_t c = 0; c < cities_; ++c) {
+            const int o0 = old_pairs[2 * c];
+            const int o1 = old_pairs[2 * c + 1];
+            const int n0 = new_pairs[2 * c];
+            const int n1 = new_pairs[2 * c + 1];
+            if (o0 == n0 && o1 == n1)
+                continue;
+            const int city = static_cast<int>(c);
+            for (const int o : {o0, o1}) {
+                if (o > city && o != n0 && o != n1)
+                    remove(city, o);
+            }
+            for (const int n : {n0, n1}) {
+                if (n > city && n != o0 && n != o1)
+                    add(city, n);
+            }
+        }
+    }
+
+    /// Edge {a, b} with a < b
+    static constexpr std::uint64_t edge_key(int a, int b) noexcept {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(a)) << 32) |
+               static_cast<std::uint32_t>(b);
+    }
+
+    std::size_t home(std::uint64_t key) const noexcept {
+        // Fibonacci hashing spreads the consecutive keys of neighboring cities
+        const auto mask = counts_.size() - 1;
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+    }
+
+    /// Index of the entry holding `key`, or of the empty entry where it would go
+    std::size_t find(std::uint64_t key) const noexcept {
+        const auto mask = counts_.size() - 1;
+        std::size_t i = home(key);
+        while (counts_[i].key != key && counts_[i].key != EMPTY_KEY) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void add(int a, int b) {
+        const std::uint64_t key = edge_key(a, b);
+        std::size_t i = find(key);
+        if (counts_[i].key == EMPTY_KEY) {
+            if (2 * (edges_in_use_ + 1) > counts_.size()) {
+                grow();
+                i = find(key);
+            }
+            counts_[i].key = key;
+            ++edges_in_use_;
+        }
+        auto& count = counts_[i].count;
+        sum_f_log_f_ += f_log_f_[count + 1] - f_log_f_[count];
+        ++count;
+    }
+
+    void remove(int a, int b) {
+        std::size_t i = find(edge_key(a, b));
+        auto& count = counts_[i].count;
+        assert(counts_[i].key != EMPTY_KEY && count > 0);
+        sum_f_log_f_ += f_log_f_[count - 1] - f_log_f_[count];
+        if (--count > 0)
+            return;
+
+        // Backward-shift deletion: move later entries of the probe run into the gap so that
+        // lookups never need tombstones
+        const auto mask = counts_.size() - 1;
+        --edges_in_use_;
+        for (std::size_t j = (i + 1) & mask; counts_[j].key != EMPTY_KEY; j = (j + 1) & mask) {
+            const std::size_t h = home(counts_[j].key);
+            // Entry j may fill the gap at i unless its home lies cyclically in (i, j]
+            if (((j - h) & mask) >= ((j - i) & mask)) {
+                counts_[i] = counts_[j];
+                i = j;
+            }
+        }
+        counts_[i] = Entry{};
+    }
+
+    void grow() {
+        std::vector<Entry> old(2 * counts_.size());
+        old.swap(counts_);
+        for (const auto& entry : old) {
+            if (entry.key != EMPTY_KEY)
+                counts_[find(entry.key)] = entry;
+        }
+    }
+};
+
+} // namespace evolab::core
@@ -7,26 +7,48 @@
 /// Uses concept-based design for type safety and clear compile-time requirements.
 
 #include <algorithm>
+#include <bit>
 #include <cassert>
 #include <chrono>
 #include <concepts>
 #include <cstdint>
+#include <filesystem>
 #include <limits>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
 #include <optional>
 #include <random>
+#include <ranges>
 #include <span>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <variant>
 #include <vector>
 
 // EvoLab core concepts - fundamental type requirements for genetic algorithms
+#include <evolab/core/checkpoint.hpp>
 #include <evolab/core/concepts.hpp>
+#include <evolab/core/edge_frequency.hpp>
+#include <evolab/core/operator_timing.hpp>
 #include <evolab/core/population.hpp>
+#include <evolab/core/rng.hpp>
+
+#ifdef EVOLAB_HAVE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
 
 namespace evolab::core {
 
+/// How GenerationStats::diversity is measured
+enum class DiversityMeasure {
+    Hamming,    ///< Mean positional distance over up to diversity_max_samples sampled pairs
+    EdgeEntropy ///< Normalized edge entropy of the whole population (TourGenome only)
+};
+
 /// Configuration for genetic algorithm
 struct GAConfig {
     std::size_t population_size = 256;
@@ -45,36 +67,44 @@ struct GAConfig {
     std::size_t stagnation_limit = 100;
     bool enable_diversity_tracking = true;
     std::size_t diversity_max_samples = 50;
+    // EdgeEntropy keeps an edge-frequency table in step with the population, updating the
+    // edges of each individual as it is replaced, so measuring it is O(1). Unlike Hamming, it
+    // draws no random numbers, and rotated or reversed copies of a tour count as equal.
+    DiversityMeasure diversity_measure = DiversityMeasure::Hamming;
 
     // Logging and checkpoint
+    // With checkpoints enabled, run() resumes from checkpoint_path if it exists and writes a
+    // checkpoint there every checkpoint_interval generations, every checkpoint_period, and
+    // when it ends (see GeneticAlgorithm::run)
     std::size_t log_interval = 10;
     bool enable_checkpoints = false;
     std::string checkpoint_path = "";
+    std::size_t checkpoint_interval = 100;          // 0 = no generation-based checkpoints
+    std::chrono::milliseconds checkpoint_period{0}; // 0 = no time-based checkpoints
 
     // Performance tracking
     bool track_operator_performance = false;
-    bool save_population_snapshots = false;
+    bool save_population_snapshots = false; // Keep every checkpoint as <path>.<generation>
 
-    // Memory allocation
-    std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource();
-};
+    // Parallel offspring generation (see GeneticAlgorithm::run)
+    // Each offspring pair draws from its own counter-derived RNG stream, so results depend
+    // only on the seed and are identical for any num_threads, with or without TBB.
+    bool parallel_generation = false;
+    std::size_t num_threads = 0;          // 0 = all available hardware threads
+    std::size_t parallel_chunk_size = 64; // Upper bound on offspring pairs per scheduling chunk
 
-/// Operator performance statistics
-struct OperatorStats {
-    std::size_t executions = 0;             // Number of times executed
-    std::chrono::nanoseconds total_time{0}; // Total execution time
-    std::size_t successes = 0;              // Number of successful operations
-    double average_improvement = 0.0;       // Average fitness improvement
-
-    // Calculate averages
-    double average_time_ms() const {
-        return executions > 0 ? static_cast<double>(total_time.count()) / (executions * 1000000.0)
-                              : 0.0;
-    }
+    // Score a mutated copy of a parent as parent fitness + move delta instead of re-evaluating
+    // it, when the mutation supports it (DeltaMutationOperator) and no repair operator is set.
+    // Exact for integral distance back-ends; floating ones may differ in the last bits.
+    bool delta_evaluation = true;
 
-    double success_rate() const {
-        return executions > 0 ? static_cast<double>(successes) / executions : 0.0;
-    }
+    // Memory allocation
+    // Serves the run's population arrays (genome slots and fitness values of both
+    // populations) and the elite index buffer. The genomes' own element buffers come from
+    // GenomeT's allocator instead, the global heap for std::vector genomes: they are
+    // allocated once per run when the crossover writes in place (InPlaceCrossoverOperator, as
+    // all crossovers of this library do), and once per child otherwise.
+    std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource();
 };
 
 /// Statistics for a single generation
@@ -86,22 +116,166 @@ struct GenerationStats {
     double diversity;
     std::chrono::milliseconds elapsed_time;
 
-    // Operator performance (only populated if tracking enabled)
-    OperatorStats crossover_stats;
-    OperatorStats mutation_stats;
-    OperatorStats selection_stats;
+    // Time spent in each phase of this generation (only populated if tracking enabled)
+    OperatorTimings operator_stats;
 };
 
 /// Result of genetic algorithm run
 template <typename GenomeT>
 struct GAResult {
-    GenomeT best_genome;
+    GenomeT best_genome; // In source ids for problems that renumber internally (to_original)
     Fitness best_fitness;
     std::size_t generations;
     std::size_t evaluations;
     std::chrono::milliseconds total_time;
     std::vector<GenerationStats> history;
     bool converged = false;
+    OperatorTimings operator_stats; // Over the whole run (only populated if tracking enabled)
+};
+
+namespace detail {
+
+/// Index-parallel loop used for population initialization and offspring generation
+///
+/// Runs inside a dedicated TBB task arena so that GAConfig::num_threads bounds concurrency
+/// without reconfiguring the global scheduler. Without TBB the loop runs serially; because
+/// callers derive per-index RNG streams, both paths produce identical results.
+class OffspringExecutor {
+    std::size_t max_chunk_;
+#ifdef EVOLAB_HAVE_TBB
+    tbb::task_arena arena_;
+#endif
+
+  public:
+    OffspringExecutor([[maybe_unused]] std::size_t num_threads, std::size_t max_chunk)
+        : max_chunk_(max_chunk > 0 ? max_chunk : 1)
+#ifdef EVOLAB_HAVE_TBB
+          ,
+          arena_(num_threads == 0 ? tbb::task_arena::automatic : static_cast<int>(num_threads))
+#endif
+    {
+    }
+
+    /// Number of threads that may run bodies of one for_each
+    std::size_t concurrency() const {
+#ifdef EVOLAB_HAVE_TBB
+        return static_cast<std::size_t>(arena_.max_concurrency());
+#else
+        return 1;
+#endif
+    }
+
+    /// Index of the calling thread among those running a for_each, below concurrency()
+    static std::size_t thread_index() noexcept {
+#ifdef EVOLAB_HAVE_TBB
+        const int index = tbb::this_task_arena::current_thread_index();
+        return index > 0 ? static_cast<std::size_t>(index) : 0;
+#else
+        return 0;
+#endif
+    }
+
+    /// Invoke body(i) for every i in [0, count); body must only write index-local state
+    template <typename Body>
+    void for_each(std::size_t count, Body&& body) {
+        if (count == 0)
+            return;
+#ifdef EVOLAB_HAVE_TBB
+        arena_.execute([&] {
+            // Keep at least ~4 chunks per worker for load balancing: offspring cost varies
+            // widely once local search is involved, so large fixed chunks would idle threads
+            const auto workers = static_cast<std::size_t>(arena_.max_concurrency());
+            const std::size_t balanced = std::max<std::size_t>(1, count / (4 * workers));
+            const std::size_t grain = std::min(max_chunk_, balanced);
+
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, count, grain),
+                              [&body](const tbb::blocked_range<std::size_t>& range) {
+                                  for (std::size_t i = range.begin(); i != range.end(); ++i) {
+                                      body(i);
+                                  }
+                              });
+        });
+#else
+        for (std::size_t i = 0; i < count; ++i) {
+            body(i);
+        }
+#endif
+    }
+};
+
+/// Map a genome to the problem's source numbering if it renumbers internally (e.g. TSP
+/// with a CityOrdering), so results can be reported and written without further mapping
+template <Problem P>
+typename P::GenomeT to_original_if_available(const P& problem, typename P::GenomeT genome) {
+    if constexpr (requires {
+                      { problem.to_original(genome) } -> std::same_as<typename P::GenomeT>;
+                  }) {
+        return problem.to_original(genome);
+    } else {
+        return genome;
+    }
+}
+
+} // namespace detail
+
+/// State of a run between two generations
+///
+/// GeneticAlgorithm::run() steps it from initialize() to termination. Drivers that interleave
+/// several runs (see IslandModel) call GeneticAlgorithm::evolve() themselves and may exchange
+/// individuals of `population` between generations, keeping best_genome and best_fitness in
+/// step and reporting each replacement through track_replacement().
+template <typename GenomeT>
+struct EvolutionState {
+    /// @throws std::invalid_argument if config asks for edge entropy of non-tour genomes
+    explicit EvolutionState(const GAConfig& config)
+        : population(config.population_size, config.memory_resource),
+          next(config.population_size, config.memory_resource),
+          elite_indices(config.memory_resource),
+          executor(std::make_unique<detail::OffspringExecutor>(config.num_threads,
+                                                               config.parallel_chunk_size)),
+          timer(config.parallel_generation ? executor->concurrency() : 1,
+                config.track_operator_performance),
+          tracks_edges(config.enable_diversity_tracking &&
+                       config.diversity_measure == DiversityMeasure::EdgeEntropy) {
+        if constexpr (!TourGenome<GenomeT>) {
+            if (tracks_edges) {
+                throw std::invalid_argument("Edge entropy diversity requires tour genomes");
+            }
+        }
+    }
+
+    /// Account for slot i of `population` changing from `previous` to `current`
+    ///
+    /// Keeps edge_frequencies in step when edge entropy is tracked, and does nothing
+    /// otherwise. Call it while the overwritten genome is still at hand.
+    void track_replacement(std::size_t i, const GenomeT& previous, const GenomeT& current) {
+        if constexpr (TourGenome<GenomeT>) {
+            if (tracks_edges && edge_frequencies.slots() > 0) {
+                edge_frequencies.replace(i, previous, current);
+            }
+        }
+    }
+
+    Population<GenomeT> population;
+    Population<GenomeT> next;                    // Breeding buffer, swapped in each generation
+    GenomeT spare_child;                         // Second child that has no slot left
+    std::pmr::vector<std::size_t> elite_indices; // Elite selection scratch
+    GenomeT best_genome;                         // Best individual so far, in problem ids
+    Fitness best_fitness;
+    std::size_t generation = 0;       // Generations evolved
+    std::size_t evaluations = 0;      // Including the initial population
+    std::size_t stagnation_count = 0; // Generations since best_fitness last improved
+
+    // Worker pool for parallel generation mode (idle unless GAConfig::parallel_generation)
+    std::unique_ptr<detail::OffspringExecutor> executor;
+
+    // Phase timings (collecting only with GAConfig::track_operator_performance)
+    detail::OperatorTimer<> timer;
+
+    // Edges of `population`, updated wherever an individual is replaced, when
+    // GAConfig::diversity_measure is EdgeEntropy (empty for tours of fewer than 3 cities)
+    bool tracks_edges;
+    std::conditional_t<TourGenome<GenomeT>, EdgeFrequencyTable, std::monostate> edge_frequencies;
 };
 
 /// Main genetic algorithm implementation
@@ -125,6 +299,8 @@ class GeneticAlgorithm {
 
     mutable std::mt19937 rng_;
 
+    using OperatorTimer = detail::OperatorTimer<>;
+
   public:
     GeneticAlgorithm(Selection sel, Crossover cross, Mutation mut)
         : selection_(std::move(sel)), crossover_(std::move(cross)), mutation_(std::move(mut)) {}
@@ -137,17 +313,27 @@ class GeneticAlgorithm {
         : selection_(std::move(sel)), crossover_(std::move(cross)), mutation_(std::move(mut)),
           local_search_(std::move(ls)), repair_(std::move(rep)) {}
 
+    /// Whether the operators of this GA apply to problem type P
+    template <typename P>
+    static constexpr bool supports =
+        SelectionOperator<Selection, P> && CrossoverOperator<Crossover, P> &&
+        MutationOperator<Mutation, P> &&
+        (std::same_as<LocalSearch, void*> || LocalSearchOperator<LocalSearch, P>) &&
+        (std::same_as<Repair, void*> || RepairOperator<Repair, P>);
+
     /// Run genetic algorithm on the given problem
+    ///
+    /// With GAConfig::enable_checkpoints, a checkpoint at checkpoint_path is resumed from, and
+    /// the run continues exactly as the run that wrote it would have; the history then starts
+    /// at the resumed generation. Checkpoints are written on a background thread.
+    /// @throws CheckpointError if the checkpoint belongs to another configuration or problem size
+    /// @throws std::invalid_argument if checkpoints are enabled for genomes that do not satisfy
+    ///         CheckpointableGenome
     template <Problem P>
-        requires SelectionOperator<Selection, P> && CrossoverOperator<Crossover, P> &&
-                 MutationOperator<Mutation, P> &&
-                 (std::same_as<LocalSearch, void*> || LocalSearchOperator<LocalSearch, P>) &&
-                 (std::same_as<Repair, void*> || RepairOperator<Repair, P>)
+        requires supports<P>
     GAResult<typename P::GenomeT> run(const P& problem, const GAConfig& config = {}) {
         using GenomeT = typename P::GenomeT;
 
-        rng_.seed(config.seed);
-
         const auto start_time = std::chrono::steady_clock::now();
 
         // Handle population_size == 0 to prevent undefined behavior with empty ranges.
@@ -163,32 +349,30 @@ class GeneticAlgorithm {
             return result;
         }
 
-        // Initialize population with Structure-of-Arrays layout for better memory efficiency
-        Population<GenomeT> population(config.population_size, config.memory_resource);
-
-        for (std::size_t i = 0; i < config.population_size; ++i) {
-            auto genome = problem.random_genome(rng_);
-            repair_if_available(problem, genome);
-
-            auto fitness = problem.evaluate(genome);
-            population.push_back(std::move(genome), fitness);
-        }
-
-        // Track best solution
-        auto fitness_span = population.fitness_values();
-        auto best_idx =
-            std::min_element(fitness_span.begin(), fitness_span.end()) - fitness_span.begin();
-        auto best_genome = population.genome(best_idx);
-        auto best_fitness = population.fitness(best_idx);
+        std::optional<CheckpointWriterFor<GenomeT>> checkpoints;
+        const std::uint64_t config_hash = checkpoint_config_hash(problem, config);
+        auto state = [&] {
+            if (config.enable_checkpoints) {
+                if constexpr (CheckpointableGenome<GenomeT>) {
+                    checkpoints.emplace(config.checkpoint_path, config.save_population_snapshots);
+                    if (std::filesystem::exists(config.checkpoint_path)) {
+                        return restore(problem, config, config_hash);
+                    }
+                } else {
+                    throw std::invalid_argument("Checkpoints require genomes that are "
+                                                "contiguous arrays of trivially copyable genes");
+                }
+            }
+            return initialize(problem, config);
+        }();
+        auto last_checkpoint = start_time;
 
         GAResult<GenomeT> result;
         result.history.reserve(config.max_generations);
 
-        std::size_t evaluations = config.population_size;
-        std::size_t stagnation_count = 0;
-        std::size_t gens_processed = 0;
+        std::size_t gens_processed = state.generation;
 
-        for (std::size_t gen = 0; gen < config.max_generations; ++gen) {
+        for (std::size_t gen = state.generation; gen < config.max_generations; ++gen) {
             // Check termination conditions
             const auto current_time = std::chrono::steady_clock::now();
             const auto elapsed =
@@ -196,161 +380,522 @@ class GeneticAlgorithm {
 
             if (config.time_limit.count() > 0 && elapsed >= config.time_limit)
                 break;
-            if (config.max_evaluations > 0 && evaluations >= config.max_evaluations)
+            if (config.max_evaluations > 0 && state.evaluations >= config.max_evaluations)
                 break;
 
-            // Create next generation with optimized memory layout
-            Population<GenomeT> new_population(config.population_size, config.memory_resource);
+            evolve(problem, state, config);
 
-            // Elite preservation
-            const std::size_t elite_count =
-                static_cast<std::size_t>(config.elite_ratio * config.population_size);
-            if (elite_count > 0) {
-                // Use nth_element for O(n) elite selection instead of O(n log n) sort
-                std::vector<std::size_t> indices(population.size());
-                std::iota(indices.begin(), indices.end(), 0);
+            // Log statistics
+            if (gen % config.log_interval == 0) {
+                result.history.push_back(generation_stats(state, config, elapsed));
+            }
 
-                // Partition so that the elite_count best elements are at the beginning
-                if (elite_count < indices.size()) {
-                    std::nth_element(indices.begin(), indices.begin() + elite_count, indices.end(),
-                                     [&](std::size_t a, std::size_t b) {
-                                         return population.fitness(a) < population.fitness(b);
-                                     });
-                }
+            // Check convergence
+            if (state.stagnation_count >= config.stagnation_limit) {
+                result.converged = true;
+                break;
+            }
 
-                // Copy elite individuals
-                const std::size_t actual_elite_count = std::min(elite_count, indices.size());
-                for (std::size_t i = 0; i < actual_elite_count; ++i) {
-                    const auto idx = indices[i];
-                    new_population.push_back(population.genome(idx), population.fitness(idx));
+            // Mark this generation as completed regardless of logging cadence
+            gens_processed = gen + 1;
+
+            if (checkpoints) {
+                const auto now = std::chrono::steady_clock::now();
+                const bool due =
+                    (config.checkpoint_interval > 0 &&
+                     state.generation % config.checkpoint_interval == 0) ||
+                    (config.checkpoint_period.count() > 0 &&
+                     now - last_checkpoint >= config.checkpoint_period);
+                if (due) {
+                    save_checkpoint(*checkpoints, state, config_hash);
+                    last_checkpoint = now;
                 }
             }
+        }
 
-            // Generate offspring
-            // Use fitness span directly for selection - major performance improvement
-            auto fitness_span = population.fitness_values();
+        if (checkpoints) {
+            save_checkpoint(*checkpoints, state, config_hash, true);
+        }
 
-            while (new_population.size() < config.population_size) {
+        const auto end_time = std::chrono::steady_clock::now();
 
-                auto parent1_idx = selection_.select(fitness_span, rng_);
-                auto parent2_idx = selection_.select(fitness_span, rng_);
+        result.best_genome =
+            detail::to_original_if_available(problem, std::move(state.best_genome));
+        result.best_fitness = state.best_fitness;
+        // Report total processed generations (1-based), independent of logging cadence
+        result.generations = gens_processed;
+        result.evaluations = state.evaluations;
+        result.total_time =
+            std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        result.operator_stats = state.timer.totals();
 
-                auto offspring = population.genome(parent1_idx);
+        return result;
+    }
 
-                // Crossover
-                if (std::uniform_real_distribution<>(0.0, 1.0)(rng_) < config.crossover_prob) {
-                    auto [child1, child2] =
-                        crossover_.cross(problem, population.genome(parent1_idx),
-                                         population.genome(parent2_idx), rng_);
-                    offspring = std::move(child1);
+    /// Create and score the initial population of a run
+    ///
+    /// Reseeds the generator from config.seed. config.population_size must be positive.
+    template <Problem P>
+        requires supports<P>
+    EvolutionState<typename P::GenomeT> initialize(const P& problem, const GAConfig& config) {
+        using GenomeT = typename P::GenomeT;
+        assert(config.population_size > 0);
 
-                    // Add second child if there's room
-                    if (new_population.size() + 1 < config.population_size) {
-                        // Mutation
-                        if (std::uniform_real_distribution<>(0.0, 1.0)(rng_) <
-                            config.mutation_prob) {
-                            mutation_.mutate(problem, child2, rng_);
-                        }
-                        repair_if_available(problem, child2);
+        rng_.seed(config.seed);
 
-                        auto fitness2 = problem.evaluate(child2);
-                        evaluations++;
+        EvolutionState<GenomeT> state(config);
+        auto& population = state.population;
+        auto& executor = *state.executor;
+
+        if (config.parallel_generation) {
+            // Stream 0 of the counter-based RNG is reserved for the initial population
+            population.resize(config.population_size);
+            executor.for_each(config.population_size, [&](std::size_t i) {
+                auto rng = make_stream_rng(config.seed, 0, i);
+                auto genome = problem.random_genome(rng);
+                repair_if_available(problem, genome);
+                population.genome(i) = std::move(genome);
+            });
+
+            // Score in chunks so each task goes through the problem's batch path
+            const std::span<const GenomeT> genomes = population.genomes();
+            const std::span<Fitness> fitness = population.fitness_values();
+            const std::size_t chunk = std::max<std::size_t>(1, config.parallel_chunk_size);
+            executor.for_each((config.population_size + chunk - 1) / chunk, [&](std::size_t c) {
+                const std::size_t first = c * chunk;
+                const std::size_t count = std::min(chunk, config.population_size - first);
+                evaluate_all(problem, genomes.subspan(first, count), fitness.subspan(first, count));
+            });
+        } else {
+            for (std::size_t i = 0; i < config.population_size; ++i) {
+                auto genome = problem.random_genome(rng_);
+                repair_if_available(problem, genome);
+                population.push_back(std::move(genome), Fitness{});
+            }
 
-                        // Local search if available
-                        if constexpr (!std::same_as<LocalSearch, void*>) {
-                            fitness2 = local_search_.improve(problem, child2, rng_);
-                            evaluations++;
-                        }
+            // Score the whole initial population in one batch
+            evaluate_all(problem, std::span<const GenomeT>(population.genomes()),
+                         population.fitness_values());
+        }
 
-                        new_population.push_back(std::move(child2), fitness2);
-                    }
-                }
+        // Track best solution
+        auto fitness_span = population.fitness_values();
+        auto best_idx =
+            std::min_element(fitness_span.begin(), fitness_span.end()) - fitness_span.begin();
+        state.best_genome = population.genome(best_idx);
+        state.best_fitness = population.fitness(best_idx);
+        state.evaluations = config.population_size;
 
-                // Mutation
-                if (std::uniform_real_distribution<>(0.0, 1.0)(rng_) < config.mutation_prob) {
-                    mutation_.mutate(problem, offspring, rng_);
-                }
-                repair_if_available(problem, offspring);
+        prepare_breeding(state, config);
+        return state;
+    }
 
-                auto fitness = problem.evaluate(offspring);
-                evaluations++;
+    /// Breed one generation and update the best solution and stagnation count
+    template <Problem P>
+        requires supports<P>
+    void evolve(const P& problem, EvolutionState<typename P::GenomeT>& state,
+                const GAConfig& config) {
+        auto& population = state.population;
+        auto& next = state.next;
+        auto& elite_indices = state.elite_indices;
+        auto timed = state.timer.local(0);
+        state.timer.begin_generation();
+
+        // Elite preservation
+        const std::size_t elite_count =
+            std::min(static_cast<std::size_t>(config.elite_ratio * config.population_size),
+                     population.size());
+        if (elite_count > 0) {
+            timed.measure(Phase::Elites, [&] {
+                // Use nth_element for O(n) elite selection instead of O(n log n) sort
+                elite_indices.resize(population.size());
+                std::iota(elite_indices.begin(), elite_indices.end(), 0);
 
-                // Local search if available
-                if constexpr (!std::same_as<LocalSearch, void*>) {
-                    fitness = local_search_.improve(problem, offspring, rng_);
-                    evaluations++;
+                // Partition so that the elite_count best elements are at the beginning
+                if (elite_count < elite_indices.size()) {
+                    std::nth_element(elite_indices.begin(), elite_indices.begin() + elite_count,
+                                     elite_indices.end(), [&](std::size_t a, std::size_t b) {
+                                         return population.fitness(a) < population.fitness(b);
+                                     });
                 }
 
-                new_population.push_back(std::move(offspring), fitness);
-            }
+                // Copy elite individuals
+                for (std::size_t i = 0; i < elite_count; ++i) {
+                    const auto idx = elite_indices[i];
+                    next.genome(i) = population.genome(idx);
+                    next.fitness(i) = population.fitness(idx);
+                }
+            });
+        }
 
-            // At this point, the population size should exactly match the configured size.
-            // If it can be larger, it indicates a logic error in the offspring generation loop.
-            assert(new_population.size() == config.population_size);
+        // Generate offspring into the remaining slots
+        if (config.parallel_generation) {
+            state.evaluations +=
+                generate_offspring_parallel(problem, population, next, elite_count,
+                                            state.spare_child, config, state.generation,
+                                            *state.executor, state.timer);
+        } else {
+            generate_offspring_serial(problem, population, next, elite_count, state.spare_child,
+                                      config, state.evaluations, timed);
+        }
 
-            population = std::move(new_population);
+        population.swap(next);
+        ++state.generation;
+
+        timed.measure(Phase::Statistics, [&] {
+            // Move the edge counts to the new individuals; `next` holds the ones they replaced
+            for (std::size_t i = 0; state.tracks_edges && i < population.size(); ++i) {
+                state.track_replacement(i, next.genome(i), population.genome(i));
+            }
 
             // Update best solution
-            auto current_fitness_span = population.fitness_values();
+            auto fitness_span = population.fitness_values();
             auto gen_best_idx =
-                std::min_element(current_fitness_span.begin(), current_fitness_span.end()) -
-                current_fitness_span.begin();
-            if (population.fitness(gen_best_idx) < best_fitness) {
-                best_genome = population.genome(gen_best_idx);
-                best_fitness = population.fitness(gen_best_idx);
-                stagnation_count = 0;
+                std::min_element(fitness_span.begin(), fitness_span.end()) - fitness_span.begin();
+            if (population.fitness(gen_best_idx) < state.best_fitness) {
+                state.best_genome = population.genome(gen_best_idx);
+                state.best_fitness = population.fitness(gen_best_idx);
+                state.stagnation_count = 0;
             } else {
-                stagnation_count++;
+                state.stagnation_count++;
             }
+        });
 
-            // Log statistics
-            if (gen % config.log_interval == 0) {
-                GenerationStats stats;
-                stats.generation = gen;
-                stats.best_fitness = best_fitness;
-
-                auto current_fitness_span = population.fitness_values();
-                stats.mean_fitness = Fitness(
-                    std::accumulate(current_fitness_span.begin(), current_fitness_span.end(), 0.0,
-                                    [](double sum, const Fitness& f) { return sum + f.value; }) /
-                    current_fitness_span.size());
-                stats.worst_fitness =
-                    *std::max_element(current_fitness_span.begin(), current_fitness_span.end());
+        state.timer.collect();
+    }
 
+    /// Statistics of the population after the generation evolve() completed last
+    ///
+    /// The time taken counts towards that generation's Phase::Statistics.
+    template <typename GenomeT>
+    GenerationStats generation_stats(EvolutionState<GenomeT>& state, const GAConfig& config,
+                                     std::chrono::milliseconds elapsed) {
+        GenerationStats stats;
+        state.timer.local(0).measure(Phase::Statistics, [&] {
+            stats.generation = state.generation - 1;
+            stats.best_fitness = state.best_fitness;
+
+            auto fitness_span = state.population.fitness_values();
+            stats.mean_fitness = Fitness(
+                std::accumulate(fitness_span.begin(), fitness_span.end(), 0.0,
+                                [](double sum, const Fitness& f) { return sum + f.value; }) /
+                fitness_span.size());
+            stats.worst_fitness = *std::max_element(fitness_span.begin(), fitness_span.end());
+
+            if (!config.enable_diversity_tracking) {
+                stats.diversity = 0.0;
+            } else if (config.diversity_measure == DiversityMeasure::EdgeEntropy) {
+                stats.diversity = edge_diversity(state);
+            } else {
                 // Calculate diversity directly from spans (no copying needed)
                 stats.diversity =
-                    config.enable_diversity_tracking
-                        ? calculate_diversity<GenomeT>(population.genomes(), rng_, config)
-                        : 0.0;
-                stats.elapsed_time = elapsed;
+                    calculate_diversity<GenomeT>(state.population.genomes(), rng_, config);
+            }
+            stats.elapsed_time = elapsed;
+        });
+        state.timer.collect();
+        stats.operator_stats = state.timer.generation();
+        return stats;
+    }
 
-                result.history.push_back(stats);
+  private:
+    /// Each generation is bred into a second population of the same shape, overwriting its
+    /// genomes in place, and the two swap roles. Genome storage is thus allocated once here
+    /// and reused for the rest of the run.
+    template <typename GenomeT>
+    static void prepare_breeding(EvolutionState<GenomeT>& state, const GAConfig& config) {
+        const auto& population = state.population;
+        state.next.resize(config.population_size);
+        for (std::size_t i = 0; i < config.population_size; ++i) {
+            state.next.genome(i) = population.genome(i);
+        }
+        state.spare_child = population.genome(0);
+        state.elite_indices.reserve(config.population_size);
+
+        if constexpr (TourGenome<GenomeT>) {
+            const std::size_t cities = std::ranges::size(population.genome(0));
+            if (state.tracks_edges && cities >= 3) {
+                state.edge_frequencies.reset(population.size(), cities);
+                for (std::size_t i = 0; i < population.size(); ++i) {
+                    state.edge_frequencies.insert(i, population.genome(i));
+                }
             }
+        }
+    }
 
-            // Check convergence
-            if (stagnation_count >= config.stagnation_limit) {
-                result.converged = true;
-                break;
+    /// Identifies the settings a checkpoint is only valid for: the problem size and every
+    /// GAConfig field that affects the course of a run, except the termination criteria
+    /// (so that a resumed run may go on for longer). Operators and problem data are not
+    /// covered; resuming with different ones is the caller's responsibility.
+    template <Problem P>
+    static std::uint64_t checkpoint_config_hash(const P& problem, const GAConfig& config) {
+        std::uint64_t hash = 0;
+        auto mix = [&hash](std::uint64_t value) { hash = splitmix64(hash ^ value); };
+        mix(CHECKPOINT_VERSION);
+        mix(static_cast<std::uint64_t>(problem.size()));
+        mix(config.population_size);
+        mix(config.seed);
+        mix(std::bit_cast<std::uint64_t>(config.crossover_prob));
+        mix(std::bit_cast<std::uint64_t>(config.mutation_prob));
+        mix(std::bit_cast<std::uint64_t>(config.elite_ratio));
+        // Only the sampled measure draws from the generator
+        mix(config.enable_diversity_tracking &&
+                    config.diversity_measure == DiversityMeasure::Hamming
+                ? config.diversity_max_samples
+                : 0);
+        mix(config.log_interval);
+        mix(config.parallel_generation ? 1 : 0);
+        mix(config.delta_evaluation ? 1 : 0);
+        return hash;
+    }
+
+    /// Rebuild the state saved at config.checkpoint_path, including the generator
+    template <Problem P>
+        requires CheckpointableGenome<typename P::GenomeT>
+    EvolutionState<typename P::GenomeT> restore(const P&, const GAConfig& config,
+                                                std::uint64_t config_hash) {
+        using GenomeT = typename P::GenomeT;
+        using Gene = std::ranges::range_value_t<GenomeT>;
+
+        const auto checkpoint = read_checkpoint<Gene>(config.checkpoint_path);
+        if (checkpoint.config_hash != config_hash ||
+            checkpoint.population_size() != config.population_size) {
+            throw CheckpointError(config.checkpoint_path +
+                                  " was written for a different configuration");
+        }
+
+        const std::size_t length = checkpoint.genome_length;
+        auto to_genome = [length](const Gene* genes, GenomeT& genome) {
+            genome.resize(length);
+            std::copy_n(genes, length, std::ranges::data(genome));
+        };
+
+        EvolutionState<GenomeT> state(config);
+        auto& population = state.population;
+        population.resize(config.population_size);
+        for (std::size_t i = 0; i < config.population_size; ++i) {
+            to_genome(checkpoint.genes.data() + i * length, population.genome(i));
+            population.fitness(i) = Fitness{checkpoint.fitness[i]};
+        }
+        to_genome(checkpoint.best_genome.data(), state.best_genome);
+        state.best_fitness = Fitness{checkpoint.best_fitness};
+        state.generation = checkpoint.generation;
+        state.evaluations = checkpoint.evaluations;
+        state.stagnation_count = checkpoint.stagnation_count;
+        rng_ = checkpoint.rng;
+
+        prepare_breeding(state, config);
+        return state;
+    }
+
+    /// Copy the state into the writer's free buffer and queue it; the write happens on the
+    /// writer's thread unless `wait` asks to block until it is done
+    template <typename GenomeT>
+    void save_checkpoint(CheckpointWriterFor<GenomeT>& writer, const EvolutionState<GenomeT>& state,
+                         std::uint64_t config_hash, bool wait = false) const {
+        if constexpr (CheckpointableGenome<GenomeT>) {
+            const auto& population = state.population;
+            const std::size_t length = std::ranges::size(state.best_genome);
+            auto& checkpoint = writer.buffer();
+            checkpoint.config_hash = config_hash;
+            checkpoint.generation = state.generation;
+            checkpoint.evaluations = state.evaluations;
+            checkpoint.stagnation_count = state.stagnation_count;
+            checkpoint.genome_length = length;
+            checkpoint.fitness.resize(population.size());
+            checkpoint.genes.resize(population.size() * length);
+            for (std::size_t i = 0; i < population.size(); ++i) {
+                const auto& genome = population.genome(i);
+                if (std::ranges::size(genome) != length) {
+                    throw std::invalid_argument("Checkpoints require genomes of equal length");
+                }
+                std::ranges::copy(genome, checkpoint.genes.begin() + i * length);
+                checkpoint.fitness[i] = population.fitness(i).value;
             }
+            checkpoint.best_genome.assign(std::ranges::begin(state.best_genome),
+                                          std::ranges::end(state.best_genome));
+            checkpoint.best_fitness = state.best_fitness.value;
+            checkpoint.rng = rng_;
+            writer.publish();
+            if (wait) {
+                writer.wait();
+            }
+        }
+    }
 
-            // Mark this generation as completed regardless of logging cadence
-            gens_processed = gen + 1;
+    /// Breed slots [first_slot, population_size) of `next` from the shared generator
+    /// (sequential mode)
+    template <Problem P>
+    void generate_offspring_serial(const P& problem,
+                                   const Population<typename P::GenomeT>& population,
+                                   Population<typename P::GenomeT>& next, std::size_t first_slot,
+                                   typename P::GenomeT& spare_child, const GAConfig& config,
+                                   std::size_t& evaluations, OperatorTimer::Local& timed) {
+        // Use fitness span directly for selection - major performance improvement
+        auto fitness_span = population.fitness_values();
+
+        std::size_t slot = first_slot;
+        while (slot < config.population_size) {
+
+            auto select = [&] { return selection_.select(fitness_span, rng_); };
+            auto parent1_idx = timed.measure(Phase::Selection, select);
+            auto parent2_idx = timed.measure(Phase::Selection, select);
+
+            // Crossover
+            if (std::uniform_real_distribution<>(0.0, 1.0)(rng_) < config.crossover_prob) {
+                // The second child goes first if there is room for both
+                const bool has_second = slot + 1 < config.population_size;
+                auto& child1 = next.genome(has_second ? slot + 1 : slot);
+                auto& child2 = has_second ? next.genome(slot) : spare_child;
+                timed.measure(Phase::Crossover, [&] {
+                    recombine(problem, population.genome(parent1_idx),
+                              population.genome(parent2_idx), child1, child2, rng_);
+                });
+
+                if (has_second) {
+                    next.fitness(slot) = finish_offspring(problem, child2, rng_, config, timed);
+                    evaluations += evaluations_per_child;
+                    ++slot;
+                }
+                next.fitness(slot) = finish_offspring(problem, child1, rng_, config, timed);
+            } else {
+                auto& offspring = next.genome(slot);
+                offspring = population.genome(parent1_idx);
+                next.fitness(slot) = finish_offspring(problem, offspring, rng_, config, timed,
+                                                      fitness_span[parent1_idx]);
+            }
+            evaluations += evaluations_per_child;
+            ++slot;
         }
+    }
 
-        const auto end_time = std::chrono::steady_clock::now();
+    /// Breed slots [first_slot, population_size) of `next` concurrently, one task per
+    /// offspring pair
+    ///
+    /// Task k owns slots (first + 2k, first + 2k + 1) and draws all of its randomness from
+    /// make_stream_rng(seed, generation + 1, k), so the produced population is independent of
+    /// thread count and scheduling. Operators and the problem are shared read-only; the
+    /// problem's evaluate() and the local search must therefore be safe for concurrent calls.
+    ///
+    /// @return Number of evaluations performed
+    template <Problem P>
+    std::size_t generate_offspring_parallel(const P& problem,
+                                            const Population<typename P::GenomeT>& population,
+                                            Population<typename P::GenomeT>& next,
+                                            std::size_t first_slot,
+                                            typename P::GenomeT& spare_child,
+                                            const GAConfig& config, std::size_t generation,
+                                            detail::OffspringExecutor& executor,
+                                            OperatorTimer& timer) {
+        const std::size_t slots = config.population_size - first_slot;
+        const std::size_t pairs = (slots + 1) / 2;
+
+        const auto fitness_span = population.fitness_values();
+
+        executor.for_each(pairs, [&](std::size_t pair) {
+            auto rng = make_stream_rng(config.seed, generation + 1, pair);
+            auto timed = timer.local(detail::OffspringExecutor::thread_index());
+            const std::size_t slot = first_slot + 2 * pair;
+            const bool has_second = slot + 1 < config.population_size;
+
+            auto select = [&] { return selection_.select(fitness_span, rng); };
+            const auto parent1_idx = timed.measure(Phase::Selection, select);
+            const auto parent2_idx = timed.measure(Phase::Selection, select);
+
+            // Only the last pair can lack a second slot, so no two tasks share the spare
+            auto& child1 = next.genome(slot);
+            auto& child2 = has_second ? next.genome(slot + 1) : spare_child;
+            std::optional<Fitness> parent1_fitness;
+            std::optional<Fitness> parent2_fitness;
+            if (std::uniform_real_distribution<>(0.0, 1.0)(rng) < config.crossover_prob) {
+                timed.measure(Phase::Crossover, [&] {
+                    recombine(problem, population.genome(parent1_idx),
+                              population.genome(parent2_idx), child1, child2, rng);
+                });
+            } else {
+                child1 = population.genome(parent1_idx);
+                parent1_fitness = fitness_span[parent1_idx];
+                if (has_second) {
+                    child2 = population.genome(parent2_idx);
+                    parent2_fitness = fitness_span[parent2_idx];
+                }
+            }
 
-        result.best_genome = std::move(best_genome);
-        result.best_fitness = best_fitness;
-        // Report total processed generations (1-based), independent of logging cadence
-        result.generations = gens_processed;
-        result.evaluations = evaluations;
-        result.total_time =
-            std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+            next.fitness(slot) =
+                finish_offspring(problem, child1, rng, config, timed, parent1_fitness);
+            if (has_second) {
+                next.fitness(slot + 1) =
+                    finish_offspring(problem, child2, rng, config, timed, parent2_fitness);
+            }
+        });
 
-        return result;
+        return slots * evaluations_per_child;
+    }
+
+    /// Write the children of two parents into existing genomes, reusing their storage when
+    /// the crossover supports it (InPlaceCrossoverOperator)
+    template <Problem P>
+    void recombine(const P& problem, const typename P::GenomeT& parent1,
+                   const typename P::GenomeT& parent2, typename P::GenomeT& child1,
+                   typename P::GenomeT& child2, std::mt19937& rng) const {
+        if constexpr (InPlaceCrossoverOperator<Crossover, P>) {
+            crossover_.cross_into(problem, parent1, parent2, child1, child2, rng);
+        } else {
+            auto [c1, c2] = crossover_.cross(problem, parent1, parent2, rng);
+            child1 = std::move(c1);
+            child2 = std::move(c2);
+        }
+    }
+
+    /// Evaluations charged per offspring: the child itself, plus the local search if present
+    /// (a delta-scored child is charged like a full evaluation so budgets are comparable)
+    static constexpr std::size_t evaluations_per_child = std::same_as<LocalSearch, void*> ? 1 : 2;
+
+    /// Mutate, repair, evaluate and locally improve a freshly created child
+    ///
+    /// @param parent_fitness Fitness of the parent when child is an unmodified copy of it; the
+    ///        child is then scored incrementally if GAConfig::delta_evaluation allows
+    template <Problem P>
+    Fitness finish_offspring(const P& problem, typename P::GenomeT& child, std::mt19937& rng,
+                             const GAConfig& config, OperatorTimer::Local& timed,
+                             std::optional<Fitness> parent_fitness = std::nullopt) {
+        auto fitness = mutate_and_score(problem, child, rng, config, timed, parent_fitness);
+
+        if constexpr (!std::same_as<LocalSearch, void*>) {
+            const Fitness before = fitness;
+            fitness = timed.measure(Phase::LocalSearch,
+                                    [&] { return local_search_.improve(problem, child, rng); });
+            timed.improvement(Phase::LocalSearch, before.value - fitness.value);
+        }
+        return fitness;
+    }
+
+    template <Problem P>
+    Fitness mutate_and_score(const P& problem, typename P::GenomeT& child, std::mt19937& rng,
+                             const GAConfig& config, OperatorTimer::Local& timed,
+                             std::optional<Fitness> parent_fitness) {
+        // A repair could change the genome after the move, so the delta is only valid without one
+        if constexpr (DeltaMutationOperator<Mutation, P> && std::same_as<Repair, void*>) {
+            if (parent_fitness && config.delta_evaluation) {
+                double delta = 0.0;
+                if (std::uniform_real_distribution<>(0.0, 1.0)(rng) < config.mutation_prob) {
+                    delta = timed.measure(Phase::Mutation, [&] {
+                        return mutation_.mutate_with_delta(problem, child, rng);
+                    });
+                }
+                return Fitness{parent_fitness->value + delta};
+            }
+        }
+
+        if (std::uniform_real_distribution<>(0.0, 1.0)(rng) < config.mutation_prob) {
+            timed.measure(Phase::Mutation, [&] { mutation_.mutate(problem, child, rng); });
+        }
+        if constexpr (!std::same_as<Repair, void*>) {
+            timed.measure(Phase::Repair, [&] { repair_.repair(problem, child); });
+        }
+        return timed.measure(Phase::Evaluation, [&] { return problem.evaluate(child); });
     }
 
-  private:
     template <Problem P>
     void repair_if_available(const P& problem, typename P::GenomeT& genome) {
         if constexpr (!std::same_as<Repair, void*>) {
@@ -358,6 +903,16 @@ class GeneticAlgorithm {
         }
     }
 
+    /// Normalized edge entropy of the population, read from the state's edge-frequency table
+    template <typename GenomeT>
+    static double edge_diversity(const EvolutionState<GenomeT>& state) noexcept {
+        if constexpr (TourGenome<GenomeT>) {
+            return state.edge_frequencies.diversity(); // 0 while the table is empty
+        } else {
+            return 0.0; // Rejected when the state was created
+        }
+    }
+
     template <typename GenomeT>
     // Using std::span instead of const std::vector<GenomeT>& for zero-copy access
     // and better performance - spans avoid iterator overhead and enable vectorization
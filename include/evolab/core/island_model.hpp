@@ -0,0 +1,561 @@
+#pragma once
+
+/// @file island_model.hpp
+/// @brief Island-model GA: concurrent subpopulations that exchange elites
+///
+/// An IslandModel runs one GeneticAlgorithm per island, each on its own thread with its own
+/// population and generator. Islands evolve independently for migration_interval generations;
+/// then every island sends copies of its best individuals to its neighbors, where they replace
+/// the worst. Islands only read each other's memory while migrating, so with NUMA placement
+/// each island keeps its thread, its population and its heap allocations on one node and the
+/// model scales across sockets without cross-node traffic on the hot path.
+///
+/// Synchronous migration meets at a barrier, which makes runs reproducible but lets the
+/// slowest island set the pace. Asynchronous migration passes migrants through lock-free
+/// single-producer/single-consumer rings instead (see utils::SpscRing): islands push and poll
+/// without ever waiting for each other.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <evolab/core/concepts.hpp>
+#include <evolab/core/ga.hpp>
+#include <evolab/core/population.hpp>
+#include <evolab/core/rng.hpp>
+#include <evolab/utils/numa_allocator.hpp>
+#include <evolab/utils/spsc_ring.hpp>
+
+namespace evolab::core {
+
+/// Islands that receive an island's migrants
+enum class MigrationTopology {
+    Ring,          ///< Island i sends to island (i + 1) mod islands
+    FullyConnected ///< Every island sends to every other island
+};
+
+/// How islands exchange migrants
+enum class MigrationMode {
+    Synchronous, ///< All islands migrate together at a barrier; results are reproducible
+    Asynchronous ///< Lock-free queues between islands; no island waits for another
+};
+
+/// Island model parameters; each island's GA is configured by GAConfig
+struct IslandConfig {
+    std::size_t islands = 4;
+    std::size_t migration_interval = 50; // Generations between migrations (0 = isolated islands)
+    std::size_t migrants = 2;            // Best individuals sent to each receiving island
+    MigrationTopology topology = MigrationTopology::Ring;
+    MigrationMode mode = MigrationMode::Synchronous;
+    bool numa_placement = true; // Island i's thread and memory on NUMA node i mod node count
+};
+
+/// Island-model driver for a GeneticAlgorithm
+///
+/// @tparam GA GeneticAlgorithm type; every island runs its own copy
+template <typename GA>
+class IslandModel {
+    GA prototype_;
+    IslandConfig config_;
+
+    /// Best individuals an island offers to its neighbors at one migration
+    template <typename GenomeT>
+    struct Outbox {
+        std::vector<GenomeT> genomes;
+        std::vector<Fitness> fitness;
+    };
+
+    /// Record passed between islands in asynchronous mode
+    template <typename GenomeT>
+    struct Migrant {
+        GenomeT genome;
+        Fitness fitness;
+    };
+
+    /// Queue from one island to another in asynchronous mode
+    template <typename GenomeT>
+    struct Channel {
+        std::size_t source;
+        std::size_t destination;
+        std::unique_ptr<utils::SpscRing<Migrant<GenomeT>>> queue;
+    };
+
+    /// Per-island results and migration buffers, written only by the island's thread
+    template <typename GenomeT>
+    struct alignas(64) Island {
+        std::array<Outbox<GenomeT>, 2> outboxes; // Alternating by epoch, see run()
+        std::vector<std::size_t> order;          // Ranking scratch
+        GenomeT best_genome;
+        Fitness best_fitness{std::numeric_limits<double>::infinity()};
+        std::size_t generations = 0;
+        std::size_t evaluations = 0;
+        std::vector<GenerationStats> history;
+        OperatorTimings operator_stats;
+        bool done = false;
+        bool converged = false;
+        std::exception_ptr error;
+    };
+
+  public:
+    /// @throws std::invalid_argument if islands.islands is 0
+    explicit IslandModel(GA ga, IslandConfig islands = {})
+        : prototype_(std::move(ga)), config_(islands) {
+        if (config_.islands == 0) {
+            throw std::invalid_argument("IslandModel: at least one island is required");
+        }
+    }
+
+    [[nodiscard]] const IslandConfig& island_config() const noexcept { return config_; }
+
+    /// Run all islands to completion
+    ///
+    /// Every island evolves a population of config.population_size. Island 0 is seeded with
+    /// config.seed and the others with seeds derived from it, so one island reproduces
+    /// GeneticAlgorithm::run(). With synchronous migration, results do not depend on thread
+    /// scheduling (except through time_limit); with asynchronous migration, the migrants an
+    /// island receives depend on how far its neighbors have got, so runs may differ.
+    ///
+    /// Each island stops on its own after max_generations, at the time limit, once it has
+    /// used its even share of max_evaluations, or after stagnation_limit generations without
+    /// improvement. The run ends when all islands have stopped. Checkpoint settings of `config`
+    /// are not used.
+    ///
+    /// @return Best individual over all islands, generations of the longest-running island,
+    ///         evaluations and operator statistics summed over islands, and history merged
+    ///         across islands (best and worst over all of them, mean of the island means)
+    template <Problem P>
+        requires GA::template supports<P>
+    GAResult<typename P::GenomeT> run(const P& problem, const GAConfig& config = {}) {
+        using GenomeT = typename P::GenomeT;
+
+        const auto start_time = std::chrono::steady_clock::now();
+        const std::size_t count = config_.islands;
+
+        GAResult<GenomeT> result;
+        if (config.population_size == 0) {
+            result.best_fitness = Fitness{std::numeric_limits<double>::infinity()};
+            result.generations = 0;
+            result.evaluations = 0;
+            result.total_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start_time);
+            return result;
+        }
+
+        std::vector<Island<GenomeT>> islands(count);
+        if (config_.mode == MigrationMode::Asynchronous) {
+            run_asynchronous(problem, config, islands, start_time);
+        } else {
+            run_synchronous(problem, config, islands, start_time);
+        }
+
+        for (const auto& island : islands) {
+            if (island.error) {
+                std::rethrow_exception(island.error);
+            }
+        }
+
+        const auto best = std::ranges::min_element(
+            islands, [](const auto& a, const auto& b) { return a.best_fitness < b.best_fitness; });
+        result.best_genome =
+            detail::to_original_if_available(problem, std::move(best->best_genome));
+        result.best_fitness = best->best_fitness;
+        result.converged = std::ranges::all_of(islands, [](const auto& i) { return i.converged; });
+        result.generations = 0;
+        result.evaluations = 0;
+        for (const auto& island : islands) {
+            result.generations = std::max(result.generations, island.generations);
+            result.evaluations += island.evaluations;
+            result.operator_stats += island.operator_stats;
+        }
+        result.history = merge_histories(islands);
+        result.total_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time);
+        return result;
+    }
+
+  private:
+    /// Islands migrate together: each epoch ends at a barrier
+    ///
+    /// Stopped islands keep arriving at the barrier, and keep sending and receiving migrants,
+    /// until all islands have stopped.
+    template <typename P, typename GenomeT>
+    void run_synchronous(const P& problem, const GAConfig& config,
+                         std::vector<Island<GenomeT>>& islands,
+                         std::chrono::steady_clock::time_point start_time) {
+        const std::size_t count = islands.size();
+        std::atomic<bool> failed{false};
+        bool stop = false;
+
+        // The completion step runs once all islands have arrived, before any continues
+        auto end_of_epoch = [&]() noexcept {
+            stop = failed.load(std::memory_order_relaxed) ||
+                   std::ranges::all_of(islands, [](const auto& island) { return island.done; });
+        };
+        std::barrier sync(static_cast<std::ptrdiff_t>(count), end_of_epoch);
+
+        // Epoch e ends with each island publishing to outboxes[e % 2], which its neighbors
+        // read after the barrier. The island writes that outbox again only after barrier
+        // e + 1, which every neighbor reaches after it has finished reading.
+        run_threads(count, [&](std::size_t id) {
+            auto& island = islands[id];
+            try {
+                std::unique_ptr<utils::NumaMemoryResource> resource;
+                const GAConfig island_config = prepare_island(config, id, count, resource);
+
+                // Copied on the island's thread so that operator state is allocated locally
+                GA ga = prototype_;
+                auto state = ga.initialize(problem, island_config);
+
+                for (std::size_t epoch = 0;; ++epoch) {
+                    if (!island.done) {
+                        evolve_epoch(ga, problem, state, island, island_config, start_time);
+                    }
+                    publish(state, island, island.outboxes[epoch % 2]);
+                    sync.arrive_and_wait();
+                    if (stop)
+                        break;
+                    immigrate(state, islands, id, epoch % 2);
+                }
+                finish_island(island, state);
+            } catch (...) {
+                island.error = std::current_exception();
+                failed.store(true, std::memory_order_relaxed);
+                sync.arrive_and_drop();
+            }
+        });
+    }
+
+    /// Islands migrate whenever they finish an epoch, through one SpscRing per pair of
+    /// sending and receiving island
+    ///
+    /// Rings hold two migrations' worth of migrants; migrants sent to a full ring (a receiver
+    /// that has fallen behind or stopped) are dropped. Ring slots are preallocated with
+    /// genomes of the problem's size, and migrants are copied into them and swapped out of
+    /// them, so migration allocates nothing.
+    template <typename P, typename GenomeT>
+    void run_asynchronous(const P& problem, const GAConfig& config,
+                          std::vector<Island<GenomeT>>& islands,
+                          std::chrono::steady_clock::time_point start_time) {
+        const std::size_t count = islands.size();
+
+        std::vector<Channel<GenomeT>> channels;
+        if (count > 1 && config_.migration_interval > 0 && config_.migrants > 0) {
+            std::mt19937 rng(config.seed);
+            const Migrant<GenomeT> prototype{problem.random_genome(rng),
+                                             Fitness{std::numeric_limits<double>::infinity()}};
+            for (std::size_t destination = 0; destination < count; ++destination) {
+                for (std::size_t source = 0; source < count; ++source) {
+                    if (sends_to(source, destination, count)) {
+                        channels.push_back(
+                            {source, destination,
+                             std::make_unique<utils::SpscRing<Migrant<GenomeT>>>(
+                                 2 * config_.migrants, prototype)});
+                    }
+                }
+            }
+        }
+
+        std::atomic<bool> failed{false};
+        run_threads(count, [&](std::size_t id) {
+            auto& island = islands[id];
+            try {
+                std::unique_ptr<utils::NumaMemoryResource> resource;
+                const GAConfig island_config = prepare_island(config, id, count, resource);
+
+                GA ga = prototype_;
+                auto state = ga.initialize(problem, island_config);
+
+                while (!island.done && !failed.load(std::memory_order_relaxed)) {
+                    evolve_epoch(ga, problem, state, island, island_config, start_time);
+                    if (!channels.empty()) {
+                        receive(state, island, id, channels);
+                        send(state, island, id, channels);
+                    }
+                }
+                finish_island(island, state);
+            } catch (...) {
+                island.error = std::current_exception();
+                failed.store(true, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    /// Run body(id) for every island on its own thread and wait for all of them
+    template <typename Body>
+    static void run_threads(std::size_t count, const Body& body) {
+        std::vector<std::jthread> threads;
+        threads.reserve(count);
+        for (std::size_t id = 0; id < count; ++id) {
+            threads.emplace_back(body, id);
+        }
+    }
+
+    /// GA configuration of island `id`
+    ///
+    /// With NUMA placement, also binds the calling thread to the island's node and creates
+    /// the island's memory resource in `resource`, which must outlive the island's state.
+    GAConfig prepare_island(const GAConfig& config, std::size_t id, std::size_t count,
+                            std::unique_ptr<utils::NumaMemoryResource>& resource) const {
+        if (config_.numa_placement) {
+            utils::bind_thread_to_island_node(static_cast<int>(id));
+            resource = utils::create_owned_island_resource(static_cast<int>(id));
+        }
+
+        GAConfig island_config = config;
+        island_config.seed = island_seed(config.seed, id);
+        if (resource) {
+            island_config.memory_resource = resource.get();
+        }
+        if (config.max_evaluations > 0) {
+            island_config.max_evaluations =
+                std::max<std::size_t>(1, config.max_evaluations / count);
+        }
+        return island_config;
+    }
+
+    /// Move the island's final results out of its state
+    template <typename GenomeT>
+    static void finish_island(Island<GenomeT>& island, EvolutionState<GenomeT>& state) {
+        island.best_genome = std::move(state.best_genome);
+        island.best_fitness = state.best_fitness;
+        island.evaluations = state.evaluations;
+        island.operator_stats = state.timer.totals();
+    }
+
+    /// Whether island `source` sends migrants to island `destination`
+    bool sends_to(std::size_t source, std::size_t destination, std::size_t count) const noexcept {
+        if (config_.topology == MigrationTopology::Ring)
+            return destination == (source + 1) % count;
+        return source != destination;
+    }
+
+    /// Seed of island `id`: the configured seed for island 0, derived streams for the rest
+    static std::uint64_t island_seed(std::uint64_t seed, std::size_t id) noexcept {
+        return id == 0 ? seed : splitmix64(seed ^ splitmix64(id));
+    }
+
+    /// Evolve up to migration_interval generations with GeneticAlgorithm::run()'s termination
+    /// rules, marking the island done when one of them fires
+    template <typename P, typename GenomeT>
+    void evolve_epoch(GA& ga, const P& problem, EvolutionState<GenomeT>& state,
+                      Island<GenomeT>& island, const GAConfig& config,
+                      std::chrono::steady_clock::time_point start_time) {
+        for (std::size_t g = 0; config_.migration_interval == 0 || g < config_.migration_interval;
+             ++g) {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start_time);
+            if (state.generation >= config.max_generations ||
+                (config.time_limit.count() > 0 && elapsed >= config.time_limit) ||
+                (config.max_evaluations > 0 && state.evaluations >= config.max_evaluations)) {
+                island.done = true;
+                return;
+            }
+
+            const std::size_t gen = state.generation;
+            ga.evolve(problem, state, config);
+            if (gen % config.log_interval == 0) {
+                island.history.push_back(ga.generation_stats(state, config, elapsed));
+            }
+            if (state.stagnation_count >= config.stagnation_limit) {
+                island.converged = true;
+                island.done = true;
+                return;
+            }
+            island.generations = state.generation;
+        }
+    }
+
+    /// Order population indices best first in `order`
+    /// @return Number of migrants to send: the first entries of `order`
+    template <typename GenomeT>
+    std::size_t rank_best(const Population<GenomeT>& population,
+                          std::vector<std::size_t>& order) const {
+        const std::size_t k = std::min(config_.migrants, population.size());
+        order.resize(population.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(order.begin(), order.begin() + k, order.end(),
+                          [&](std::size_t a, std::size_t b) {
+                              return population.fitness(a) < population.fitness(b);
+                          });
+        return k;
+    }
+
+    /// Order population indices worst first in `order`
+    template <typename GenomeT>
+    static void rank_worst(const Population<GenomeT>& population,
+                           std::vector<std::size_t>& order) {
+        order.resize(population.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::sort(order, [&](std::size_t a, std::size_t b) {
+            return population.fitness(b) < population.fitness(a);
+        });
+    }
+
+    /// Make an arrived migrant the island's best individual if it improves on it
+    template <typename GenomeT>
+    static void adopt_if_better(EvolutionState<GenomeT>& state, const GenomeT& genome,
+                                Fitness fitness) {
+        if (fitness < state.best_fitness) {
+            state.best_genome = genome;
+            state.best_fitness = fitness;
+            state.stagnation_count = 0;
+        }
+    }
+
+    /// Copy the island's best individuals, best first, into `outbox`
+    template <typename GenomeT>
+    void publish(const EvolutionState<GenomeT>& state, Island<GenomeT>& island,
+                 Outbox<GenomeT>& outbox) const {
+        const auto& population = state.population;
+        const std::size_t k = rank_best(population, island.order);
+        outbox.genomes.resize(k);
+        outbox.fitness.resize(k);
+        for (std::size_t j = 0; j < k; ++j) {
+            outbox.genomes[j] = population.genome(island.order[j]);
+            outbox.fitness[j] = population.fitness(island.order[j]);
+        }
+    }
+
+    /// Replace the worst individuals of island `id` with its neighbors' migrants
+    ///
+    /// At least one native individual is kept. Sources are visited in island order, so the
+    /// outcome is deterministic.
+    template <typename GenomeT>
+    void immigrate(EvolutionState<GenomeT>& state, std::vector<Island<GenomeT>>& islands,
+                   std::size_t id, std::size_t parity) const {
+        const std::size_t count = islands.size();
+        if (count < 2 || config_.migration_interval == 0)
+            return;
+
+        auto& population = state.population;
+        auto& order = islands[id].order;
+        rank_worst(population, order);
+
+        std::size_t slot = 0;
+        for (std::size_t source = 0; source < count; ++source) {
+            if (!sends_to(source, id, count))
+                continue;
+            const auto& outbox = islands[source].outboxes[parity];
+            for (std::size_t j = 0; j < outbox.genomes.size() && slot + 1 < order.size(); ++j) {
+                const std::size_t target = order[slot++];
+                state.track_replacement(target, population.genome(target), outbox.genomes[j]);
+                population.genome(target) = outbox.genomes[j];
+                population.fitness(target) = outbox.fitness[j];
+                adopt_if_better(state, outbox.genomes[j], outbox.fitness[j]);
+            }
+        }
+    }
+
+    /// Push copies of island `id`'s best individuals into the queues to its receivers
+    ///
+    /// Stops filling a queue once it is full.
+    template <typename GenomeT>
+    void send(const EvolutionState<GenomeT>& state, Island<GenomeT>& island, std::size_t id,
+              std::vector<Channel<GenomeT>>& channels) const {
+        const auto& population = state.population;
+        const std::size_t k = rank_best(population, island.order);
+        for (auto& channel : channels) {
+            if (channel.source != id)
+                continue;
+            for (std::size_t j = 0; j < k; ++j) {
+                const std::size_t index = island.order[j];
+                const bool sent = channel.queue->try_push_with([&](Migrant<GenomeT>& slot) {
+                    slot.genome = population.genome(index);
+                    slot.fitness = population.fitness(index);
+                });
+                if (!sent)
+                    break;
+            }
+        }
+    }
+
+    /// Replace the worst individuals of island `id` with the migrants waiting in its queues
+    ///
+    /// Migrant genomes are swapped into the population, leaving the replaced genomes in the
+    /// queue slots for reuse. At least one native individual is kept.
+    template <typename GenomeT>
+    static void receive(EvolutionState<GenomeT>& state, Island<GenomeT>& island, std::size_t id,
+                        std::vector<Channel<GenomeT>>& channels) {
+        auto& population = state.population;
+        auto& order = island.order;
+        rank_worst(population, order);
+
+        std::size_t slot = 0;
+        for (auto& channel : channels) {
+            if (channel.destination != id)
+                continue;
+            while (slot + 1 < order.size()) {
+                const bool received = channel.queue->try_pop_with([&](Migrant<GenomeT>& migrant) {
+                    const std::size_t target = order[slot++];
+                    state.track_replacement(target, population.genome(target), migrant.genome);
+                    using std::swap;
+                    swap(population.genome(target), migrant.genome);
+                    population.fitness(target) = migrant.fitness;
+                    adopt_if_better(state, population.genome(target), migrant.fitness);
+                });
+                if (!received)
+                    break;
+            }
+        }
+    }
+
+    /// Combine the islands' histories entry by entry (entries share generation numbers)
+    template <typename GenomeT>
+    static std::vector<GenerationStats>
+    merge_histories(const std::vector<Island<GenomeT>>& islands) {
+        std::size_t length = 0;
+        for (const auto& island : islands) {
+            length = std::max(length, island.history.size());
+        }
+
+        std::vector<GenerationStats> merged;
+        merged.reserve(length);
+        for (std::size_t k = 0; k < length; ++k) {
+            GenerationStats stats{};
+            std::size_t reporting = 0;
+            double mean_sum = 0.0;
+            double diversity_sum = 0.0;
+            for (const auto& island : islands) {
+                if (k >= island.history.size())
+                    continue;
+                const auto& entry = island.history[k];
+                if (reporting == 0) {
+                    stats = entry;
+                } else {
+                    stats.best_fitness = std::min(stats.best_fitness, entry.best_fitness);
+                    stats.worst_fitness = std::max(stats.worst_fitness, entry.worst_fitness);
+                    stats.elapsed_time = std::max(stats.elapsed_time, entry.elapsed_time);
+                    stats.operator_stats += entry.operator_stats;
+                }
+                mean_sum += entry.mean_fitness.value;
+                diversity_sum += entry.diversity;
+                ++reporting;
+            }
+            stats.mean_fitness = Fitness{mean_sum / static_cast<double>(reporting)};
+            stats.diversity = diversity_sum / static_cast<double>(reporting);
+            merged.push_back(stats);
+        }
+        return merged;
+    }
+};
+
+/// Factory function for island models
+template <typename GA>
+auto make_island_model(GA ga, IslandConfig islands = {}) {
+    return IslandModel<GA>(std::move(ga), islands);
+}
+
+} // namespace evolab::core
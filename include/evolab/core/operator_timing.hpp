@@ -0,0 +1,313 @@
+#pragma once
+
+/// @file operator_timing.hpp
+/// @brief Per-phase timing of the genetic algorithm's generation loop
+///
+/// With GAConfig::track_operator_performance, GeneticAlgorithm times each phase of a
+/// generation. Every thread adds raw clock ticks to its own counters, which are converted to
+/// nanoseconds and merged once per generation, so a timed phase costs two clock reads and
+/// no writes to memory shared between threads.
+///
+/// The clock is a compile-time policy. On x86-64 it reads the time-stamp counter, which is
+/// cheaper than steady_clock and is calibrated against it over the run; elsewhere it is
+/// steady_clock. Defining EVOLAB_NO_OPERATOR_TIMING selects a clock that measures nothing, and
+/// the timing code, including the check of the runtime flag, compiles away.
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define EVOLAB_HAVE_TSC 1
+#endif
+
+namespace evolab::core {
+
+/// Operator performance statistics
+struct OperatorStats {
+    std::size_t executions = 0;             // Number of times executed
+    std::chrono::nanoseconds total_time{0}; // Total execution time
+    std::size_t successes = 0;              // Number of successful operations
+    double average_improvement = 0.0;       // Average fitness improvement
+
+    // Calculate averages
+    double average_time_ms() const {
+        return executions > 0 ? static_cast<double>(total_time.count()) / (executions * 1000000.0)
+                              : 0.0;
+    }
+
+    double success_rate() const {
+        return executions > 0 ? static_cast<double>(successes) / executions : 0.0;
+    }
+
+    /// Combine with the statistics of other executions of the same operator
+    OperatorStats& operator+=(const OperatorStats& other) {
+        const std::size_t combined = executions + other.executions;
+        if (combined > 0) {
+            average_improvement = (average_improvement * executions +
+                                   other.average_improvement * other.executions) /
+                                  combined;
+        }
+        executions = combined;
+        total_time += other.total_time;
+        successes += other.successes;
+        return *this;
+    }
+};
+
+/// Phases of a generation, in the order they run
+enum class Phase : std::size_t {
+    Selection,   ///< Parent selection, one execution per parent
+    Crossover,   ///< Recombination of two parents into two children
+    Mutation,    ///< Mutation, including the move delta when a child is scored incrementally
+    Repair,      ///< Repair operator
+    Evaluation,  ///< Full evaluation of a child
+    LocalSearch, ///< Local search; a success is a child it improved
+    Elites,      ///< Extraction and copying of the elite
+    Statistics   ///< Best-solution tracking and generation statistics
+};
+
+inline constexpr std::size_t PHASE_COUNT = 8;
+
+/// Name of a phase, as used in reports
+constexpr std::string_view phase_name(Phase phase) noexcept {
+    switch (phase) {
+    case Phase::Selection:
+        return "selection";
+    case Phase::Crossover:
+        return "crossover";
+    case Phase::Mutation:
+        return "mutation";
+    case Phase::Repair:
+        return "repair";
+    case Phase::Evaluation:
+        return "evaluation";
+    case Phase::LocalSearch:
+        return "local_search";
+    case Phase::Elites:
+        return "elites";
+    case Phase::Statistics:
+        return "statistics";
+    }
+    return "unknown";
+}
+
+/// Statistics of every phase, over one generation or a whole run
+struct OperatorTimings {
+    std::array<OperatorStats, PHASE_COUNT> phases{};
+
+    OperatorStats& operator[](Phase phase) noexcept {
+        return phases[static_cast<std::size_t>(phase)];
+    }
+    const OperatorStats& operator[](Phase phase) const noexcept {
+        return phases[static_cast<std::size_t>(phase)];
+    }
+
+    /// Time spent in all phases
+    std::chrono::nanoseconds total_time() const noexcept {
+        std::chrono::nanoseconds total{0};
+        for (const auto& stats : phases) {
+            total += stats.total_time;
+        }
+        return total;
+    }
+
+    OperatorTimings& operator+=(const OperatorTimings& other) {
+        for (std::size_t p = 0; p < PHASE_COUNT; ++p) {
+            phases[p] += other.phases[p];
+        }
+        return *this;
+    }
+};
+
+/// Clock policies for OperatorTimer
+namespace timing {
+
+/// Measures nothing; timed phases run without any timing code
+struct NoClock {
+    static constexpr bool enabled = false;
+    static constexpr bool counts_nanoseconds = true;
+    static std::uint64_t now() noexcept { return 0; }
+};
+
+/// std::chrono::steady_clock, in nanoseconds
+struct SteadyClock {
+    static constexpr bool enabled = true;
+    static constexpr bool counts_nanoseconds = true;
+    static std::uint64_t now() noexcept {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+    }
+};
+
+#ifdef EVOLAB_HAVE_TSC
+/// Time-stamp counter; OperatorTimer converts its ticks with the rate it measures against
+/// steady_clock, which assumes an invariant TSC (any x86-64 CPU of the last decade)
+struct TscClock {
+    static constexpr bool enabled = true;
+    static constexpr bool counts_nanoseconds = false;
+    static std::uint64_t now() noexcept { return __rdtsc(); }
+};
+#endif
+
+} // namespace timing
+
+#if defined(EVOLAB_NO_OPERATOR_TIMING)
+using OperatorTimingClock = timing::NoClock;
+#elif defined(EVOLAB_HAVE_TSC)
+using OperatorTimingClock = timing::TscClock;
+#else
+using OperatorTimingClock = timing::SteadyClock;
+#endif
+
+namespace detail {
+
+/// Raw counters of one thread, on cache lines of their own
+struct alignas(64) PhaseCounters {
+    std::array<std::uint64_t, PHASE_COUNT> ticks{};
+    std::array<std::size_t, PHASE_COUNT> executions{};
+    std::array<std::size_t, PHASE_COUNT> successes{};
+    std::array<double, PHASE_COUNT> improvement{}; // Summed over executions
+};
+
+/// Per-thread phase counters of a run
+///
+/// Threads time phases through local(thread), where thread is an index below the count given
+/// at construction that no other thread uses at the same time. collect() runs between
+/// generations, when no phase is being timed.
+template <typename Clock = OperatorTimingClock>
+class OperatorTimer {
+  public:
+    /// Timing handle of one thread
+    class Local {
+      public:
+        /// Invoke f(), counting it as one execution of `phase`
+        template <typename F>
+        std::invoke_result_t<F> measure(Phase phase, F&& f) {
+            if constexpr (Clock::enabled) {
+                if (counters_ != nullptr) {
+                    const Stopwatch watch{*counters_, static_cast<std::size_t>(phase),
+                                          Clock::now()};
+                    return std::forward<F>(f)();
+                }
+            }
+            return std::forward<F>(f)();
+        }
+
+        /// Record the fitness gain of the last execution of `phase` (positive = better)
+        void improvement([[maybe_unused]] Phase phase, [[maybe_unused]] double gain) noexcept {
+            if constexpr (Clock::enabled) {
+                if (counters_ != nullptr) {
+                    const auto p = static_cast<std::size_t>(phase);
+                    counters_->improvement[p] += gain;
+                    if (gain > 0.0)
+                        ++counters_->successes[p];
+                }
+            }
+        }
+
+      private:
+        friend class OperatorTimer;
+        explicit Local(PhaseCounters* counters) noexcept : counters_(counters) {}
+
+        struct Stopwatch {
+            PhaseCounters& counters;
+            std::size_t phase;
+            std::uint64_t start;
+            ~Stopwatch() {
+                counters.ticks[phase] += Clock::now() - start;
+                ++counters.executions[phase];
+            }
+        };
+
+        PhaseCounters* counters_; // nullptr when timing is off
+    };
+
+    /// @param threads Number of thread indices local() accepts
+    /// @param enabled Runtime switch (GAConfig::track_operator_performance)
+    OperatorTimer(std::size_t threads, bool enabled)
+        : enabled_(Clock::enabled && enabled), origin_ticks_(Clock::now()),
+          origin_time_(std::chrono::steady_clock::now()) {
+        if (enabled_) {
+            counters_.resize(threads > 0 ? threads : 1);
+        }
+    }
+
+    [[nodiscard]] bool enabled() const noexcept { return enabled_; }
+
+    [[nodiscard]] Local local(std::size_t thread) noexcept {
+        if (!enabled_)
+            return Local(nullptr);
+        assert(thread < counters_.size());
+        return Local(&counters_[thread]);
+    }
+
+    /// Start a new generation's statistics
+    void begin_generation() noexcept { generation_ = {}; }
+
+    /// Move the threads' counters into the generation's and the run's statistics
+    void collect() {
+        if (!enabled_)
+            return;
+
+        double ns_per_tick = 1.0;
+        if constexpr (!Clock::counts_nanoseconds) {
+            // Rate over the whole run so far, which makes it more precise as the run goes on
+            const auto ticks = Clock::now() - origin_ticks_;
+            const auto elapsed = std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - origin_time_);
+            if (ticks > 0)
+                ns_per_tick = elapsed.count() / static_cast<double>(ticks);
+        }
+
+        OperatorTimings collected;
+        for (auto& counters : counters_) {
+            for (std::size_t p = 0; p < PHASE_COUNT; ++p) {
+                if (counters.executions[p] == 0)
+                    continue;
+                OperatorStats stats;
+                stats.executions = counters.executions[p];
+                stats.total_time = std::chrono::nanoseconds(static_cast<std::int64_t>(
+                    static_cast<double>(counters.ticks[p]) * ns_per_tick));
+                stats.successes = counters.successes[p];
+                stats.average_improvement =
+                    counters.improvement[p] / static_cast<double>(counters.executions[p]);
+                collected.phases[p] += stats;
+            }
+            counters = {};
+        }
+        generation_ += collected;
+        totals_ += collected;
+    }
+
+    /// Statistics of the current generation, as of the last collect()
+    [[nodiscard]] const OperatorTimings& generation() const noexcept { return generation_; }
+
+    /// Statistics of all generations collected so far
+    [[nodiscard]] const OperatorTimings& totals() const noexcept { return totals_; }
+
+  private:
+    bool enabled_;
+    std::vector<PhaseCounters> counters_; // One per thread index, empty when disabled
+    OperatorTimings generation_;
+    OperatorTimings totals_;
+    std::uint64_t origin_ticks_;
+    std::chrono::steady_clock::time_point origin_time_;
+};
+
+} // namespace detail
+
+} // namespace evolab::core
@@ -4,11 +4,17 @@
 /// @brief Population class with Structure-of-Arrays layout and PMR support for memory optimization
 ///
 /// This header provides a Population class that separates genome and fitness storage for better
-/// cache efficiency and vectorization support. Uses std::pmr for custom memory allocation
+/// cache efficiency and vectorization support, and MatrixPopulation, which additionally keeps
+/// fixed-length genomes in one contiguous matrix. Uses std::pmr for custom memory allocation
 /// strategies.
 
+#include <algorithm>
+#include <cassert>
 #include <memory_resource>
 #include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <evolab/core/concepts.hpp>
@@ -34,7 +40,8 @@ class Population {
     /// Construct population with specified capacity and optional custom memory resource
     ///
     /// @param capacity Maximum number of individuals to store
-    /// @param resource Custom memory resource for allocation (default: global default)
+    /// @param resource Custom memory resource for the genome and fitness arrays (default:
+    ///        global default); each genome allocates its elements with its own allocator
     explicit Population(std::size_t capacity,
                         std::pmr::memory_resource* resource = std::pmr::get_default_resource())
         : genomes_(std::pmr::polymorphic_allocator<GenomeT>(resource)),
@@ -198,6 +205,15 @@ class Population {
         }
     }
 
+    /// Exchange contents with another population in O(1)
+    ///
+    /// @param other Population using the same memory resource
+    void swap(Population& other) noexcept {
+        assert(get_memory_resource()->is_equal(*other.get_memory_resource()));
+        genomes_.swap(other.genomes_);
+        fitness_.swap(other.fitness_);
+    }
+
     /// Get the memory resource used by this population
     ///
     /// @return Pointer to the memory resource
@@ -208,4 +224,176 @@ class Population {
     // Iterator support removed - use index-based access with size() or spans for batch operations
 };
 
+/// Population of fixed-length genomes stored as one contiguous row-major matrix
+///
+/// Population keeps every genome in its own heap block. For fixed-length genomes such as
+/// permutations, MatrixPopulation stores all of them in a single buffer aligned to a cache
+/// line, genome i occupying row i of genome_length() genes. Batch evaluation and SIMD kernels
+/// can stream the rows, each row range can be first-touched by the thread (and so the NUMA
+/// node) that works on it, and the whole population can be written with a single write.
+///
+/// The capacity is fixed at construction; the buffer is never reallocated.
+///
+/// @tparam Gene Trivially copyable gene type (e.g. int for permutation problems)
+template <typename Gene>
+class MatrixPopulation {
+    static_assert(std::is_trivially_copyable_v<Gene> && std::is_trivially_destructible_v<Gene>,
+                  "MatrixPopulation stores genes as raw rows");
+
+  public:
+    /// Alignment of the gene buffer, one cache line
+    static constexpr std::size_t ALIGNMENT = 64;
+
+  private:
+    std::pmr::memory_resource* resource_;
+    Gene* genes_ = nullptr;
+    std::size_t capacity_;
+    std::size_t genome_length_;
+    std::size_t size_ = 0;
+    std::pmr::vector<Fitness> fitness_;
+
+    std::size_t buffer_bytes() const noexcept { return capacity_ * genome_length_ * sizeof(Gene); }
+
+  public:
+    /// Allocate storage for `capacity` genomes of `genome_length` genes
+    ///
+    /// The gene buffer is not written here, so its pages are placed by whichever threads
+    /// first write each row range.
+    /// @param resource Memory resource for the gene buffer and fitness values
+    MatrixPopulation(std::size_t capacity, std::size_t genome_length,
+                     std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : resource_(resource), capacity_(capacity), genome_length_(genome_length),
+          fitness_(std::pmr::polymorphic_allocator<Fitness>(resource)) {
+        fitness_.reserve(capacity);
+        if (buffer_bytes() > 0) {
+            genes_ = static_cast<Gene*>(resource_->allocate(buffer_bytes(), ALIGNMENT));
+        }
+    }
+
+    ~MatrixPopulation() {
+        if (genes_ != nullptr) {
+            resource_->deallocate(genes_, buffer_bytes(), ALIGNMENT);
+        }
+    }
+
+    MatrixPopulation(const MatrixPopulation&) = delete;
+    MatrixPopulation& operator=(const MatrixPopulation&) = delete;
+
+    MatrixPopulation(MatrixPopulation&& other) noexcept
+        : resource_(other.resource_), genes_(std::exchange(other.genes_, nullptr)),
+          capacity_(std::exchange(other.capacity_, 0)), genome_length_(other.genome_length_),
+          size_(std::exchange(other.size_, 0)), fitness_(std::move(other.fitness_)) {}
+
+    // The buffer belongs to one memory resource; exchange contents with swap() instead
+    MatrixPopulation& operator=(MatrixPopulation&&) = delete;
+
+    /// Maximum number of genomes
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+    /// Current number of genomes
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    /// Number of genes in every genome (the row length)
+    [[nodiscard]] std::size_t genome_length() const noexcept { return genome_length_; }
+
+    /// Append a genome
+    ///
+    /// @throws std::invalid_argument if genome does not have genome_length() genes
+    /// @throws std::length_error if the population is full
+    void push_back(std::span<const Gene> genome, Fitness fitness) {
+        if (genome.size() != genome_length_) {
+            throw std::invalid_argument("MatrixPopulation: genome length mismatch");
+        }
+        if (size_ == capacity_) {
+            throw std::length_error("MatrixPopulation: capacity exceeded");
+        }
+        fitness_.push_back(fitness);
+        std::ranges::copy(genome, genes_ + size_ * genome_length_);
+        ++size_;
+    }
+
+    /// Row of genome `index`
+    [[nodiscard]] std::span<Gene> genome(std::size_t index) noexcept {
+        return {genes_ + index * genome_length_, genome_length_};
+    }
+
+    [[nodiscard]] std::span<const Gene> genome(std::size_t index) const noexcept {
+        return {genes_ + index * genome_length_, genome_length_};
+    }
+
+    [[nodiscard]] Fitness& fitness(std::size_t index) noexcept { return fitness_[index]; }
+
+    [[nodiscard]] const Fitness& fitness(std::size_t index) const noexcept {
+        return fitness_[index];
+    }
+
+    /// All genomes as one row-major span of size() * genome_length() genes
+    [[nodiscard]] std::span<Gene> genome_data() noexcept {
+        return {genes_, size_ * genome_length_};
+    }
+
+    [[nodiscard]] std::span<const Gene> genome_data() const noexcept {
+        return {genes_, size_ * genome_length_};
+    }
+
+    [[nodiscard]] std::span<Fitness> fitness_values() noexcept { return fitness_; }
+
+    [[nodiscard]] std::span<const Fitness> fitness_values() const noexcept { return fitness_; }
+
+    /// Resize to `new_size` genomes
+    ///
+    /// Added rows hold unspecified genes until written, so the threads that fill them also
+    /// place their pages. Added fitness values are default-constructed.
+    /// @throws std::length_error if new_size exceeds the capacity
+    void resize(std::size_t new_size) {
+        if (new_size > capacity_) {
+            throw std::length_error("MatrixPopulation: capacity exceeded");
+        }
+        fitness_.resize(new_size);
+        size_ = new_size;
+    }
+
+    void clear() noexcept {
+        fitness_.clear();
+        size_ = 0;
+    }
+
+    /// Exchange contents with another population in O(1)
+    ///
+    /// @param other Population using the same memory resource
+    void swap(MatrixPopulation& other) noexcept {
+        assert(resource_->is_equal(*other.resource_));
+        std::swap(genes_, other.genes_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(genome_length_, other.genome_length_);
+        std::swap(size_, other.size_);
+        fitness_.swap(other.fitness_);
+    }
+
+    [[nodiscard]] std::pmr::memory_resource* get_memory_resource() const noexcept {
+        return resource_;
+    }
+};
+
+/// Evaluate every genome of a matrix population into its fitness values
+///
+/// Problems with a matrix batch path (MatrixEvaluableProblem) read the rows in place; others
+/// evaluate a copy of each row.
+template <Problem P>
+void evaluate_all(const P& problem, MatrixPopulation<typename P::Gene>& population) {
+    if constexpr (MatrixEvaluableProblem<P>) {
+        problem.evaluate_batch(std::as_const(population).genome_data(),
+                               population.fitness_values());
+    } else {
+        typename P::GenomeT genome;
+        for (std::size_t i = 0; i < population.size(); ++i) {
+            const auto row = population.genome(i);
+            genome.assign(row.begin(), row.end());
+            population.fitness(i) = problem.evaluate(genome);
+        }
+    }
+}
+
 } // namespace evolab::core
@@ -0,0 +1,106 @@
+#pragma once
+
+/// @file rng.hpp
+/// @brief Counter-based random stream derivation for reproducible parallel execution
+///
+/// Parallel operators cannot share a single std::mt19937 without making results depend on
+/// thread scheduling. Instead, every unit of work (e.g. one offspring slot in one generation)
+/// derives its own generator from (seed, stream, index). The derived state depends only on
+/// these counters, so results are bit-identical for any thread count.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace evolab::core {
+
+/// SplitMix64 finalizer (Steele et al.), used to decorrelate counter inputs
+[[nodiscard]] constexpr std::uint64_t splitmix64(std::uint64_t x) noexcept {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+namespace detail {
+
+/// std::seed_seq over four words, without its heap-allocated copy of the input
+///
+/// generate() follows the algorithm the standard specifies for std::seed_seq, so engines
+/// seeded from it are identical to engines seeded from a std::seed_seq of the same words.
+/// Streams are derived once per offspring pair, where an allocation would be measurable.
+class SeedWords {
+    std::array<std::uint32_t, 4> words_;
+
+  public:
+    using result_type = std::uint32_t;
+
+    constexpr explicit SeedWords(const std::array<std::uint32_t, 4>& words) noexcept
+        : words_(words) {}
+
+    static constexpr std::size_t size() noexcept { return 4; }
+
+    template <typename It>
+    constexpr void generate(It begin, It end) const {
+        const std::size_t n = static_cast<std::size_t>(end - begin);
+        if (n == 0)
+            return;
+        for (It it = begin; it != end; ++it) {
+            *it = 0x8b8b8b8bU;
+        }
+
+        const std::size_t s = size();
+        const std::size_t t = n >= 623 ? 11 : n >= 68 ? 7 : n >= 39 ? 5 : n >= 7 ? 3 : (n - 1) / 2;
+        const std::size_t p = (n - t) / 2;
+        const std::size_t q = p + t;
+        const std::size_t m = std::max(s + 1, n);
+        auto at = [&](std::size_t k) -> decltype(*begin) { return begin[k % n]; };
+        auto mix = [](std::uint32_t x) { return x ^ (x >> 27); };
+
+        for (std::size_t k = 0; k < m; ++k) {
+            const std::uint32_t r1 = 1664525U * mix(static_cast<std::uint32_t>(
+                                                    at(k) ^ at(k + p) ^ at(k + n - 1)));
+            std::uint32_t r2 = r1;
+            if (k == 0) {
+                r2 += static_cast<std::uint32_t>(s);
+            } else if (k <= s) {
+                r2 += static_cast<std::uint32_t>(k % n) + words_[k - 1];
+            } else {
+                r2 += static_cast<std::uint32_t>(k % n);
+            }
+            at(k + p) = static_cast<std::uint32_t>(at(k + p) + r1);
+            at(k + q) = static_cast<std::uint32_t>(at(k + q) + r2);
+            at(k) = r2;
+        }
+        for (std::size_t k = m; k < m + n; ++k) {
+            const std::uint32_t r3 = 1566083941U * mix(static_cast<std::uint32_t>(
+                                                       at(k) + at(k + p) + at(k + n - 1)));
+            const std::uint32_t r4 = r3 - static_cast<std::uint32_t>(k % n);
+            at(k + p) = static_cast<std::uint32_t>(at(k + p) ^ r3);
+            at(k + q) = static_cast<std::uint32_t>(at(k + q) ^ r4);
+            at(k) = r4;
+        }
+    }
+};
+
+} // namespace detail
+
+/// Create a generator for work item `index` of stream `stream` under base `seed`
+///
+/// @param seed Base seed of the run (GAConfig::seed)
+/// @param stream Stream identifier, e.g. generation number
+/// @param index Work item within the stream, e.g. offspring slot
+/// @return Independently seeded generator; identical inputs yield identical sequences
+[[nodiscard]] inline std::mt19937 make_stream_rng(std::uint64_t seed, std::uint64_t stream,
+                                                  std::uint64_t index) {
+    const std::uint64_t a = splitmix64(seed ^ splitmix64(stream));
+    const std::uint64_t b = splitmix64(a ^ splitmix64(index + 0x632BE59BD9B4E019ULL));
+    // Same state as std::seed_seq{a_lo, a_hi, b_lo, b_hi}
+    detail::SeedWords seq({static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(a >> 32),
+                           static_cast<std::uint32_t>(b), static_cast<std::uint32_t>(b >> 32)});
+    return std::mt19937(seq);
+}
+
+} // namespace evolab::core
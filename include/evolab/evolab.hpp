@@ -47,9 +47,16 @@
  * @endcode
  */
 
+#include <random>
+#include <variant>
+
 // Core algorithmic components - fundamental concepts and GA implementation
+#include <evolab/core/checkpoint.hpp>
 #include <evolab/core/concepts.hpp>
+#include <evolab/core/edge_frequency.hpp>
 #include <evolab/core/ga.hpp>
+#include <evolab/core/island_model.hpp>
+#include <evolab/core/operator_timing.hpp>
 #include <evolab/core/population.hpp>
 
 // Problem domain implementations - currently focused on combinatorial optimization
@@ -61,6 +68,9 @@
 #include <evolab/operators/selection.hpp>
 
 // Local search algorithms - memetic algorithm components
+#include <evolab/local_search/lin_kernighan.hpp>
+#include <evolab/local_search/or_opt.hpp>
+#include <evolab/local_search/tour.hpp>
 #include <evolab/local_search/two_opt.hpp>
 
 // Adaptive operator scheduling - multi-armed bandit approaches
@@ -69,8 +79,11 @@
 // Performance optimization utilities
 #include <evolab/utils/candidate_list.hpp>
 #include <evolab/utils/numa_allocator.hpp>
+#include <evolab/utils/spsc_ring.hpp>
+#include <evolab/utils/two_level_list.hpp>
 
 // Data I/O and format support
+#include <evolab/io/instance_cache.hpp>
 #include <evolab/io/tsplib.hpp>
 
 // Configuration management and TOML parsing
@@ -144,31 +157,64 @@ inline auto make_tsp_ga_ox_from_config(const config::Config& cfg) {
                          operators::OrderCrossover{}, operators::SwapMutation{});
 }
 
+/// Local search engine selected at runtime from LocalSearchConfig::type
+///
+/// The GA is instantiated once for this type; each improve() call dispatches to the
+/// configured engine through a std::variant, which costs one indirect branch per child.
+class ConfiguredLocalSearch {
+    std::variant<local_search::TwoOpt, local_search::TwoOptOrOpt, local_search::LinKernighan>
+        engine_;
+
+  public:
+    /// @throws config::ConfigValidationError for an unknown type
+    explicit ConfiguredLocalSearch(const config::LocalSearchConfig& cfg)
+        : engine_(make_engine(cfg)) {}
+
+    template <core::Problem P>
+    core::Fitness improve(const P& problem, typename P::GenomeT& genome, std::mt19937& rng) const {
+        return std::visit(
+            [&](const auto& engine) { return engine.improve(problem, genome, rng); }, engine_);
+    }
+
+    /// Index of the active engine in config::LocalSearchConfig::TYPES
+    std::size_t index() const { return engine_.index(); }
+
+  private:
+    static decltype(engine_) make_engine(const config::LocalSearchConfig& cfg) {
+        const int k = static_cast<int>(cfg.candidate_list_size);
+        if (cfg.type == "2-opt") {
+            return local_search::TwoOpt{cfg.first_improvement, cfg.max_iterations};
+        } else if (cfg.type == "or-opt") {
+            return local_search::make_two_opt_or_opt(k, cfg.first_improvement);
+        } else if (cfg.type == "LK") {
+            return local_search::LinKernighan{k};
+        }
+        throw config::ConfigValidationError("Unknown local search type: " + cfg.type);
+    }
+};
+
 /// Create a TSP GA with local search from configuration
 inline auto make_tsp_ga_with_local_search_from_config(const config::Config& cfg) {
     // LIMITATION: Always uses PMX crossover regardless of config.operators.crossover.type
     // This is due to C++'s compile-time template instantiation requirements
     // Use create_tsp_ga_dynamic_from_config for runtime operator selection
-    return core::make_ga(
-        operators::TournamentSelection{cfg.operators.selection.tournament_size},
-        operators::PMXCrossover{}, operators::SwapMutation{},
-        local_search::TwoOpt{cfg.local_search.first_improvement, cfg.local_search.max_iterations});
+    return core::make_ga(operators::TournamentSelection{cfg.operators.selection.tournament_size},
+                         operators::PMXCrossover{}, operators::SwapMutation{},
+                         ConfiguredLocalSearch{cfg.local_search});
 }
 
 /// Create TSP GA with local search, using EAX crossover
 inline auto make_tsp_ga_eax_with_local_search_from_config(const config::Config& cfg) {
-    return core::make_ga(
-        operators::TournamentSelection{cfg.operators.selection.tournament_size},
-        operators::EAXCrossover{}, operators::SwapMutation{},
-        local_search::TwoOpt{cfg.local_search.first_improvement, cfg.local_search.max_iterations});
+    return core::make_ga(operators::TournamentSelection{cfg.operators.selection.tournament_size},
+                         operators::EAXCrossover{}, operators::SwapMutation{},
+                         ConfiguredLocalSearch{cfg.local_search});
 }
 
 /// Create TSP GA with local search, using OX crossover
 inline auto make_tsp_ga_ox_with_local_search_from_config(const config::Config& cfg) {
-    return core::make_ga(
-        operators::TournamentSelection{cfg.operators.selection.tournament_size},
-        operators::OrderCrossover{}, operators::SwapMutation{},
-        local_search::TwoOpt{cfg.local_search.first_improvement, cfg.local_search.max_iterations});
+    return core::make_ga(operators::TournamentSelection{cfg.operators.selection.tournament_size},
+                         operators::OrderCrossover{}, operators::SwapMutation{},
+                         ConfiguredLocalSearch{cfg.local_search});
 }
 
 /// Create UCB scheduler from configuration for a specific problem type
@@ -0,0 +1,339 @@
+#pragma once
+
+/// @file instance_cache.hpp
+/// @brief Versioned binary cache of a prepared TSP instance
+///
+/// Parsing a TSPLIB file and building its distance matrix is repeated on every launch,
+/// although the result only depends on the file contents. The cache stores the prepared
+/// instance in a flat binary file that is memory-mapped on load, so the distance matrix is
+/// used in place (see problems::TSP::from_cache) and startup costs one mmap.
+///
+/// Layout (native byte order, checked on load): a 128-byte header followed by the sections
+/// name, comment, node coordinates (n × 3 doubles), distance matrix and candidate lists
+/// (n × k ints), each starting at a 64-byte aligned offset.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <evolab/io/mapped_file.hpp>
+#include <evolab/io/tsplib.hpp>
+
+namespace evolab::io {
+
+/// Format version; bumped whenever the layout changes so stale caches are rejected
+inline constexpr std::uint32_t INSTANCE_CACHE_VERSION = 1;
+
+/// Thrown when a cache file is truncated, from another version or otherwise malformed
+class InstanceCacheError : public std::runtime_error {
+  public:
+    explicit InstanceCacheError(const std::string& message)
+        : std::runtime_error("Instance cache error: " + message) {}
+};
+
+/// Element type of the cached distance matrix
+enum class CacheElementType : std::uint8_t {
+    None = 0, ///< No matrix: distances are computed from the coordinates
+    Float64 = 1,
+    Float32 = 2,
+    Int32 = 3
+};
+
+/// Layout of the cached distance matrix
+enum class CacheMatrixLayout : std::uint8_t {
+    Full = 0,      ///< Row-major n×n
+    Triangular = 1 ///< Packed strict upper triangle, row-wise
+};
+
+/// 64-bit FNV-1a hash, used to key caches by the contents of their source file
+[[nodiscard]] constexpr std::uint64_t content_hash(std::span<const std::byte> bytes) noexcept {
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    for (std::byte b : bytes) {
+        hash ^= static_cast<std::uint64_t>(b);
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/// Content hash of a file
+/// @throws std::system_error if the file cannot be read
+[[nodiscard]] inline std::uint64_t hash_file(const std::string& path) {
+    return content_hash(MappedFile(path).bytes());
+}
+
+/// Everything written to a cache file; spans must stay valid during write_instance_cache
+struct InstanceCacheContents {
+    std::uint64_t source_hash = 0;
+    std::string_view name;
+    std::string_view comment;
+    TSPType type = TSPType::TSP;
+    EdgeWeightType edge_weight_type = EdgeWeightType::EUC_2D;
+    int dimension = 0;
+    std::span<const std::array<double, 3>> node_coords; // Empty or dimension entries
+
+    CacheElementType element_type = CacheElementType::None;
+    CacheMatrixLayout layout = CacheMatrixLayout::Full;
+    std::span<const std::byte> matrix;
+
+    int candidate_k = 0;            // 0 when no candidate lists are stored
+    std::span<const int> candidates; // dimension × candidate_k, row-major
+};
+
+namespace detail {
+
+inline constexpr std::array<char, 8> CACHE_MAGIC{'E', 'V', 'O', 'L', 'A', 'B', 'I', 'C'};
+inline constexpr std::uint32_t CACHE_BYTE_ORDER_MARK = 0x01020304;
+inline constexpr std::size_t CACHE_ALIGNMENT = 64;
+
+struct CacheSection {
+    std::uint64_t offset;
+    std::uint64_t bytes;
+};
+
+struct CacheHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t source_hash;
+    std::int32_t dimension;
+    std::int32_t candidate_k;
+    std::uint8_t type;
+    std::uint8_t edge_weight_type;
+    std::uint8_t element_type;
+    std::uint8_t layout;
+    std::array<std::uint32_t, 3> reserved;
+    CacheSection name;
+    CacheSection comment;
+    CacheSection coords;
+    CacheSection matrix;
+    CacheSection candidates;
+};
+static_assert(sizeof(CacheHeader) == 128, "Cache header layout must not change silently");
+
+constexpr std::size_t cache_element_size(CacheElementType type) noexcept {
+    switch (type) {
+    case CacheElementType::Float64:
+        return sizeof(double);
+    case CacheElementType::Float32:
+        return sizeof(float);
+    case CacheElementType::Int32:
+        return sizeof(std::int32_t);
+    default:
+        return 0;
+    }
+}
+
+/// Matrix size in bytes implied by the header fields
+constexpr std::uint64_t expected_matrix_bytes(CacheElementType type, CacheMatrixLayout layout,
+                                              std::int32_t n) noexcept {
+    const auto cells = static_cast<std::uint64_t>(n);
+    const std::uint64_t count =
+        layout == CacheMatrixLayout::Full ? cells * cells : (n > 1 ? cells * (cells - 1) / 2 : 0);
+    return count * cache_element_size(type);
+}
+
+} // namespace detail
+
+/// Write a cache file
+///
+/// The file is written under a temporary name and renamed into place, so concurrent
+/// readers and writers of the same path only ever see complete caches.
+/// @throws std::invalid_argument if the section sizes are inconsistent
+/// @throws std::system_error if the file cannot be written
+inline void write_instance_cache(const std::string& path, const InstanceCacheContents& contents) {
+    const auto n = static_cast<std::size_t>(std::max(contents.dimension, 0));
+    if (!contents.node_coords.empty() && contents.node_coords.size() != n) {
+        throw std::invalid_argument("Cached coordinates must cover every node");
+    }
+    if (contents.matrix.size() != detail::expected_matrix_bytes(contents.element_type,
+                                                                contents.layout,
+                                                                contents.dimension)) {
+        throw std::invalid_argument("Cached matrix size does not match its element type");
+    }
+    if (contents.candidates.size() !=
+        n * static_cast<std::size_t>(std::max(contents.candidate_k, 0))) {
+        throw std::invalid_argument("Cached candidate lists must hold k entries per node");
+    }
+
+    detail::CacheHeader header{};
+    header.magic = detail::CACHE_MAGIC;
+    header.version = INSTANCE_CACHE_VERSION;
+    header.byte_order = detail::CACHE_BYTE_ORDER_MARK;
+    header.source_hash = contents.source_hash;
+    header.dimension = contents.dimension;
+    header.candidate_k = contents.candidate_k;
+    header.type = static_cast<std::uint8_t>(contents.type);
+    header.edge_weight_type = static_cast<std::uint8_t>(contents.edge_weight_type);
+    header.element_type = static_cast<std::uint8_t>(contents.element_type);
+    header.layout = static_cast<std::uint8_t>(contents.layout);
+
+    const std::span<const std::byte> payloads[] = {
+        std::as_bytes(std::span(contents.name)), std::as_bytes(std::span(contents.comment)),
+        std::as_bytes(contents.node_coords), contents.matrix, std::as_bytes(contents.candidates)};
+    detail::CacheSection* sections[] = {&header.name, &header.comment, &header.coords,
+                                        &header.matrix, &header.candidates};
+    std::uint64_t offset = sizeof(detail::CacheHeader);
+    for (std::size_t s = 0; s < std::size(payloads); ++s) {
+        offset = (offset + detail::CACHE_ALIGNMENT - 1) / detail::CACHE_ALIGNMENT *
+                 detail::CACHE_ALIGNMENT;
+        *sections[s] = {offset, payloads[s].size()};
+        offset += payloads[s].size();
+    }
+
+    const std::string temporary =
+        path + ".tmp" + std::to_string(std::random_device{}() & 0xFFFFFFu);
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::system_error(std::make_error_code(std::errc::io_error),
+                                    "Cannot create " + temporary);
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::uint64_t position = sizeof(header);
+        const char padding[detail::CACHE_ALIGNMENT] = {};
+        for (std::size_t s = 0; s < std::size(payloads); ++s) {
+            file.write(padding, static_cast<std::streamsize>(sections[s]->offset - position));
+            file.write(reinterpret_cast<const char*>(payloads[s].data()),
+                       static_cast<std::streamsize>(payloads[s].size()));
+            position = sections[s]->offset + payloads[s].size();
+        }
+        if (!file.flush()) {
+            file.close();
+            std::filesystem::remove(temporary);
+            throw std::system_error(std::make_error_code(std::errc::io_error),
+                                    "Cannot write " + temporary);
+        }
+    }
+    std::filesystem::rename(temporary, path);
+}
+
+/// Memory-mapped cache file
+///
+/// Accessors return views into the mapping; keep_alive() hands out shared ownership of it so
+/// that distance back-ends built on the views can outlive this object.
+class InstanceCache {
+    std::shared_ptr<const MappedFile> file_;
+    detail::CacheHeader header_{};
+
+    template <typename T>
+    std::span<const T> section(const detail::CacheSection& s) const noexcept {
+        return {reinterpret_cast<const T*>(file_->bytes().data() + s.offset),
+                static_cast<std::size_t>(s.bytes / sizeof(T))};
+    }
+
+  public:
+    /// Map and validate a cache file
+    /// @throws std::system_error if the file cannot be opened
+    /// @throws InstanceCacheError if it is not a valid cache of this version
+    explicit InstanceCache(const std::string& path)
+        : file_(std::make_shared<const MappedFile>(path)) {
+        const auto bytes = file_->bytes();
+        if (bytes.size() < sizeof(detail::CacheHeader)) {
+            throw InstanceCacheError(path + " is truncated");
+        }
+        std::memcpy(&header_, bytes.data(), sizeof(header_));
+        if (header_.magic != detail::CACHE_MAGIC) {
+            throw InstanceCacheError(path + " is not an instance cache");
+        }
+        if (header_.version != INSTANCE_CACHE_VERSION) {
+            throw InstanceCacheError(path + " has version " + std::to_string(header_.version) +
+                                     ", expected " + std::to_string(INSTANCE_CACHE_VERSION));
+        }
+        if (header_.byte_order != detail::CACHE_BYTE_ORDER_MARK) {
+            throw InstanceCacheError(path + " was written with a different byte order");
+        }
+
+        const auto n = static_cast<std::uint64_t>(std::max(header_.dimension, 0));
+        const auto element = static_cast<CacheElementType>(header_.element_type);
+        const bool valid_sizes =
+            header_.dimension > 0 && header_.candidate_k >= 0 &&
+            header_.candidate_k <= header_.dimension - 1 &&
+            header_.element_type <= static_cast<std::uint8_t>(CacheElementType::Int32) &&
+            header_.layout <= static_cast<std::uint8_t>(CacheMatrixLayout::Triangular) &&
+            (header_.coords.bytes == 0 ||
+             header_.coords.bytes == n * sizeof(std::array<double, 3>)) &&
+            header_.matrix.bytes ==
+                detail::expected_matrix_bytes(element, layout(), header_.dimension) &&
+            header_.candidates.bytes ==
+                n * static_cast<std::uint64_t>(header_.candidate_k) * sizeof(int);
+        if (!valid_sizes) {
+            throw InstanceCacheError(path + " has an inconsistent header");
+        }
+        for (const auto& s : {header_.name, header_.comment, header_.coords, header_.matrix,
+                              header_.candidates}) {
+            if (s.offset % detail::CACHE_ALIGNMENT != 0 || s.offset > bytes.size() ||
+                s.bytes > bytes.size() - s.offset) {
+                throw InstanceCacheError(path + " is truncated");
+            }
+        }
+    }
+
+    [[nodiscard]] std::uint64_t source_hash() const noexcept { return header_.source_hash; }
+    [[nodiscard]] int dimension() const noexcept { return header_.dimension; }
+    [[nodiscard]] TSPType type() const noexcept { return static_cast<TSPType>(header_.type); }
+    [[nodiscard]] EdgeWeightType edge_weight_type() const noexcept {
+        return static_cast<EdgeWeightType>(header_.edge_weight_type);
+    }
+    [[nodiscard]] CacheElementType element_type() const noexcept {
+        return static_cast<CacheElementType>(header_.element_type);
+    }
+    [[nodiscard]] CacheMatrixLayout layout() const noexcept {
+        return static_cast<CacheMatrixLayout>(header_.layout);
+    }
+
+    [[nodiscard]] std::string_view name() const noexcept {
+        const auto chars = section<char>(header_.name);
+        return {chars.data(), chars.size()};
+    }
+    [[nodiscard]] std::string_view comment() const noexcept {
+        const auto chars = section<char>(header_.comment);
+        return {chars.data(), chars.size()};
+    }
+    [[nodiscard]] std::span<const std::array<double, 3>> node_coords() const noexcept {
+        return section<std::array<double, 3>>(header_.coords);
+    }
+
+    /// Cached matrix entries; T must match element_type()
+    template <typename T>
+    [[nodiscard]] std::span<const T> matrix() const {
+        if (detail::cache_element_size(element_type()) != sizeof(T)) {
+            throw InstanceCacheError("Requested matrix type does not match the cache");
+        }
+        return section<T>(header_.matrix);
+    }
+
+    /// Candidate lists (dimension × candidate_k(), row-major); empty if none were stored
+    [[nodiscard]] int candidate_k() const noexcept { return header_.candidate_k; }
+    [[nodiscard]] std::span<const int> candidates() const noexcept {
+        return section<int>(header_.candidates);
+    }
+
+    /// Instance metadata and coordinates (explicit edge weights are not retained)
+    [[nodiscard]] TSPInstance instance() const {
+        TSPInstance instance;
+        instance.name = name();
+        instance.comment = comment();
+        instance.type = type();
+        instance.dimension = dimension();
+        instance.edge_weight_type = edge_weight_type();
+        const auto coords = node_coords();
+        instance.node_coords.assign(coords.begin(), coords.end());
+        return instance;
+    }
+
+    /// Shared ownership of the mapping, for views that outlive this object
+    [[nodiscard]] std::shared_ptr<const void> keep_alive() const noexcept { return file_; }
+};
+
+} // namespace evolab::io
@@ -0,0 +1,97 @@
+#pragma once
+
+/// @file mapped_file.hpp
+/// @brief Read-only memory-mapped files
+///
+/// On POSIX systems the file is mapped with mmap, so pages are loaded on first access and
+/// shared between processes through the page cache. Elsewhere the file is read into a heap
+/// buffer, which keeps the same interface at the cost of one copy.
+
+#include <cerrno>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define EVOLAB_HAVE_MMAP 1
+#endif
+
+namespace evolab::io {
+
+/// Read-only view of a whole file, valid for the lifetime of the object
+class MappedFile {
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifndef EVOLAB_HAVE_MMAP
+    std::unique_ptr<std::byte[]> buffer_;
+#endif
+
+  public:
+    /// Map the file at path
+    /// @throws std::system_error if the file cannot be opened or mapped
+    explicit MappedFile(const std::string& path) {
+#ifdef EVOLAB_HAVE_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Cannot stat " + path);
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ > 0) {
+            void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "Cannot map " + path);
+            }
+            data_ = static_cast<const std::byte*>(mapping);
+        }
+        // The mapping stays valid after the descriptor is closed
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory),
+                                    "Cannot open " + path);
+        }
+        size_ = static_cast<std::size_t>(file.tellg());
+        buffer_ = std::make_unique<std::byte[]>(size_);
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(buffer_.get()),
+                       static_cast<std::streamsize>(size_))) {
+            throw std::system_error(std::make_error_code(std::errc::io_error),
+                                    "Cannot read " + path);
+        }
+        data_ = buffer_.get();
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef EVOLAB_HAVE_MMAP
+        if (data_ != nullptr) {
+            ::munmap(const_cast<std::byte*>(data_), size_);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// File contents; the data is page-aligned when memory-mapped
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return {data_, size_}; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+};
+
+} // namespace evolab::io
@@ -2,17 +2,23 @@
 
 #include <algorithm>
 #include <array>
-#include <cctype>
 #include <charconv>
 #include <cmath>
+#include <cstddef>
 #include <fstream>
+#include <iterator>
 #include <numbers>
-#include <sstream>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <unordered_map>
 #include <vector>
 
+#include <evolab/io/mapped_file.hpp>
+#include <evolab/utils/matrix_build.hpp>
+
 namespace evolab::io {
 
 // Custom exception types for TSPLIB parsing
@@ -150,11 +156,65 @@ struct TSPInstance {
     std::vector<double> get_full_distance_matrix() const;
 };
 
+namespace detail {
+
+/// Line-by-line access to an in-memory TSPLIB text, with std::getline semantics
+class TextCursor {
+    std::string_view text_;
+    std::size_t pos_ = 0;
+
+  public:
+    explicit TextCursor(std::string_view text) noexcept : text_(text) {}
+
+    /// Read the next line without its '\n'; false once the text is exhausted
+    bool next_line(std::string_view& line) noexcept {
+        if (pos_ >= text_.size()) {
+            return false;
+        }
+        const std::size_t newline = text_.find('\n', pos_);
+        const std::size_t stop = newline == std::string_view::npos ? text_.size() : newline;
+        line = text_.substr(pos_, stop - pos_);
+        pos_ = newline == std::string_view::npos ? text_.size() : newline + 1;
+        return true;
+    }
+
+    /// Offset of the next unread line
+    std::size_t position() const noexcept { return pos_; }
+    void seek(std::size_t position) noexcept { pos_ = position; }
+    std::string_view text() const noexcept { return text_; }
+};
+
+/// Whitespace as accepted by std::strtod
+constexpr bool is_blank(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+/// Parse one number after optional blanks, accepting what std::strtod accepts for TSPLIB
+/// data (including a leading '+'); returns nullptr if no number starts at p
+inline const char* parse_number(const char* p, const char* end, double& value) noexcept {
+    while (p < end && is_blank(*p)) {
+        ++p;
+    }
+    if (p < end && *p == '+' && p + 1 < end && p[1] != '-') {
+        ++p;
+    }
+    const auto [ptr, ec] = std::from_chars(p, end, value);
+    return ec == std::errc() ? ptr : nullptr;
+}
+
+} // namespace detail
+
 class TSPLIBParser {
   public:
+    /// Weight sections with at least this many values are tokenized in parallel chunks
+    static constexpr std::size_t PARALLEL_PARSE_MIN_VALUES = std::size_t{1} << 20;
+
+    /// Parse a TSPLIB file; the file is memory-mapped rather than streamed
     static TSPInstance parse_file(const std::string& filename);
     static TSPInstance parse_string(const std::string& content);
     static TSPInstance parse_stream(std::istream& stream);
+    /// Parse TSPLIB text held in memory; all other entry points forward here
+    static TSPInstance parse_text(std::string_view text);
 
     static void write_tour_file(const std::string& filename, const std::string& problem_name,
                                 const std::vector<int>& tour, double tour_length = -1.0);
@@ -164,14 +224,19 @@ class TSPLIBParser {
     static EdgeWeightFormat parse_edge_weight_format(const std::string& format_str);
     static TSPType parse_tsp_type(const std::string& type_str);
 
-    static void parse_header(const std::string& line, TSPInstance& instance);
-    static void parse_node_coord_section(std::istream& stream, TSPInstance& instance);
-    static void parse_display_data_section(std::istream& stream, TSPInstance& instance);
-    static void parse_edge_weight_section(std::istream& stream, TSPInstance& instance);
+    static void parse_header(std::string_view line, TSPInstance& instance);
+    static void parse_node_coord_section(detail::TextCursor& cursor, TSPInstance& instance);
+    static void parse_display_data_section(detail::TextCursor& cursor, TSPInstance& instance);
+    static void parse_edge_weight_section(detail::TextCursor& cursor, TSPInstance& instance);
+
+    static std::size_t parse_weights_serial(detail::TextCursor& cursor, double* out,
+                                            std::size_t expected_size);
+    static bool parse_weights_parallel(detail::TextCursor& cursor, double* out,
+                                       std::size_t expected_size);
 
-    static bool line_starts_with(const std::string& line, const std::string& keyword);
+    static bool line_starts_with(std::string_view line, std::string_view keyword);
 
-    static void parse_coord_section(std::istream& stream, TSPInstance& instance,
+    static void parse_coord_section(detail::TextCursor& cursor, TSPInstance& instance,
                                     std::vector<std::array<double, 3>>& coords,
                                     const std::string& section_name);
 };
@@ -300,37 +365,119 @@ inline double TSPInstance::calculate_distance(int i, int j) const {
 }
 
 inline std::vector<double> TSPInstance::get_full_distance_matrix() const {
-    std::vector<double> matrix(dimension * dimension);
+    const int n = dimension;
+    std::vector<double> matrix(static_cast<std::size_t>(std::max(n, 0)) *
+                               static_cast<std::size_t>(std::max(n, 0)));
+
+    // Coordinate metrics are symmetric: dispatch on the metric once and compute each pair once
+    auto fill_symmetric = [&](auto metric) {
+        auto fill_segment = [&](int i, int j_begin, int j_end, double* out) {
+            const auto& a = node_coords[i];
+            for (int j = j_begin; j < j_end; ++j) {
+                out[j - j_begin] = i == j ? 0.0 : metric(a, node_coords[j]);
+            }
+        };
+        utils::fill_symmetric_matrix(matrix.data(), n, fill_segment);
+    };
+    using Coord = std::array<double, 3>;
 
-    for (int i = 0; i < dimension; ++i) {
-        for (int j = 0; j < dimension; ++j) {
-            matrix[i * dimension + j] = calculate_distance(i, j);
+    if (n > 1 && edge_weight_type != EdgeWeightType::EXPLICIT) {
+        if (node_coords.empty()) {
+            throw TSPLIBDataError("No coordinate data available for distance calculation");
+        }
+        if (node_coords.size() < static_cast<std::size_t>(n)) {
+            throw TSPLIBDataError("Expected " + std::to_string(n) + " node coordinates but got " +
+                                  std::to_string(node_coords.size()));
+        }
+        switch (edge_weight_type) {
+        case EdgeWeightType::EUC_2D:
+            fill_symmetric([](const Coord& a, const Coord& b) {
+                return tsp_distance::euclidean_2d(a[0], a[1], b[0], b[1]);
+            });
+            return matrix;
+        case EdgeWeightType::EUC_3D:
+            fill_symmetric([](const Coord& a, const Coord& b) {
+                return tsp_distance::euclidean_3d(a[0], a[1], a[2], b[0], b[1], b[2]);
+            });
+            return matrix;
+        case EdgeWeightType::CEIL_2D:
+            fill_symmetric([](const Coord& a, const Coord& b) {
+                return std::ceil(tsp_distance::euclidean_2d_raw(a[0], a[1], b[0], b[1]));
+            });
+            return matrix;
+        case EdgeWeightType::MAN_2D:
+            fill_symmetric([](const Coord& a, const Coord& b) {
+                return tsp_distance::manhattan_2d(a[0], a[1], b[0], b[1]);
+            });
+            return matrix;
+        case EdgeWeightType::MAN_3D:
+            fill_symmetric([](const Coord& a, const Coord& b) {
+                return tsp_distance::manhattan_3d(a[0], a[1], a[2], b[0], b[1], b[2]);
+            });
+            return matrix;
+        case EdgeWeightType::MAX_2D:
+            fill_symmetric([](const Coord& a, const Coord& b) {
+                return tsp_distance::maximum_2d(a[0], a[1], b[0], b[1]);
+            });
+            return matrix;
+        case EdgeWeightType::MAX_3D:
+            fill_symmetric([](const Coord& a, const Coord& b) {
+                return tsp_distance::maximum_3d(a[0], a[1], a[2], b[0], b[1], b[2]);
+            });
+            return matrix;
+        case EdgeWeightType::GEO:
+            fill_symmetric([](const Coord& a, const Coord& b) {
+                return tsp_distance::geographical(a[0], a[1], b[0], b[1]);
+            });
+            return matrix;
+        case EdgeWeightType::ATT:
+            fill_symmetric([](const Coord& a, const Coord& b) {
+                return tsp_distance::att_distance(a[0], a[1], b[0], b[1]);
+            });
+            return matrix;
+        default:
+            break; // calculate_distance reports unsupported types
         }
     }
 
+    utils::for_each_matrix_row(n, [&](int i) {
+        double* row = matrix.data() + static_cast<std::size_t>(i) * n;
+        for (int j = 0; j < n; ++j) {
+            row[j] = calculate_distance(i, j);
+        }
+    });
     return matrix;
 }
 
 inline TSPInstance TSPLIBParser::parse_file(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file) {
+    std::optional<MappedFile> file;
+    try {
+        file.emplace(filename);
+    } catch (const std::system_error&) {
         throw TSPLIBFileError(filename);
     }
 
-    return parse_stream(file);
+    const auto bytes = file->bytes();
+    return parse_text(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
 }
 
 inline TSPInstance TSPLIBParser::parse_string(const std::string& content) {
-    std::istringstream stream(content);
-    return parse_stream(stream);
+    return parse_text(content);
 }
 
 inline TSPInstance TSPLIBParser::parse_stream(std::istream& stream) {
+    const std::string content{std::istreambuf_iterator<char>(stream),
+                              std::istreambuf_iterator<char>()};
+    return parse_text(content);
+}
+
+inline TSPInstance TSPLIBParser::parse_text(std::string_view text) {
     TSPInstance instance;
-    std::string line;
+    detail::TextCursor cursor(text);
+    std::string_view line;
 
     // Parse header
-    while (std::getline(stream, line)) {
+    while (cursor.next_line(line)) {
         if (line_starts_with(line, "NODE_COORD_SECTION") ||
             line_starts_with(line, "DISPLAY_DATA_SECTION") ||
             line_starts_with(line, "EDGE_WEIGHT_SECTION")) {
@@ -349,13 +496,13 @@ inline TSPInstance TSPLIBParser::parse_stream(std::istream& stream) {
     // Parse sections
     do {
         if (line_starts_with(line, "NODE_COORD_SECTION")) {
-            parse_node_coord_section(stream, instance);
+            parse_node_coord_section(cursor, instance);
         } else if (line_starts_with(line, "DISPLAY_DATA_SECTION")) {
-            parse_display_data_section(stream, instance);
+            parse_display_data_section(cursor, instance);
         } else if (line_starts_with(line, "EDGE_WEIGHT_SECTION")) {
-            parse_edge_weight_section(stream, instance);
+            parse_edge_weight_section(cursor, instance);
         }
-    } while (std::getline(stream, line) && !line_starts_with(line, "EOF"));
+    } while (cursor.next_line(line) && !line_starts_with(line, "EOF"));
 
     return instance;
 }
@@ -433,13 +580,13 @@ inline TSPType TSPLIBParser::parse_tsp_type(const std::string& type_str) {
     return it->second;
 }
 
-inline void TSPLIBParser::parse_header(const std::string& line, TSPInstance& instance) {
+inline void TSPLIBParser::parse_header(std::string_view line, TSPInstance& instance) {
     size_t colon_pos = line.find(':');
-    if (colon_pos == std::string::npos)
+    if (colon_pos == std::string_view::npos)
         return;
 
-    std::string key = line.substr(0, colon_pos);
-    std::string value = line.substr(colon_pos + 1);
+    std::string key(line.substr(0, colon_pos));
+    std::string value(line.substr(colon_pos + 1));
 
     // Trim whitespace from key and value
     key.erase(0, key.find_first_not_of(" \t"));
@@ -469,118 +616,215 @@ inline void TSPLIBParser::parse_header(const std::string& line, TSPInstance& ins
     }
 }
 
-inline void TSPLIBParser::parse_node_coord_section(std::istream& stream, TSPInstance& instance) {
-    parse_coord_section(stream, instance, instance.node_coords, "node");
+inline void TSPLIBParser::parse_node_coord_section(detail::TextCursor& cursor,
+                                                   TSPInstance& instance) {
+    parse_coord_section(cursor, instance, instance.node_coords, "node");
 }
 
-inline void TSPLIBParser::parse_display_data_section(std::istream& stream, TSPInstance& instance) {
-    parse_coord_section(stream, instance, instance.display_coords, "display");
+inline void TSPLIBParser::parse_display_data_section(detail::TextCursor& cursor,
+                                                     TSPInstance& instance) {
+    parse_coord_section(cursor, instance, instance.display_coords, "display");
 }
 
-inline void TSPLIBParser::parse_edge_weight_section(std::istream& stream, TSPInstance& instance) {
+inline void TSPLIBParser::parse_edge_weight_section(detail::TextCursor& cursor,
+                                                    TSPInstance& instance) {
+    const auto n = static_cast<std::size_t>(instance.dimension);
     size_t expected_size = 0;
 
     switch (instance.edge_weight_format) {
     case EdgeWeightFormat::FULL_MATRIX:
-        expected_size = instance.dimension * instance.dimension;
+        expected_size = n * n;
         break;
     case EdgeWeightFormat::UPPER_ROW:
     case EdgeWeightFormat::LOWER_ROW:
-        expected_size = (instance.dimension * (instance.dimension - 1)) / 2;
+        expected_size = (n * (n - 1)) / 2;
         break;
     case EdgeWeightFormat::UPPER_DIAG_ROW:
     case EdgeWeightFormat::LOWER_DIAG_ROW:
     case EdgeWeightFormat::UPPER_DIAG_COL:
     case EdgeWeightFormat::LOWER_DIAG_COL:
-        expected_size = (instance.dimension * (instance.dimension + 1)) / 2;
+        expected_size = (n * (n + 1)) / 2;
         break;
     case EdgeWeightFormat::UPPER_COL:
     case EdgeWeightFormat::LOWER_COL:
-        expected_size = (instance.dimension * (instance.dimension - 1)) / 2;
+        expected_size = (n * (n - 1)) / 2;
         break;
     default:
         throw TSPLIBFormatError("Unsupported edge weight format for parsing");
     }
 
-    instance.distance_matrix.reserve(expected_size);
+    // Values are written in place; no per-line strings or push_back growth
+    instance.distance_matrix.resize(expected_size);
+    std::size_t parsed = 0;
+#ifdef EVOLAB_HAVE_TBB
+    if (expected_size >= PARALLEL_PARSE_MIN_VALUES &&
+        parse_weights_parallel(cursor, instance.distance_matrix.data(), expected_size)) {
+        parsed = expected_size;
+    }
+#endif
+    if (parsed == 0) {
+        parsed = parse_weights_serial(cursor, instance.distance_matrix.data(), expected_size);
+    }
 
-    std::string line;
-    while (std::getline(stream, line) && instance.distance_matrix.size() < expected_size) {
+    if (parsed != expected_size) {
+        instance.distance_matrix.resize(parsed);
+        throw TSPLIBDataError("Distance matrix size mismatch: expected " +
+                              std::to_string(expected_size) + " but got " +
+                              std::to_string(parsed));
+    }
+}
+
+/// Read weights line by line until expected_size values are parsed, an empty or EOF line is
+/// reached, or the text ends; a malformed value ends its line. Returns the number parsed.
+inline std::size_t TSPLIBParser::parse_weights_serial(detail::TextCursor& cursor, double* out,
+                                                      std::size_t expected_size) {
+    std::size_t parsed = 0;
+    std::string_view line;
+    while (parsed < expected_size && cursor.next_line(line)) {
         if (line.empty() || line_starts_with(line, "EOF"))
             break;
 
-        // Parse doubles using high-performance char buffer parsing
         const char* p = line.data();
         const char* const end = p + line.size();
-        char* endptr;
-
-        while (p < end && instance.distance_matrix.size() < expected_size) {
-            double distance = std::strtod(p, &endptr);
-            if (p == endptr)
+        while (parsed < expected_size) {
+            double distance;
+            const char* next = detail::parse_number(p, end, distance);
+            if (next == nullptr)
                 break;
-            instance.distance_matrix.push_back(distance);
-            p = endptr;
+            out[parsed++] = distance;
+            p = next;
         }
     }
+    return parsed;
+}
 
-    if (instance.distance_matrix.size() != expected_size) {
-        throw TSPLIBDataError("Distance matrix size mismatch: expected " +
-                              std::to_string(expected_size) + " but got " +
-                              std::to_string(instance.distance_matrix.size()));
+/// Parse a large weight section in parallel chunks
+///
+/// The section extends up to the first empty line or line starting with a keyword. It is
+/// split at whitespace into chunks; a first pass counts the values per chunk, which gives
+/// every chunk its output offset, and a second pass parses the chunks independently.
+/// Returns false without consuming input unless the section holds exactly expected_size
+/// well-formed values, leaving anything unusual to parse_weights_serial.
+inline bool TSPLIBParser::parse_weights_parallel(detail::TextCursor& cursor, double* out,
+                                                 std::size_t expected_size) {
+    const std::string_view text = cursor.text();
+    const std::size_t begin = cursor.position();
+
+    auto starts_value = [](char c) {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.';
+    };
+    std::size_t section_end = begin;
+    while (section_end < text.size()) {
+        const std::size_t newline = text.find('\n', section_end);
+        const std::size_t line_end = newline == std::string_view::npos ? text.size() : newline;
+        std::size_t first = section_end;
+        while (first < line_end && detail::is_blank(text[first])) {
+            ++first;
+        }
+        if (line_end == section_end || (first < line_end && !starts_value(text[first]))) {
+            break;
+        }
+        section_end = newline == std::string_view::npos ? text.size() : newline + 1;
     }
+
+    // Chunk boundaries, moved forward to whitespace so that no value straddles two chunks
+    constexpr std::size_t CHUNK_BYTES = std::size_t{1} << 20;
+    std::vector<std::size_t> bounds{begin};
+    for (std::size_t pos = begin + CHUNK_BYTES; pos < section_end; pos += CHUNK_BYTES) {
+        while (pos < section_end && !detail::is_blank(text[pos])) {
+            ++pos;
+        }
+        if (pos > bounds.back() && pos < section_end) {
+            bounds.push_back(pos);
+        }
+    }
+    bounds.push_back(section_end);
+    const int chunks = static_cast<int>(bounds.size() - 1);
+
+    std::vector<std::size_t> offsets(bounds.size(), 0);
+    utils::detail::for_each_index(chunks, true, 1, [&](int c) {
+        std::size_t count = 0;
+        bool in_value = false;
+        for (std::size_t pos = bounds[c]; pos < bounds[c + 1]; ++pos) {
+            const bool blank = detail::is_blank(text[pos]);
+            count += !blank && !in_value;
+            in_value = !blank;
+        }
+        offsets[c + 1] = count;
+    });
+    for (int c = 0; c < chunks; ++c) {
+        offsets[c + 1] += offsets[c];
+    }
+    if (offsets.back() != expected_size) {
+        return false;
+    }
+
+    std::vector<char> failed(static_cast<std::size_t>(chunks), 0);
+    utils::detail::for_each_index(chunks, true, 1, [&](int c) {
+        const char* p = text.data() + bounds[c];
+        const char* const end = text.data() + bounds[c + 1];
+        for (std::size_t index = offsets[c]; index < offsets[c + 1]; ++index) {
+            const char* next = detail::parse_number(p, end, out[index]);
+            if (next == nullptr || (next < end && !detail::is_blank(*next))) {
+                failed[c] = 1;
+                return;
+            }
+            p = next;
+        }
+    });
+    if (std::ranges::find(failed, 1) != failed.end()) {
+        return false;
+    }
+
+    cursor.seek(section_end);
+    return true;
 }
 
-inline void TSPLIBParser::parse_coord_section(std::istream& stream, TSPInstance& instance,
+inline void TSPLIBParser::parse_coord_section(detail::TextCursor& cursor, TSPInstance& instance,
                                               std::vector<std::array<double, 3>>& coords,
                                               const std::string& section_name) {
     coords.resize(instance.dimension);
 
-    std::string line;
-    for (int i = 0; i < instance.dimension && std::getline(stream, line); ++i) {
+    std::string_view line;
+    for (int i = 0; i < instance.dimension && cursor.next_line(line); ++i) {
         if (line.empty() || line_starts_with(line, "EOF"))
             break;
 
-        // Parse coordinates using mixed approach - std::from_chars for int, manual for doubles
+        // Parse node ID and coordinates in place with std::from_chars
         const char* start = line.data();
         const char* end = line.data() + line.size();
 
         // Skip whitespace
-        while (start < end && std::isspace(*start))
+        while (start < end && detail::is_blank(*start))
             ++start;
 
         int node_id;
         auto [ptr1, ec1] = std::from_chars(start, end, node_id);
         if (ec1 != std::errc()) {
-            throw TSPLIBFormatError("Invalid " + section_name + " node ID format at line: " + line);
+            throw TSPLIBFormatError("Invalid " + section_name +
+                                    " node ID format at line: " + std::string(line));
         }
 
         double x, y, z = 0.0;
-
-        // Parse coordinates directly from char buffer
-        // Note: std::strtod automatically skips leading whitespace
         const char* p = ptr1;
 
-        // Parse first coordinate (x)
-        char* endptr;
-        x = std::strtod(p, &endptr);
-        if (endptr == p) {
+        // Parse first coordinate (x); parse_number skips leading whitespace
+        p = detail::parse_number(p, end, x);
+        if (p == nullptr) {
             throw TSPLIBFormatError("Invalid " + section_name +
-                                    " coordinate format at line: " + line);
+                                    " coordinate format at line: " + std::string(line));
         }
-        p = endptr;
 
-        // Parse second coordinate (y) - std::strtod skips whitespace automatically
-        y = std::strtod(p, &endptr);
-        if (endptr == p) {
+        // Parse second coordinate (y)
+        p = detail::parse_number(p, end, y);
+        if (p == nullptr) {
             throw TSPLIBFormatError("Invalid " + section_name +
-                                    " coordinate format at line: " + line);
+                                    " coordinate format at line: " + std::string(line));
         }
-        p = endptr;
 
-        // Try to parse optional z coordinate - std::strtod skips whitespace automatically
-        if (p < end) {
-            z = std::strtod(p, &endptr);
-            // If parsing failed, z remains 0.0 (which is fine for optional coordinate)
+        // Try to parse optional z coordinate
+        if (detail::parse_number(p, end, z) == nullptr) {
+            z = 0.0; // Optional coordinate; absent or malformed means 2D
         }
 
         // Validate node_id and use it for proper indexing
@@ -594,15 +838,14 @@ inline void TSPLIBParser::parse_coord_section(std::istream& stream, TSPInstance&
     }
 }
 
-inline bool TSPLIBParser::line_starts_with(const std::string& line, const std::string& keyword) {
+inline bool TSPLIBParser::line_starts_with(std::string_view line, std::string_view keyword) {
     // Trim leading whitespace from line
     size_t start = line.find_first_not_of(" \t");
-    if (start == std::string::npos) {
+    if (start == std::string_view::npos) {
         return false;
     }
 
-    // Use C++23 string_view and starts_with for efficient comparison
-    return std::string_view(line).substr(start).starts_with(keyword);
+    return line.substr(start).starts_with(keyword);
 }
 
 } // namespace evolab::io
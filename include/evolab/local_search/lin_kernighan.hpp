@@ -0,0 +1,281 @@
+#pragma once
+
+/// @file lin_kernighan.hpp
+/// @brief Lin-Kernighan style local search for TSP
+///
+/// Each improvement step grows a sequential chain of moves from a base city t1: the tour edge
+/// (t1, t2) is broken, t2 is joined to a candidate t3, the edge (t3, t4) is broken and the
+/// tour is closed with (t4, t1), which is a single segment reversal. The chain continues from
+/// t4 while the accumulated gain stays positive, up to a depth limit, and is then cut back to
+/// its most profitable prefix. Depth one is a 2-opt move, depth two covers the sequential
+/// 3-opt moves (Or-opt included), and deeper chains reach moves that no fixed k-opt
+/// neighborhood contains.
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <evolab/core/concepts.hpp>
+#include <evolab/local_search/tour.hpp>
+#include <evolab/local_search/two_opt.hpp> // detail::ActiveQueue, improvement thresholds
+#include <evolab/problems/tsp.hpp>
+#include <evolab/utils/candidate_list.hpp>
+#include <evolab/utils/compiler_hints.hpp>
+
+namespace evolab::local_search {
+
+/// Lin-Kernighan style local search (depth-limited chains of 2-opt moves)
+///
+/// Candidates of t2 are scanned in distance order while the chain gain stays positive and
+/// ranked by one step of lookahead, g + d(t3, t4). The first step tries up to `breadth`
+/// alternatives; deeper steps follow the best one. Edges added by a chain are never broken
+/// again and broken edges are never re-added, so chains cannot cycle. Base cities are taken
+/// from a don't-look-bit queue as in CandidateList2Opt, and chains run on a FlipTour, so
+/// every step is a single flip that is undone by flipping the same path back.
+class LinKernighan {
+    int k_nearest_;
+    int max_depth_;
+    int breadth_;
+    TourRepresentation representation_;
+
+  public:
+    static constexpr int DEFAULT_MAX_DEPTH = 50;
+    static constexpr int DEFAULT_BREADTH = 5;
+
+    explicit LinKernighan(int k_nearest = 10, int max_depth = DEFAULT_MAX_DEPTH,
+                          int breadth = DEFAULT_BREADTH,
+                          TourRepresentation representation = TourRepresentation::Auto)
+        : k_nearest_(k_nearest), max_depth_(std::max(max_depth, 1)),
+          breadth_(std::max(breadth, 1)), representation_(representation) {}
+
+    core::Fitness improve(const problems::TSP& problem, problems::TSP::GenomeT& tour,
+                          [[maybe_unused]] std::mt19937& rng) const {
+        if (EVOLAB_UNLIKELY(tour.size() < 5))
+            return problem.evaluate(tour);
+
+        // Resolve the distance back-end once so the search loops are specialized per storage
+        return problem.visit_distance([&](const auto& distances) {
+            return with_tour(representation_, tour, [&](auto& flip_tour) {
+                return improve_with(problem, distances, tour, flip_tour);
+            });
+        });
+    }
+
+    template <core::Problem P>
+    core::Fitness improve(const P& problem, typename P::GenomeT& genome, std::mt19937& rng) const {
+        if constexpr (std::is_same_v<P, problems::TSP>) {
+            // Calls non-template overload (C++ overload resolution prioritizes non-template
+            // functions)
+            return improve(problem, genome, rng);
+        } else {
+            return problem.evaluate(genome);
+        }
+    }
+
+    int k_nearest() const { return k_nearest_; }
+    int max_depth() const { return max_depth_; }
+    int breadth() const { return breadth_; }
+    TourRepresentation representation() const { return representation_; }
+
+  private:
+    /// State of one local search call: the tour and scratch buffers
+    template <typename Gain, typename Dist, typename Tour>
+    struct Search {
+        const problems::TSP& problem;
+        const Dist& distances;
+        const utils::CandidateList& candidates;
+        Tour& tour;
+        int max_depth;
+        int breadth;
+
+        std::vector<std::pair<int, int>> flips;   // Paths reversed by the current chain
+        std::vector<std::pair<int, int>> added;   // Edges joined by the current chain
+        std::vector<std::pair<int, int>> removed; // Edges broken by the current chain
+        std::vector<int> touched;                 // Cities whose edges the chain changed
+
+        struct Step {
+            int t3;
+            int t4;
+            Gain value; // Chain gain after breaking (t3, t4), before closing the tour
+        };
+        std::vector<Step> steps;       // Continuations found by collect_steps
+        std::vector<Step> first_steps; // Alternatives for the first step of a chain
+
+        Search(const problems::TSP& problem, const Dist& distances,
+               const utils::CandidateList& candidates, Tour& tour, int max_depth, int breadth)
+            : problem(problem), distances(distances), candidates(candidates), tour(tour),
+              max_depth(max_depth), breadth(breadth) {}
+
+        Gain d(int a, int b) const { return problem.cached_distance(distances, a, b); }
+        int succ(int city) const { return tour.next(city); }
+        int pred(int city) const { return tour.prev(city); }
+
+        static std::pair<int, int> edge(int a, int b) { return std::minmax(a, b); }
+        static bool contains(const std::vector<std::pair<int, int>>& edges,
+                             std::pair<int, int> e) {
+            return std::ranges::find(edges, e) != edges.end();
+        }
+
+        /// Reverse the path from `from` forward to `to`
+        void flip(int from, int to) {
+            tour.flip(from, to);
+            flips.emplace_back(from, to);
+        }
+
+        /// Undo flips until only `depth` remain
+        void undo_to(std::size_t depth) {
+            while (flips.size() > depth) {
+                // The path now runs from `to` to `from`; reversing it again restores the tour
+                const auto [from, to] = flips.back();
+                tour.flip(to, from);
+                flips.pop_back();
+            }
+        }
+
+        /// Collect up to `limit` continuations of the chain at t2, best lookahead value first
+        /// @param forward Whether t2 follows t1 in tour order
+        void collect_steps(int t1, int t2, bool forward, Gain open, int limit) {
+            steps.clear();
+            const auto ids = candidates.get_candidates(t2);
+            const auto distances_to = candidates.get_candidate_distances(t2);
+            const int t2_next = forward ? succ(t2) : pred(t2);
+            for (std::size_t r = 0; r < ids.size(); ++r) {
+                const Gain g = open - static_cast<Gain>(distances_to[r]);
+                // Candidates are sorted by distance: the gain criterion fails from here on
+                if (g <= Gain{0})
+                    break;
+                const int t3 = ids[r];
+                if (t3 == t1 || t3 == t2_next || contains(removed, edge(t2, t3)))
+                    continue;
+                const int t4 = forward ? pred(t3) : succ(t3);
+                if (contains(added, edge(t3, t4)))
+                    continue;
+
+                const Step step{t3, t4, g + d(t3, t4)};
+                if (static_cast<int>(steps.size()) < limit) {
+                    steps.push_back(step);
+                } else if (step.value > steps.back().value) {
+                    steps.back() = step;
+                } else {
+                    continue;
+                }
+                // Keep the list sorted by descending value (it holds at most `limit` steps)
+                for (std::size_t s = steps.size() - 1;
+                     s > 0 && steps[s].value > steps[s - 1].value; --s) {
+                    std::swap(steps[s], steps[s - 1]);
+                }
+            }
+        }
+
+        /// Grow a chain from t1 whose first step is `first`; keep its best prefix if improving
+        /// @return Gain of the kept prefix, or 0 with the tour restored
+        Gain run_chain(int t1, int t2, bool forward, Step first) {
+            flips.clear();
+            added.clear();
+            removed.assign(1, edge(t1, t2));
+            touched.assign(1, t1);
+
+            Gain best_gain = improvement_threshold_v<Gain>;
+            std::size_t best_depth = 0;
+            std::size_t best_touched = 0;
+            Step step = first;
+            while (true) {
+                const int t3 = step.t3;
+                const int t4 = step.t4;
+                // Break (t1, t2), (t4, t3) and join (t2, t3), (t4, t1)
+                if (forward) {
+                    flip(t2, t4);
+                } else {
+                    flip(t4, t2);
+                }
+                added.push_back(edge(t2, t3));
+                removed.push_back(edge(t3, t4));
+                touched.insert(touched.end(), {t2, t3, t4});
+
+                const Gain closed = step.value - d(t4, t1);
+                if (closed > best_gain) {
+                    best_gain = closed;
+                    best_depth = flips.size();
+                    best_touched = touched.size();
+                }
+                if (static_cast<int>(flips.size()) >= max_depth)
+                    break;
+
+                // t4 is now a tour neighbor of t1; continue by breaking (t1, t4)
+                t2 = t4;
+                forward = succ(t1) == t2;
+                collect_steps(t1, t2, forward, step.value, 1);
+                if (steps.empty())
+                    break;
+                step = steps.front();
+            }
+
+            undo_to(best_depth);
+            if (best_depth == 0)
+                return Gain{0};
+            touched.resize(best_touched);
+            return best_gain;
+        }
+
+        /// Try to improve the tour with a chain based at t1
+        Gain improve_from(int t1) {
+            for (bool forward : {true, false}) {
+                const int t2 = forward ? succ(t1) : pred(t1);
+                added.clear();
+                removed.assign(1, edge(t1, t2));
+                collect_steps(t1, t2, forward, d(t1, t2), breadth);
+                // run_chain reuses the step buffer
+                first_steps.assign(steps.begin(), steps.end());
+                for (const Step& first : first_steps) {
+                    const Gain gain = run_chain(t1, t2, forward, first);
+                    if (gain > Gain{0})
+                        return gain;
+                }
+            }
+            return Gain{0};
+        }
+    };
+
+    template <typename Dist, typename Tour>
+    core::Fitness improve_with(const problems::TSP& problem, const Dist& distances,
+                               const problems::TSP::GenomeT& genome, Tour& tour) const {
+        const int n = problem.num_cities();
+        problem.clear_distance_cache();
+
+        const auto* candidate_list = problem.get_candidate_list(k_nearest_);
+
+        using gain_type = problems::storage::distance_sum_t<Dist>;
+        gain_type current_length = problem.tour_length(distances, genome);
+
+        Search<gain_type, Dist, Tour> search(problem, distances, *candidate_list, tour,
+                                             max_depth_, breadth_);
+
+        detail::ActiveQueue active(n);
+        for (int city : genome) {
+            active.push(city);
+        }
+
+        std::size_t moves = 0;
+        const std::size_t max_moves = static_cast<std::size_t>(n) * 10; // Prevent infinite loops
+
+        while (!active.empty() && moves < max_moves) {
+            const int t1 = active.pop();
+            const gain_type gain = search.improve_from(t1);
+            if (gain <= gain_type{0})
+                continue;
+
+            current_length -= gain;
+            ++moves;
+            for (int city : search.touched) {
+                active.push(city);
+            }
+        }
+
+        return core::Fitness{static_cast<double>(current_length)};
+    }
+};
+
+} // namespace evolab::local_search
@@ -0,0 +1,275 @@
+#pragma once
+
+/// @file or_opt.hpp
+/// @brief Or-opt segment relocation and chaining of local searches
+///
+/// Or-opt moves a segment of up to three consecutive cities to another place in the tour,
+/// optionally reversed. These relocations are 3-opt moves that 2-opt cannot perform, so
+/// chaining both neighborhoods (see TwoOptOrOpt) removes defects that 2-opt alone leaves.
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+#include <evolab/core/concepts.hpp>
+#include <evolab/local_search/tour.hpp>
+#include <evolab/local_search/two_opt.hpp> // detail::ActiveQueue, improvement thresholds
+#include <evolab/problems/tsp.hpp>
+#include <evolab/utils/compiler_hints.hpp>
+
+namespace evolab::local_search {
+
+/// Candidate list Or-opt (relocates segments of 1..max_segment_length cities)
+///
+/// Like CandidateList2Opt, the search is driven by don't-look bits: a city is examined as
+/// either end of each segment length, and the cities around each applied move are queued
+/// again. A segment is only inserted next to a candidate of one of its ends, in the
+/// orientation that makes them adjacent, and candidates are scanned only while the new edge
+/// is shorter than the gain of removing the segment. Each move is evaluated in O(1) from six
+/// edge lengths and applied as path reversals on a FlipTour.
+class OrOpt {
+    int k_nearest_;
+    int max_segment_length_;
+    bool first_improvement_;
+    TourRepresentation representation_;
+
+  public:
+    /// Longest segment tried; longer relocations rarely pay off against their cost
+    static constexpr int MAX_SEGMENT_LENGTH = 3;
+
+    explicit OrOpt(int k_nearest = 20, int max_segment_length = MAX_SEGMENT_LENGTH,
+                   bool first_improvement = true,
+                   TourRepresentation representation = TourRepresentation::Auto)
+        : k_nearest_(k_nearest),
+          max_segment_length_(std::clamp(max_segment_length, 1, MAX_SEGMENT_LENGTH)),
+          first_improvement_(first_improvement), representation_(representation) {}
+
+    core::Fitness improve(const problems::TSP& problem, problems::TSP::GenomeT& tour,
+                          [[maybe_unused]] std::mt19937& rng) const {
+        // Relocating even a single city needs a gap elsewhere in the tour
+        if (EVOLAB_UNLIKELY(tour.size() < 5))
+            return problem.evaluate(tour);
+
+        // Resolve the distance back-end once so the search loops are specialized per storage
+        return problem.visit_distance([&](const auto& distances) {
+            return with_tour(representation_, tour, [&](auto& flip_tour) {
+                return improve_with(problem, distances, tour, flip_tour);
+            });
+        });
+    }
+
+    template <core::Problem P>
+    core::Fitness improve(const P& problem, typename P::GenomeT& genome, std::mt19937& rng) const {
+        if constexpr (std::is_same_v<P, problems::TSP>) {
+            // Calls non-template overload (C++ overload resolution prioritizes non-template
+            // functions)
+            return improve(problem, genome, rng);
+        } else {
+            return problem.evaluate(genome);
+        }
+    }
+
+    int k_nearest() const { return k_nearest_; }
+    int max_segment_length() const { return max_segment_length_; }
+    bool first_improvement() const { return first_improvement_; }
+    TourRepresentation representation() const { return representation_; }
+
+  private:
+    /// Move the segment from `first` to `last` between `after` and its successor, reversed if
+    /// `reversed`
+    template <typename Gain>
+    struct Move {
+        int first = -1;
+        int last = -1;
+        int after = -1;
+        bool reversed = false;
+        Gain gain;
+    };
+
+    /// Search the segments ending at `city` for an improving relocation (first == -1 if none)
+    template <bool FirstImprovement, typename Gain, typename Dist, typename Tour>
+    Move<Gain> find_move(const problems::TSP& problem, const Dist& distances,
+                         const utils::CandidateList& candidate_list, const Tour& tour,
+                         int city) const {
+        const int n = tour.size();
+        auto d = [&](int a, int b) -> Gain { return problem.cached_distance(distances, a, b); };
+
+        Move<Gain> best{-1, -1, -1, false, improvement_threshold_v<Gain>};
+        const auto candidates = candidate_list.get_candidates(city);
+        const auto candidate_distances = candidate_list.get_candidate_distances(city);
+
+        // Cities from `city` onwards and backwards, enough for the longest segment
+        int ahead[MAX_SEGMENT_LENGTH] = {city};
+        int behind[MAX_SEGMENT_LENGTH] = {city};
+        for (int k = 1; k < max_segment_length_; ++k) {
+            ahead[k] = tour.next(ahead[k - 1]);
+            behind[k] = tour.prev(behind[k - 1]);
+        }
+
+        for (int length = 1; length <= max_segment_length_ && length + 3 <= n; ++length) {
+            // The city starts the segment, then ends it (the same segment when length is 1)
+            for (int side = 0; side < (length == 1 ? 1 : 2); ++side) {
+                const int* segment = side == 0 ? ahead : behind;
+                const int first = side == 0 ? city : behind[length - 1];
+                const int last = side == 0 ? ahead[length - 1] : city;
+                const int pred = tour.prev(first);
+                const int succ = tour.next(last);
+
+                const Gain remove_gain = (d(pred, first) + d(last, succ)) - d(pred, succ);
+                if (remove_gain <= improvement_threshold_v<Gain>)
+                    continue;
+
+                // The other end of the segment stays attached to the far side of the gap
+                const int other = city == first ? last : first;
+                auto in_segment = [segment, length](int c) {
+                    return std::find(segment, segment + length, c) != segment + length;
+                };
+
+                for (std::size_t r = 0; r < candidates.size(); ++r) {
+                    const Gain d_candidate = static_cast<Gain>(candidate_distances[r]);
+                    // Candidates are sorted by distance; the new edge alone exceeds the gain
+                    if (d_candidate >= remove_gain)
+                        break;
+                    const int c = candidates[r];
+                    if (in_segment(c))
+                        continue;
+
+                    // Insert between c and its successor: city follows c
+                    const int c_succ = tour.next(c);
+                    if (!in_segment(c_succ)) {
+                        const Gain gain =
+                            remove_gain - ((d_candidate + d(other, c_succ)) - d(c, c_succ));
+                        if (gain > best.gain) {
+                            best = {first, last, c, city != first, gain};
+                            if constexpr (FirstImprovement)
+                                return best;
+                        }
+                    }
+
+                    // Insert between c's predecessor and c: city precedes c
+                    const int c_pred = tour.prev(c);
+                    if (!in_segment(c_pred)) {
+                        const Gain gain =
+                            remove_gain - ((d(c_pred, other) + d_candidate) - d(c_pred, c));
+                        if (gain > best.gain) {
+                            best = {first, last, c_pred, city != last, gain};
+                            if constexpr (FirstImprovement)
+                                return best;
+                        }
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+    /// Apply a relocation as two or three path reversals
+    ///
+    /// With pred -> first..last -> succ and the target edge after -> b, reversing first..after
+    /// and then succ..after leaves pred -> succ .. after -> last..first -> b.
+    template <typename Gain, typename Tour>
+    static void apply_move(Tour& tour, const Move<Gain>& move) {
+        const int succ = tour.next(move.last);
+        tour.flip(move.first, move.after);
+        tour.flip(move.after, succ);
+        if (!move.reversed) {
+            tour.flip(move.last, move.first);
+        }
+    }
+
+    template <typename Dist, typename Tour>
+    core::Fitness improve_with(const problems::TSP& problem, const Dist& distances,
+                               const problems::TSP::GenomeT& genome, Tour& tour) const {
+        const int n = problem.num_cities();
+        problem.clear_distance_cache();
+
+        const auto* candidate_list = problem.get_candidate_list(k_nearest_);
+
+        using gain_type = problems::storage::distance_sum_t<Dist>;
+        gain_type current_length = problem.tour_length(distances, genome);
+
+        detail::ActiveQueue active(n);
+        for (int city : genome) {
+            active.push(city);
+        }
+
+        std::size_t moves = 0;
+        const std::size_t max_moves = static_cast<std::size_t>(n) * 10; // Prevent infinite loops
+
+        while (!active.empty() && moves < max_moves) {
+            const int city = active.pop();
+            const auto move =
+                first_improvement_
+                    ? find_move<true, gain_type>(problem, distances, *candidate_list, tour, city)
+                    : find_move<false, gain_type>(problem, distances, *candidate_list, tour, city);
+            if (move.first < 0)
+                continue;
+
+            // Cities whose tour edges change: both gaps and the segment ends
+            const int touched[] = {tour.prev(move.first), move.first,
+                                   move.last,             tour.next(move.last),
+                                   move.after,            tour.next(move.after)};
+
+            apply_move(tour, move);
+            current_length -= move.gain;
+            ++moves;
+
+            for (int endpoint : touched) {
+                active.push(endpoint);
+            }
+        }
+
+        return core::Fitness{static_cast<double>(current_length)};
+    }
+};
+
+/// Runs two local searches alternately until neither shortens the tour any further
+///
+/// Each search returns at its own local optimum, which is usually not a local optimum of the
+/// other neighborhood; alternating reaches a tour that is locally optimal for both.
+template <typename First, typename Second>
+class Chain {
+    First first_;
+    Second second_;
+    std::size_t max_rounds_;
+
+  public:
+    /// @param max_rounds Upper bound on first/second alternations (0 = until converged)
+    explicit Chain(First first = First{}, Second second = Second{}, std::size_t max_rounds = 0)
+        : first_(std::move(first)), second_(std::move(second)), max_rounds_(max_rounds) {}
+
+    template <core::Problem P>
+    core::Fitness improve(const P& problem, typename P::GenomeT& genome, std::mt19937& rng) const {
+        core::Fitness fitness = first_.improve(problem, genome, rng);
+        for (std::size_t round = 0; max_rounds_ == 0 || round < max_rounds_; ++round) {
+            const core::Fitness relocated = second_.improve(problem, genome, rng);
+            if (!(relocated < fitness))
+                return relocated;
+            const core::Fitness reoptimized = first_.improve(problem, genome, rng);
+            if (!(reoptimized < relocated))
+                return reoptimized;
+            fitness = reoptimized;
+        }
+        return fitness;
+    }
+
+    const First& first() const { return first_; }
+    const Second& second() const { return second_; }
+    std::size_t max_rounds() const { return max_rounds_; }
+};
+
+/// Combined 2-opt + Or-opt neighborhood over the same candidate lists
+using TwoOptOrOpt = Chain<CandidateList2Opt, OrOpt>;
+
+/// Create a 2-opt + Or-opt search using k nearest neighbors for both neighborhoods
+inline TwoOptOrOpt
+make_two_opt_or_opt(int k_nearest = 20, bool first_improvement = true,
+                    TourRepresentation representation = TourRepresentation::Auto) {
+    return TwoOptOrOpt(
+        CandidateList2Opt(k_nearest, first_improvement, representation),
+        OrOpt(k_nearest, OrOpt::MAX_SEGMENT_LENGTH, first_improvement, representation));
+}
+
+} // namespace evolab::local_search
@@ -0,0 +1,122 @@
+#pragma once
+
+/// @file tour.hpp
+/// @brief Tour representations that local search engines run on
+///
+/// Engines see a tour only through next, prev, between and flip (see FlipTour), so the same
+/// search runs on a plain array with a position index or on a two-level list. The array is
+/// cheapest for small and medium tours; the two-level list bounds the cost of a reversal by
+/// O(√n) and wins on tours of about ten thousand cities and more. Either is built from the
+/// genome when a search starts and written back when it ends.
+
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <evolab/problems/tsp.hpp>
+#include <evolab/utils/tour_reversal.hpp>
+#include <evolab/utils/two_level_list.hpp>
+
+namespace evolab::local_search {
+
+/// Tour operations used by the local search engines
+template <typename T>
+concept FlipTour = requires(T& tour, const T& const_tour, int city) {
+    { const_tour.next(city) } -> std::same_as<int>;
+    { const_tour.prev(city) } -> std::same_as<int>;
+    { const_tour.between(city, city, city) } -> std::same_as<bool>; // b on the path a -> c
+    tour.flip(city, city); // Reverse the path a -> b
+};
+
+/// Array tour with a city -> position index maintained across flips
+///
+/// flip reverses whichever of the requested path and the rest of the tour is shorter (see
+/// utils::reverse_shorter_side), toggling the orientation in the latter case, so a flip
+/// moves at most n/2 cities. The array may therefore end up read backwards, which describes
+/// the same cycle.
+class ArrayTour {
+    problems::TSP::GenomeT& tour_;
+    std::vector<int> position_;
+    int n_;
+    bool reversed_ = false; // Whether tour order runs backwards through the array
+
+  public:
+    /// Operate on `tour` in place
+    explicit ArrayTour(problems::TSP::GenomeT& tour)
+        : tour_(tour), position_(tour.size()), n_(static_cast<int>(tour.size())) {
+        for (int i = 0; i < n_; ++i) {
+            position_[tour_[i]] = i;
+        }
+    }
+
+    [[nodiscard]] int size() const noexcept { return n_; }
+
+    [[nodiscard]] int next(int city) const noexcept {
+        return reversed_ ? raw_prev(city) : raw_next(city);
+    }
+
+    [[nodiscard]] int prev(int city) const noexcept {
+        return reversed_ ? raw_next(city) : raw_prev(city);
+    }
+
+    [[nodiscard]] bool between(int a, int b, int c) const noexcept {
+        if (reversed_)
+            std::swap(a, c);
+        const int pa = position_[a];
+        const int pb = position_[b];
+        const int pc = position_[c];
+        return pa <= pc ? (pa <= pb && pb <= pc) : (pb >= pa || pb <= pc);
+    }
+
+    void flip(int a, int b) {
+        if (reversed_)
+            std::swap(a, b);
+        if (utils::reverse_shorter_side(tour_, position_[a], position_[b], position_)) {
+            reversed_ = !reversed_;
+        }
+    }
+
+  private:
+    int raw_next(int city) const noexcept {
+        const int p = position_[city] + 1;
+        return tour_[p < n_ ? p : 0];
+    }
+
+    int raw_prev(int city) const noexcept {
+        const int p = position_[city];
+        return tour_[p > 0 ? p - 1 : n_ - 1];
+    }
+};
+
+/// Tour representation used by a local search
+enum class TourRepresentation {
+    Auto,        ///< TwoLevelList from TWO_LEVEL_LIST_MIN_CITIES cities, ArrayTour below
+    Array,       ///< ArrayTour
+    TwoLevelList ///< utils::TwoLevelList
+};
+
+/// Tours from this size on use the two-level list under TourRepresentation::Auto
+inline constexpr std::size_t TWO_LEVEL_LIST_MIN_CITIES = 10000;
+
+/// Run search(tour) on the representation selected for `genome` and return its result
+///
+/// The genome is updated with the final tour; a two-level list is written back starting at
+/// the city that was first before the search.
+template <typename Search>
+auto with_tour(TourRepresentation representation, problems::TSP::GenomeT& genome,
+               const Search& search) {
+    const bool two_level =
+        representation == TourRepresentation::TwoLevelList ||
+        (representation == TourRepresentation::Auto && genome.size() >= TWO_LEVEL_LIST_MIN_CITIES);
+    if (two_level) {
+        utils::TwoLevelList tour(genome);
+        auto result = search(tour);
+        tour.copy_to(genome, genome.front());
+        return result;
+    }
+    ArrayTour tour(genome);
+    return search(tour);
+}
+
+} // namespace evolab::local_search
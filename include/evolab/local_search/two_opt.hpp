@@ -8,6 +8,7 @@
 /// optimizations for research-grade memetic algorithms.
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdlib>
 #include <limits>
 #include <random>
@@ -16,6 +17,7 @@
 
 // EvoLab dependencies - core concepts and TSP problem definition
 #include <evolab/core/concepts.hpp>        // Type constraints for local search interface
+#include <evolab/local_search/tour.hpp>    // Tour representations for candidate search
 #include <evolab/problems/tsp.hpp>         // TSP problem class with distance calculations
 #include <evolab/utils/compiler_hints.hpp> // Branch prediction hints
 
@@ -25,6 +27,13 @@ namespace evolab::local_search {
 /// Values below this threshold are considered numerical noise
 constexpr double MIN_IMPROVEMENT_GAIN = 1e-9;
 
+/// Smallest gain accepted as an improvement for a given gain type
+/// Integral gains (see problems::storage::distance_sum_t) are exact, so any positive gain
+/// improves the tour and no epsilon is needed
+template <typename Gain>
+inline constexpr Gain improvement_threshold_v =
+    std::is_integral_v<Gain> ? Gain{0} : static_cast<Gain>(MIN_IMPROVEMENT_GAIN);
+
 /// 2-opt local search for TSP problems
 class TwoOpt {
     bool first_improvement_;
@@ -37,6 +46,15 @@ class TwoOpt {
     /// Improve TSP tour using 2-opt
     core::Fitness improve(const problems::TSP& problem, problems::TSP::GenomeT& tour,
                           [[maybe_unused]] std::mt19937& rng) const {
+        // Resolve the distance back-end once so the search loops are specialized per storage
+        return problem.visit_distance(
+            [&](const auto& distances) { return improve_with(problem, distances, tour); });
+    }
+
+  private:
+    template <typename Dist>
+    core::Fitness improve_with(const problems::TSP& problem, const Dist& distances,
+                               problems::TSP::GenomeT& tour) const {
         const int n = static_cast<int>(tour.size());
         // Tours with < 4 cities cannot be improved by 2-opt (need at least 2 edges to swap)
         // This is unlikely since typical TSP instances have many cities
@@ -46,9 +64,12 @@ class TwoOpt {
         // Clear cache for fresh local search
         problem.clear_distance_cache();
 
+        using gain_type = problems::storage::distance_sum_t<Dist>;
+        constexpr gain_type threshold = improvement_threshold_v<gain_type>;
+
         bool improved = true;
         std::size_t iterations = 0;
-        core::Fitness current_fitness = problem.evaluate(tour);
+        gain_type current_length = problem.tour_length(distances, tour);
 
         // Performance-critical design: first/best improvement strategies are
         // intentionally separated to hoist the branch outside the hot nested loops.
@@ -58,7 +79,7 @@ class TwoOpt {
         while (improved && (max_iterations_ == 0 || iterations < max_iterations_)) {
             improved = false;
             int best_i = -1, best_j = -1;
-            double best_gain = MIN_IMPROVEMENT_GAIN;
+            gain_type best_gain = threshold;
 
             if (first_improvement_) {
                 for (int i = 0; i < n - 1; ++i) {
@@ -68,12 +89,12 @@ class TwoOpt {
                             continue;
 
                         // Use cached gain calculation for better performance
-                        const double gain = problem.two_opt_gain_cached(tour, i, j);
+                        const gain_type gain = problem.two_opt_gain_cached(distances, tour, i, j);
 
                         // First improvement: apply first improving move immediately
-                        if (EVOLAB_UNLIKELY(gain > MIN_IMPROVEMENT_GAIN)) {
+                        if (EVOLAB_UNLIKELY(gain > threshold)) {
                             problem.apply_two_opt(tour, i, j);
-                            current_fitness = core::Fitness{current_fitness.value - gain};
+                            current_length -= gain;
                             improved = true;
                             goto next_iteration;
                         }
@@ -87,7 +108,7 @@ class TwoOpt {
                             continue;
 
                         // Use cached gain calculation for better performance
-                        const double gain = problem.two_opt_gain_cached(tour, i, j);
+                        const gain_type gain = problem.two_opt_gain_cached(distances, tour, i, j);
 
                         // Best improvement: track best move across all candidates
                         if (gain > best_gain) {
@@ -101,7 +122,7 @@ class TwoOpt {
                 // Apply best improvement if found
                 if (best_i != -1) {
                     problem.apply_two_opt(tour, best_i, best_j);
-                    current_fitness = core::Fitness{current_fitness.value - best_gain};
+                    current_length -= best_gain;
                     improved = true;
                 }
             }
@@ -110,9 +131,10 @@ class TwoOpt {
             iterations++;
         }
 
-        return current_fitness;
+        return core::Fitness{static_cast<double>(current_length)};
     }
 
+  public:
     /// Generic improve method for concept compliance
     template <core::Problem P>
     core::Fitness improve(const P& problem, typename P::GenomeT& genome, std::mt19937& rng) const {
@@ -139,14 +161,25 @@ class Random2Opt {
 
     core::Fitness improve(const problems::TSP& problem, problems::TSP::GenomeT& tour,
                           std::mt19937& rng) const {
+        // Resolve the distance back-end once so the search loops are specialized per storage
+        return problem.visit_distance(
+            [&](const auto& distances) { return improve_with(problem, distances, tour, rng); });
+    }
+
+  private:
+    template <typename Dist>
+    core::Fitness improve_with(const problems::TSP& problem, const Dist& distances,
+                               problems::TSP::GenomeT& tour, std::mt19937& rng) const {
         const int n = static_cast<int>(tour.size());
         if (EVOLAB_UNLIKELY(n < 4))
             return problem.evaluate(tour);
 
         problem.clear_distance_cache();
 
+        using gain_type = problems::storage::distance_sum_t<Dist>;
+
         std::uniform_int_distribution<int> dist(0, n - 1);
-        double best_gain = 0.0;
+        gain_type best_gain = 0;
         int best_i = -1, best_j = -1;
 
         for (std::size_t attempt = 0; attempt < num_attempts_; ++attempt) {
@@ -162,7 +195,7 @@ class Random2Opt {
             if (i > j)
                 std::swap(i, j);
 
-            const double gain = problem.two_opt_gain_cached(tour, i, j);
+            const gain_type gain = problem.two_opt_gain_cached(distances, tour, i, j);
             if (EVOLAB_UNLIKELY(gain > best_gain)) {
                 best_gain = gain;
                 best_i = i;
@@ -170,16 +203,17 @@ class Random2Opt {
             }
         }
 
-        core::Fitness current_fitness = problem.evaluate(tour);
+        gain_type current_length = problem.tour_length(distances, tour);
 
-        if (EVOLAB_UNLIKELY(best_gain > MIN_IMPROVEMENT_GAIN)) {
+        if (EVOLAB_UNLIKELY(best_gain > improvement_threshold_v<gain_type>)) {
             problem.apply_two_opt(tour, best_i, best_j);
-            current_fitness = core::Fitness{current_fitness.value - best_gain};
+            current_length -= best_gain;
         }
 
-        return current_fitness;
+        return core::Fitness{static_cast<double>(current_length)};
     }
 
+  public:
     template <core::Problem P>
     core::Fitness improve(const P& problem, typename P::GenomeT& genome, std::mt19937& rng) const {
         if constexpr (std::is_same_v<P, problems::TSP>) {
@@ -194,111 +228,198 @@ class Random2Opt {
     std::size_t num_attempts() const { return num_attempts_; }
 };
 
+namespace detail {
+
+/// FIFO of cities awaiting examination by a local search
+/// A city is queued at most once; a city that is not queued has its don't-look bit set.
+class ActiveQueue {
+    std::vector<int> ring_;
+    std::vector<char> queued_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+
+  public:
+    explicit ActiveQueue(int n) : ring_(n), queued_(n, 0) {}
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    /// Queue a city unless it is already waiting
+    void push(int city) {
+        if (queued_[city])
+            return;
+        queued_[city] = 1;
+        std::size_t tail = head_ + size_;
+        if (tail >= ring_.size())
+            tail -= ring_.size();
+        ring_[tail] = city;
+        ++size_;
+    }
+
+    int pop() {
+        const int city = ring_[head_];
+        if (++head_ == ring_.size())
+            head_ = 0;
+        --size_;
+        queued_[city] = 0;
+        return city;
+    }
+};
+
+} // namespace detail
+
 /// Candidate list 2-opt (uses nearest neighbor lists for efficiency)
+///
+/// The search is driven by don't-look bits: every city starts in an active queue, a city
+/// whose candidates yield no improving move drops out, and the endpoints of each applied
+/// move are queued again. On a nearly 2-optimal tour a call costs one O(nk) sweep plus
+/// O(k) per city around each change, instead of repeated full passes. Moves are applied
+/// through a FlipTour (see tour.hpp), which keeps positions up to date across reversals.
+///
+/// Both tour neighbors of a city are tried, and candidates are scanned in distance order
+/// only while d(city, candidate) is shorter than the tour edge it would replace, since
+/// otherwise the move cannot gain from this end. First improvement applies the first
+/// improving move found for a city; best improvement applies the best one among its
+/// candidates.
 class CandidateList2Opt {
     int k_nearest_;
     bool first_improvement_;
+    TourRepresentation representation_;
 
   public:
-    explicit CandidateList2Opt(int k_nearest = 20, bool first_improvement = true)
-        : k_nearest_(k_nearest), first_improvement_(first_improvement) {}
+    explicit CandidateList2Opt(int k_nearest = 20, bool first_improvement = true,
+                               TourRepresentation representation = TourRepresentation::Auto)
+        : k_nearest_(k_nearest), first_improvement_(first_improvement),
+          representation_(representation) {}
 
     core::Fitness improve(const problems::TSP& problem, problems::TSP::GenomeT& tour,
                           [[maybe_unused]] std::mt19937& rng) const {
-        const int n = problem.num_cities();
-        if (EVOLAB_UNLIKELY(n < 4))
+        if (EVOLAB_UNLIKELY(tour.size() < 4))
             return problem.evaluate(tour);
 
-        problem.clear_distance_cache();
-
-        // Get or create candidate list
-        const auto* candidate_list = problem.get_candidate_list(k_nearest_);
-
-        bool improved = true;
-        core::Fitness current_fitness = problem.evaluate(tour);
-        std::size_t iterations = 0;
-        const std::size_t max_iterations = n * 10; // Prevent infinite loops
-
-        while (improved && iterations < max_iterations) {
-            improved = false;
-            iterations++;
-            int best_i = -1, best_j = -1;
-            double best_gain = MIN_IMPROVEMENT_GAIN;
+        // Resolve the distance back-end once so the search loops are specialized per storage
+        return problem.visit_distance([&](const auto& distances) {
+            return with_tour(representation_, tour, [&](auto& flip_tour) {
+                return improve_with(problem, distances, tour, flip_tour);
+            });
+        });
+    }
 
-            // Build position mapping for O(1) city position lookup
-            std::vector<int> position(n);
-            for (int i = 0; i < n; ++i) {
-                position[tour[i]] = i;
+  private:
+    /// 2-opt move reversing the path from `from` to `to`
+    template <typename Gain>
+    struct Move {
+        int from = -1;
+        int to = -1;
+        Gain gain;
+    };
+
+    /// Search the candidates of `city` for an improving move (from == -1 if none)
+    ///
+    /// d(city, candidate) comes from the candidate list, so each candidate costs two distance
+    /// lookups per direction. Summation order matches TSP::two_opt_gain_cached.
+    template <bool FirstImprovement, typename Gain, typename Dist, typename Tour>
+    static Move<Gain> find_move(const problems::TSP& problem, const Dist& distances,
+                                const utils::CandidateList& candidate_list, const Tour& tour,
+                                int city) {
+        const int succ = tour.next(city);
+        const int pred = tour.prev(city);
+        const Gain d_succ = problem.cached_distance(distances, city, succ);
+        const Gain d_pred = problem.cached_distance(distances, pred, city);
+
+        Move<Gain> best{-1, -1, improvement_threshold_v<Gain>};
+        const auto candidates = candidate_list.get_candidates(city);
+        const auto candidate_distances = candidate_list.get_candidate_distances(city);
+        for (std::size_t c = 0; c < candidates.size(); ++c) {
+            const Gain d_candidate = static_cast<Gain>(candidate_distances[c]);
+            // Candidates are sorted by distance: no later one can beat either tour edge
+            if (d_candidate >= d_succ && d_candidate >= d_pred)
+                break;
+
+            const int other = candidates[c];
+
+            // Replace (city, succ), (other, other_succ) with (city, other), (succ, other_succ)
+            if (d_candidate < d_succ) {
+                const int other_succ = tour.next(other);
+                if (EVOLAB_LIKELY(other != succ && other_succ != city)) {
+                    const Gain old_dist =
+                        d_succ + problem.cached_distance(distances, other, other_succ);
+                    const Gain new_dist =
+                        d_candidate + problem.cached_distance(distances, succ, other_succ);
+                    if (old_dist - new_dist > best.gain) {
+                        best = {succ, other, old_dist - new_dist};
+                        if constexpr (FirstImprovement)
+                            return best;
+                    }
+                }
             }
 
-            // Performance-critical: separate first/best improvement to avoid branching
-            // in the hot candidate iteration loop (see TwoOpt::improve for rationale)
-            if (first_improvement_) {
-                for (int i = 0; i < n; ++i) {
-                    const int city_i = tour[i];
-
-                    // Get candidates for city at position i
-                    const auto& candidates = candidate_list->get_candidates(city_i);
-
-                    for (int candidate : candidates) {
-                        const int j = position[candidate];
-
-                        // Ensure we have a valid 2-opt move (i < j and not adjacent)
-                        if (EVOLAB_UNLIKELY(j <= i || j == i + 1 || (i == 0 && j == n - 1))) {
-                            continue;
-                        }
-
-                        const double gain = problem.two_opt_gain_cached(tour, i, j);
-
-                        // First improvement: apply first improving move immediately
-                        if (EVOLAB_UNLIKELY(gain > MIN_IMPROVEMENT_GAIN)) {
-                            problem.apply_two_opt(tour, i, j);
-                            current_fitness = core::Fitness{current_fitness.value - gain};
-                            improved = true;
-                            goto next_iteration;
-                        }
+            // Replace (pred, city), (other_pred, other) with (other, city), (pred, other_pred)
+            if (d_candidate < d_pred) {
+                const int other_pred = tour.prev(other);
+                if (EVOLAB_LIKELY(other != pred && other_pred != city)) {
+                    const Gain old_dist =
+                        d_pred + problem.cached_distance(distances, other_pred, other);
+                    const Gain new_dist =
+                        d_candidate + problem.cached_distance(distances, pred, other_pred);
+                    if (old_dist - new_dist > best.gain) {
+                        best = {other, pred, old_dist - new_dist};
+                        if constexpr (FirstImprovement)
+                            return best;
                     }
                 }
-            } else {
-                for (int i = 0; i < n; ++i) {
-                    const int city_i = tour[i];
-
-                    // Get candidates for city at position i
-                    const auto& candidates = candidate_list->get_candidates(city_i);
+            }
+        }
+        return best;
+    }
 
-                    for (int candidate : candidates) {
-                        const int j = position[candidate];
+    template <typename Dist, typename Tour>
+    core::Fitness improve_with(const problems::TSP& problem, const Dist& distances,
+                               const problems::TSP::GenomeT& genome, Tour& tour) const {
+        const int n = problem.num_cities();
+        problem.clear_distance_cache();
 
-                        // Ensure we have a valid 2-opt move (i < j and not adjacent)
-                        if (EVOLAB_UNLIKELY(j <= i || j == i + 1 || (i == 0 && j == n - 1))) {
-                            continue;
-                        }
+        // Get or create candidate list
+        const auto* candidate_list = problem.get_candidate_list(k_nearest_);
 
-                        const double gain = problem.two_opt_gain_cached(tour, i, j);
+        using gain_type = problems::storage::distance_sum_t<Dist>;
+        gain_type current_length = problem.tour_length(distances, genome);
 
-                        // Best improvement: track best move across all candidates
-                        if (gain > best_gain) {
-                            best_gain = gain;
-                            best_i = i;
-                            best_j = j;
-                        }
-                    }
-                }
+        // Queue in tour order so consecutive examinations touch nearby cities
+        detail::ActiveQueue active(n);
+        for (int city : genome) {
+            active.push(city);
+        }
 
-                // Apply best improvement if found
-                if (best_i != -1) {
-                    problem.apply_two_opt(tour, best_i, best_j);
-                    current_fitness = core::Fitness{current_fitness.value - best_gain};
-                    improved = true;
-                }
+        std::size_t moves = 0;
+        const std::size_t max_moves = static_cast<std::size_t>(n) * 10; // Prevent infinite loops
+
+        while (!active.empty() && moves < max_moves) {
+            const int city = active.pop();
+            // The branch is per city, outside the candidate loop
+            const auto move =
+                first_improvement_
+                    ? find_move<true, gain_type>(problem, distances, *candidate_list, tour, city)
+                    : find_move<false, gain_type>(problem, distances, *candidate_list, tour, city);
+            if (move.from < 0)
+                continue;
+
+            // The four cities whose tour edges change may have new improving moves
+            const int endpoints[] = {tour.prev(move.from), move.from, move.to,
+                                     tour.next(move.to)};
+
+            tour.flip(move.from, move.to);
+            current_length -= move.gain;
+            ++moves;
+
+            for (int endpoint : endpoints) {
+                active.push(endpoint);
             }
-
-        next_iteration:;
         }
 
-        return current_fitness;
+        return core::Fitness{static_cast<double>(current_length)};
     }
 
+  public:
     template <core::Problem P>
     core::Fitness improve(const P& problem, typename P::GenomeT& genome, std::mt19937& rng) const {
         if constexpr (std::is_same_v<P, problems::TSP>) {
@@ -313,6 +434,7 @@ class CandidateList2Opt {
   public:
     int k_nearest() const { return k_nearest_; }
     bool first_improvement() const { return first_improvement_; }
+    TourRepresentation representation() const { return representation_; }
 };
 
 /// No-op local search (for algorithms that don't use local search)
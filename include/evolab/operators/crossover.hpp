@@ -9,9 +9,9 @@
 #include <algorithm>
 #include <cassert>
 #include <climits>
+#include <cstdint>
+#include <numeric>
 #include <random>
-#include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -20,21 +20,51 @@
 
 namespace evolab::operators {
 
+namespace detail {
+
+/// Scratch buffer of the calling thread, reused across crossover calls
+///
+/// Operators are shared read-only by the threads of parallel offspring generation, so their
+/// working memory cannot live in the operator itself. Each (Owner, T, Slot) has its own buffer.
+template <typename Owner, typename T, int Slot = 0>
+std::vector<T>& thread_scratch() {
+    static thread_local std::vector<T> buffer;
+    return buffer;
+}
+
+} // namespace detail
+
 /// Partially Mapped Crossover (PMX) for permutations
+///
+/// Genes must be the integers [0, n), as in the permutation problems of this library.
 class PMXCrossover {
   public:
     template <core::Problem P>
     std::pair<typename P::GenomeT, typename P::GenomeT>
-    cross([[maybe_unused]] const P& problem, const typename P::GenomeT& parent1,
+    cross(const P& problem, const typename P::GenomeT& parent1,
           const typename P::GenomeT& parent2, std::mt19937& rng) const {
+        typename P::GenomeT child1;
+        typename P::GenomeT child2;
+        cross_into(problem, parent1, parent2, child1, child2, rng);
+        return {std::move(child1), std::move(child2)};
+    }
+
+    /// Write the children into child1 and child2, reusing their storage
+    template <core::Problem P>
+    void cross_into([[maybe_unused]] const P& problem, const typename P::GenomeT& parent1,
+                    const typename P::GenomeT& parent2, typename P::GenomeT& child1,
+                    typename P::GenomeT& child2, std::mt19937& rng) const {
 
         using GenomeT = typename P::GenomeT;
+        using Gene = typename P::Gene;
 
         assert(parent1.size() == parent2.size());
         const std::size_t n = parent1.size();
 
+        child1 = parent1;
+        child2 = parent2;
         if (n <= 2) {
-            return {parent1, parent2}; // Too small for meaningful crossover
+            return; // Too small for meaningful crossover
         }
 
         // Choose crossover points
@@ -44,11 +74,12 @@ class PMXCrossover {
         if (point1 > point2)
             std::swap(point1, point2);
 
-        GenomeT child1 = parent1;
-        GenomeT child2 = parent2;
-
-        // Create mapping from parent2 to parent1 in the crossover segment
-        std::unordered_map<typename P::Gene, typename P::Gene> mapping1, mapping2;
+        // Mapping from parent2 to parent1 (and back) in the crossover segment, indexed by gene
+        const auto unmapped = static_cast<Gene>(n);
+        auto& mapping1 = detail::thread_scratch<PMXCrossover, Gene, 0>();
+        auto& mapping2 = detail::thread_scratch<PMXCrossover, Gene, 1>();
+        mapping1.assign(n, unmapped);
+        mapping2.assign(n, unmapped);
 
         for (std::size_t i = point1; i <= point2; ++i) {
             if (parent1[i] != parent2[i]) {
@@ -64,42 +95,48 @@ class PMXCrossover {
         }
 
         // Fix conflicts outside crossover segment
-        auto fix_conflicts =
-            [point1,
-             point2](GenomeT& child,
-                     const std::unordered_map<typename P::Gene, typename P::Gene>& mapping) {
-                for (std::size_t i = 0; i < child.size(); ++i) {
-                    // Skip crossover segment - already set correctly
-                    if (i >= point1 && i <= point2)
-                        continue;
-
-                    auto current = child[i];
-                    std::unordered_set<typename P::Gene> visited;
-
-                    // Follow the mapping chain while detecting cycles
-                    while (mapping.find(current) != mapping.end() &&
-                           visited.find(current) == visited.end()) {
-                        visited.insert(current);
-                        current = mapping.at(current);
-                    }
-                    child[i] = current;
+        // A chain visits each mapped gene at most once, so its length is bounded by the segment
+        const std::size_t max_chain = point2 - point1 + 1;
+        auto fix_conflicts = [&](GenomeT& child, const std::vector<Gene>& mapping) {
+            for (std::size_t i = 0; i < n; ++i) {
+                // Skip crossover segment - already set correctly
+                if (i >= point1 && i <= point2)
+                    continue;
+
+                auto current = child[i];
+                for (std::size_t step = 0; step < max_chain && mapping[current] != unmapped;
+                     ++step) {
+                    current = mapping[current];
                 }
-            };
+                child[i] = current;
+            }
+        };
 
         fix_conflicts(child1, mapping1);
         fix_conflicts(child2, mapping2);
-
-        return {std::move(child1), std::move(child2)};
     }
 };
 
 /// Order Crossover (OX) for permutations
+///
+/// Genes must be the integers [0, n), as in the permutation problems of this library.
 class OrderCrossover {
   public:
     template <core::Problem P>
     std::pair<typename P::GenomeT, typename P::GenomeT>
-    cross([[maybe_unused]] const P& problem, const typename P::GenomeT& parent1,
+    cross(const P& problem, const typename P::GenomeT& parent1,
           const typename P::GenomeT& parent2, std::mt19937& rng) const {
+        typename P::GenomeT child1;
+        typename P::GenomeT child2;
+        cross_into(problem, parent1, parent2, child1, child2, rng);
+        return {std::move(child1), std::move(child2)};
+    }
+
+    /// Write the children into child1 and child2, reusing their storage
+    template <core::Problem P>
+    void cross_into([[maybe_unused]] const P& problem, const typename P::GenomeT& parent1,
+                    const typename P::GenomeT& parent2, typename P::GenomeT& child1,
+                    typename P::GenomeT& child2, std::mt19937& rng) const {
 
         using GenomeT = typename P::GenomeT;
         using Gene = typename P::Gene;
@@ -108,7 +145,9 @@ class OrderCrossover {
         const std::size_t n = parent1.size();
 
         if (n <= 2) {
-            return {parent1, parent2};
+            child1 = parent1;
+            child2 = parent2;
+            return;
         }
 
         // Choose crossover points
@@ -118,14 +157,15 @@ class OrderCrossover {
         if (point1 > point2)
             std::swap(point1, point2);
 
-        auto create_child = [&](const GenomeT& p1, const GenomeT& p2) {
-            GenomeT child(n);
+        auto& used = detail::thread_scratch<OrderCrossover, std::uint8_t>();
+        auto fill_child = [&](const GenomeT& p1, const GenomeT& p2, GenomeT& child) {
+            child.resize(n);
+            used.assign(n, 0);
 
             // Copy segment from first parent
-            std::unordered_set<Gene> used;
             for (std::size_t i = point1; i <= point2; ++i) {
                 child[i] = p1[i];
-                used.insert(p1[i]);
+                used[p1[i]] = 1;
             }
 
             // Fill remaining positions with elements from second parent in order
@@ -134,16 +174,15 @@ class OrderCrossover {
                 std::size_t parent_pos = (point2 + 1 + i) % n;
                 Gene gene = p2[parent_pos];
 
-                if (used.find(gene) == used.end()) {
+                if (!used[gene]) {
                     child[child_pos] = gene;
                     child_pos = (child_pos + 1) % n;
                 }
             }
-
-            return child;
         };
 
-        return {create_child(parent1, parent2), create_child(parent2, parent1)};
+        fill_child(parent1, parent2, child1);
+        fill_child(parent2, parent1, child2);
     }
 };
 
@@ -152,23 +191,36 @@ class CycleCrossover {
   public:
     template <core::Problem P>
     std::pair<typename P::GenomeT, typename P::GenomeT>
-    cross([[maybe_unused]] const P& problem, const typename P::GenomeT& parent1,
+    cross(const P& problem, const typename P::GenomeT& parent1,
           const typename P::GenomeT& parent2, std::mt19937& rng) const {
+        typename P::GenomeT child1;
+        typename P::GenomeT child2;
+        cross_into(problem, parent1, parent2, child1, child2, rng);
+        return {std::move(child1), std::move(child2)};
+    }
+
+    /// Write the children into child1 and child2, reusing their storage
+    template <core::Problem P>
+    void cross_into([[maybe_unused]] const P& problem, const typename P::GenomeT& parent1,
+                    const typename P::GenomeT& parent2, typename P::GenomeT& child1,
+                    typename P::GenomeT& child2, std::mt19937& rng) const {
 
-        using GenomeT = typename P::GenomeT;
         using Gene = typename P::Gene;
 
         assert(parent1.size() == parent2.size());
         const std::size_t n = parent1.size();
 
         if (n <= 1) {
-            return {parent1, parent2};
+            child1 = parent1;
+            child2 = parent2;
+            return;
         }
 
-        GenomeT child1 = parent2; // Start with parent2
-        GenomeT child2 = parent1; // Start with parent1
+        child1 = parent2; // Start with parent2
+        child2 = parent1; // Start with parent1
 
-        std::vector<bool> visited(n, false);
+        auto& visited = detail::thread_scratch<CycleCrossover, std::uint8_t>();
+        visited.assign(n, 0);
 
         for (std::size_t start = 0; start < n; ++start) {
             if (visited[start])
@@ -179,7 +231,7 @@ class CycleCrossover {
             bool use_parent1 = (std::uniform_int_distribution<int>(0, 1)(rng) == 0);
 
             do {
-                visited[pos] = true;
+                visited[pos] = 1;
 
                 if (use_parent1) {
                     child1[pos] = parent1[pos];
@@ -195,123 +247,133 @@ class CycleCrossover {
 
             } while (pos < n && !visited[pos]);
         }
-
-        return {std::move(child1), std::move(child2)};
     }
 };
 
-/// Edge Recombination Crossover for TSP-like problems
+/// Edge Recombination Crossover (ERX) for TSP-like problems
+///
+/// Genes must be the integers [0, n), as in the permutation problems of this library.
 class EdgeRecombinationCrossover {
   public:
     template <core::Problem P>
     std::pair<typename P::GenomeT, typename P::GenomeT>
-    cross([[maybe_unused]] const P& problem, const typename P::GenomeT& parent1,
+    cross(const P& problem, const typename P::GenomeT& parent1,
           const typename P::GenomeT& parent2, std::mt19937& rng) const {
+        typename P::GenomeT child1;
+        typename P::GenomeT child2;
+        cross_into(problem, parent1, parent2, child1, child2, rng);
+        return {std::move(child1), std::move(child2)};
+    }
 
-        using GenomeT = typename P::GenomeT;
-        using Gene = typename P::Gene;
-
+    /// Write the children into child1 and child2, reusing their storage
+    template <core::Problem P>
+    void cross_into([[maybe_unused]] const P& problem, const typename P::GenomeT& parent1,
+                    const typename P::GenomeT& parent2, typename P::GenomeT& child1,
+                    typename P::GenomeT& child2, std::mt19937& rng) const {
         assert(parent1.size() == parent2.size());
-        const std::size_t n = parent1.size();
 
-        if (n <= 2) {
-            return {parent1, parent2};
+        if (parent1.size() <= 2) {
+            child1 = parent1;
+            child2 = parent2;
+            return;
         }
 
-        auto create_child = [&](const GenomeT& p1, const GenomeT& p2) {
-            // Build edge table
-            std::unordered_map<Gene, std::unordered_set<Gene>> edges;
-
-            // Add edges from both parents
-            for (std::size_t i = 0; i < n; ++i) {
-                Gene current1 = p1[i];
-                Gene next1 = p1[(i + 1) % n];
-                Gene prev1 = p1[(i + n - 1) % n];
-
-                edges[current1].insert(next1);
-                edges[current1].insert(prev1);
+        build_child(parent1, parent2, child1, rng);
+        build_child(parent2, parent1, child2, rng);
+    }
 
-                Gene current2 = p2[i];
-                Gene next2 = p2[(i + 1) % n];
-                Gene prev2 = p2[(i + n - 1) % n];
+  private:
+    static constexpr std::size_t MAX_NEIGHBORS = 4; // Two in each parent
 
-                edges[current2].insert(next2);
-                edges[current2].insert(prev2);
+    template <typename GenomeT>
+    static void build_child(const GenomeT& p1, const GenomeT& p2, GenomeT& child,
+                            std::mt19937& rng) {
+        using Gene = typename GenomeT::value_type;
+        const std::size_t n = p1.size();
+
+        // Edge table: the distinct neighbors of city c in either parent, at c * MAX_NEIGHBORS
+        auto& neighbors = detail::thread_scratch<EdgeRecombinationCrossover, int, 0>();
+        auto& degree = detail::thread_scratch<EdgeRecombinationCrossover, int, 1>();
+        auto& candidates = detail::thread_scratch<EdgeRecombinationCrossover, int, 2>();
+        auto& used = detail::thread_scratch<EdgeRecombinationCrossover, std::uint8_t>();
+        neighbors.resize(n * MAX_NEIGHBORS);
+        degree.assign(n, 0);
+        used.assign(n, 0);
+
+        auto link = [&](int city, int other) {
+            int* list = neighbors.data() + static_cast<std::size_t>(city) * MAX_NEIGHBORS;
+            if (std::find(list, list + degree[city], other) == list + degree[city])
+                list[degree[city]++] = other;
+        };
+        for (const GenomeT* parent : {&p1, &p2}) {
+            const GenomeT& p = *parent;
+            for (std::size_t i = 0; i < n; ++i) {
+                link(static_cast<int>(p[i]), static_cast<int>(p[(i + 1) % n]));
+                link(static_cast<int>(p[i]), static_cast<int>(p[(i + n - 1) % n]));
             }
+        }
 
-            GenomeT child;
-            child.reserve(n);
-
-            std::unordered_set<Gene> used;
-
-            // Start with random city
-            std::uniform_int_distribution<std::size_t> start_dist(0, n - 1);
-            Gene current = p1[start_dist(rng)];
-            child.push_back(current);
-            used.insert(current);
-
-            while (child.size() < n) {
-                // Remove current city from all edge lists
-                for (auto& [city, adj] : edges) {
-                    adj.erase(current);
+        // Edge lists are symmetric, so a city is dropped from the lists of its own neighbors
+        auto remove = [&](int city) {
+            const int* own = neighbors.data() + static_cast<std::size_t>(city) * MAX_NEIGHBORS;
+            for (int k = 0; k < degree[city]; ++k) {
+                const int other = own[k];
+                int* list = neighbors.data() + static_cast<std::size_t>(other) * MAX_NEIGHBORS;
+                int* end = list + degree[other];
+                int* found = std::find(list, end, city);
+                if (found != end) {
+                    *found = *(end - 1);
+                    --degree[other];
                 }
+            }
+        };
 
-                // Find next city
-                Gene next;
-                bool found = false;
-
-                // Look for city with minimum available edges
-                int min_edges = INT_MAX;
-                std::vector<Gene> candidates;
-
-                for (Gene neighbor : edges[current]) {
-                    if (used.find(neighbor) == used.end()) {
-                        int edge_count = static_cast<int>(edges[neighbor].size());
-                        if (edge_count < min_edges) {
-                            min_edges = edge_count;
-                            candidates.clear();
-                            candidates.push_back(neighbor);
-                        } else if (edge_count == min_edges) {
-                            candidates.push_back(neighbor);
-                        }
-                    }
+        child.resize(n);
+
+        // Start with random city
+        std::uniform_int_distribution<std::size_t> start_dist(0, n - 1);
+        int current = static_cast<int>(p1[start_dist(rng)]);
+        child[0] = static_cast<Gene>(current);
+        used[current] = 1;
+
+        for (std::size_t filled = 1; filled < n; ++filled) {
+            remove(current);
+
+            // Look for the neighbor with the fewest remaining edges; the lists only hold
+            // unused cities
+            int min_edges = INT_MAX;
+            candidates.clear();
+            const int* own = neighbors.data() + static_cast<std::size_t>(current) * MAX_NEIGHBORS;
+            for (int k = 0; k < degree[current]; ++k) {
+                const int neighbor = own[k];
+                if (degree[neighbor] < min_edges) {
+                    min_edges = degree[neighbor];
+                    candidates.clear();
+                    candidates.push_back(neighbor);
+                } else if (degree[neighbor] == min_edges) {
+                    candidates.push_back(neighbor);
                 }
+            }
 
-                if (!candidates.empty()) {
-                    std::uniform_int_distribution<std::size_t> cand_dist(0, candidates.size() - 1);
-                    next = candidates[cand_dist(rng)];
-                    found = true;
+            // If no connected city available, choose random unused city
+            if (candidates.empty()) {
+                for (const auto city : p1) {
+                    if (!used[city])
+                        candidates.push_back(static_cast<int>(city));
                 }
-
-                // If no connected city available, choose random unused city
-                if (!found) {
-                    std::vector<Gene> unused;
-                    for (const auto& city : p1) {
-                        if (used.find(city) == used.end()) {
-                            unused.push_back(city);
-                        }
-                    }
-
-                    if (!unused.empty()) {
-                        std::uniform_int_distribution<std::size_t> unused_dist(0,
-                                                                               unused.size() - 1);
-                        next = unused[unused_dist(rng)];
-                    }
-                }
-
-                child.push_back(next);
-                used.insert(next);
-                current = next;
             }
 
-            return child;
-        };
-
-        return {create_child(parent1, parent2), create_child(parent2, parent1)};
+            std::uniform_int_distribution<std::size_t> pick(0, candidates.size() - 1);
+            current = candidates[pick(rng)];
+            child[filled] = static_cast<Gene>(current);
+            used[current] = 1;
+        }
     }
 };
 
 /// Edge Assembly Crossover (EAX) for TSP - high performance
+///
+/// Genes must be the integers [0, n), as in the permutation problems of this library.
 class EAXCrossover {
   private:
     double parent1_prob_;
@@ -332,163 +394,146 @@ class EAXCrossover {
         bool operator==(const Edge& other) const { return from == other.from && to == other.to; }
     };
 
-    struct EdgeHash {
-        std::size_t operator()(const Edge& e) const {
-            return std::hash<int>{}(e.from) ^ (std::hash<int>{}(e.to) << 1);
-        }
-    };
-
     template <core::Problem P>
     std::pair<typename P::GenomeT, typename P::GenomeT>
-    cross([[maybe_unused]] const P& problem, const typename P::GenomeT& parent1,
+    cross(const P& problem, const typename P::GenomeT& parent1,
           const typename P::GenomeT& parent2, std::mt19937& rng) const {
+        typename P::GenomeT child1;
+        typename P::GenomeT child2;
+        cross_into(problem, parent1, parent2, child1, child2, rng);
+        return {std::move(child1), std::move(child2)};
+    }
 
-        if (parent1.size() != parent2.size() || parent1.empty()) {
-            return {parent1, parent2};
-        }
-
+    /// Write the children into child1 and child2, reusing their storage
+    template <core::Problem P>
+    void cross_into([[maybe_unused]] const P& problem, const typename P::GenomeT& parent1,
+                    const typename P::GenomeT& parent2, typename P::GenomeT& child1,
+                    typename P::GenomeT& child2, std::mt19937& rng) const {
         // If parents are identical, return them directly
-        if (parent1 == parent2) {
-            return {parent1, parent2};
+        if (parent1.size() != parent2.size() || parent1.empty() || parent1 == parent2) {
+            child1 = parent1;
+            child2 = parent2;
+            return;
         }
 
-        [[maybe_unused]] const std::size_t n = parent1.size();
-
-        // Build edge sets for both parents
-        auto edges1 = build_edge_set(parent1);
-        auto edges2 = build_edge_set(parent2);
-
         // Generate offspring using EAX algorithm
-        auto offspring1 = generate_offspring(parent1, edges1, edges2, rng);
-        auto offspring2 = generate_offspring(parent2, edges2, edges1, rng);
-
-        return {offspring1, offspring2};
+        generate_offspring(parent1, parent2, child1, rng);
+        generate_offspring(parent2, parent1, child2, rng);
     }
 
   private:
-    template <typename GenomeT>
-    std::unordered_set<Edge, EdgeHash> build_edge_set(const GenomeT& tour) const {
-        std::unordered_set<Edge, EdgeHash> edges;
-        const std::size_t n = tour.size();
-
-        for (std::size_t i = 0; i < n; ++i) {
-            edges.insert(Edge(tour[i], tour[(i + 1) % n]));
-        }
-
-        return edges;
-    }
+    static constexpr std::size_t MAX_DEGREE = 4; // Two edges from each parent
 
     template <typename GenomeT>
-    GenomeT generate_offspring(const GenomeT& main_parent,
-                               const std::unordered_set<Edge, EdgeHash>& main_parent_edges,
-                               const std::unordered_set<Edge, EdgeHash>& other_parent_edges,
-                               std::mt19937& rng) const {
+    void generate_offspring(const GenomeT& main_parent, const GenomeT& other_parent,
+                            GenomeT& child, std::mt19937& rng) const {
         const std::size_t n = main_parent.size();
 
         // Fallback to simpler crossover if problem is too small
         if (n <= 4) {
-            return main_parent;
+            child = main_parent;
+            return;
         }
 
-        // Simplified EAX: randomly select edges from both parents
-        std::unordered_set<Edge, EdgeHash> offspring_edges;
-        offspring_edges.reserve(n);
-        std::bernoulli_distribution pick_main(parent1_prob_);
-        std::bernoulli_distribution pick_other(parent2_prob_);
+        // Neighbors in the main parent, to tell the other parent's own edges from shared ones
+        auto& main_next = detail::thread_scratch<EAXCrossover, int, 0>();
+        auto& main_prev = detail::thread_scratch<EAXCrossover, int, 1>();
+        main_next.resize(n);
+        main_prev.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const int city = static_cast<int>(main_parent[i]);
+            const int next = static_cast<int>(main_parent[(i + 1) % n]);
+            main_next[city] = next;
+            main_prev[next] = city;
+        }
 
-        // Combine edges from both parents with probability selection
-        for (const auto& edge : main_parent_edges) {
-            if (pick_main(rng)) {
-                offspring_edges.insert(edge);
+        // Candidate edges: the main parent's n edges, then those only the other parent has
+        auto& edges = detail::thread_scratch<EAXCrossover, Edge>();
+        edges.clear();
+        for (std::size_t i = 0; i < n; ++i) {
+            edges.emplace_back(main_parent[i], main_parent[(i + 1) % n]);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const int a = static_cast<int>(other_parent[i]);
+            const int b = static_cast<int>(other_parent[(i + 1) % n]);
+            if (main_next[a] != b && main_prev[a] != b) {
+                edges.emplace_back(a, b);
             }
         }
 
-        for (const auto& edge : other_parent_edges) {
-            if (main_parent_edges.find(edge) == main_parent_edges.end() && pick_other(rng)) {
-                offspring_edges.insert(edge);
+        // Simplified EAX: randomly select edges from both parents
+        auto& chosen = detail::thread_scratch<EAXCrossover, std::uint8_t>();
+        chosen.assign(edges.size(), 0);
+        std::size_t selected = 0;
+        std::bernoulli_distribution pick_main(parent1_prob_);
+        std::bernoulli_distribution pick_other(parent2_prob_);
+        for (std::size_t e = 0; e < edges.size(); ++e) {
+            if (e < n ? pick_main(rng) : pick_other(rng)) {
+                chosen[e] = 1;
+                ++selected;
             }
         }
 
         // If we have too few edges, add some from parents to reach n
-        if (offspring_edges.size() < n) {
-            std::vector<Edge> candidate_edges;
-            candidate_edges.reserve(main_parent_edges.size() + other_parent_edges.size());
-            candidate_edges.insert(candidate_edges.end(), main_parent_edges.begin(),
-                                   main_parent_edges.end());
-            for (const auto& edge : other_parent_edges) {
-                if (main_parent_edges.find(edge) == main_parent_edges.end()) {
-                    candidate_edges.push_back(edge);
+        if (selected < n) {
+            auto& order = detail::thread_scratch<EAXCrossover, std::size_t>();
+            order.resize(edges.size());
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::shuffle(order.begin(), order.end(), rng);
+            for (std::size_t k = 0; k < order.size() && selected < n; ++k) {
+                if (!chosen[order[k]]) {
+                    chosen[order[k]] = 1;
+                    ++selected;
                 }
             }
-            std::shuffle(candidate_edges.begin(), candidate_edges.end(), rng);
-
-            for (const auto& edge : candidate_edges) {
-                if (offspring_edges.size() >= n) {
-                    break;
-                }
-                offspring_edges.insert(edge);
-            }
         }
 
         // Construct tour from selected edges
-        return construct_tour_from_edges<GenomeT>(offspring_edges, n);
+        construct_tour_from_edges(edges, chosen, n, child);
     }
 
     template <typename GenomeT>
-    GenomeT construct_tour_from_edges(const std::unordered_set<Edge, EdgeHash>& edges,
-                                      std::size_t n) const {
-        GenomeT tour;
-        tour.reserve(n);
-
-        // Build adjacency list with bounds checking
-        // TODO: For large/dense graphs, consider pre-computing node degrees
-        // and reserving adj[i].reserve(degree[i]) to avoid vector reallocations
-        std::vector<std::vector<int>> adj(n);
-        for (const auto& edge : edges) {
-            // Validate edge indices to prevent out-of-bounds access
-            if (edge.from < 0 || edge.from >= static_cast<int>(n) || edge.to < 0 ||
-                edge.to >= static_cast<int>(n)) {
-                continue; // Skip invalid edges
-            }
-            adj[edge.from].push_back(edge.to);
-            adj[edge.to].push_back(edge.from);
+    static void construct_tour_from_edges(const std::vector<Edge>& edges,
+                                          const std::vector<std::uint8_t>& chosen,
+                                          std::size_t n, GenomeT& tour) {
+        using Gene = typename GenomeT::value_type;
+
+        // Adjacency of the selected edges: neighbors of city c at c * MAX_DEGREE
+        auto& adjacency = detail::thread_scratch<EAXCrossover, int, 2>();
+        auto& degree = detail::thread_scratch<EAXCrossover, int, 3>();
+        auto& visited = detail::thread_scratch<EAXCrossover, std::uint8_t, 1>();
+        adjacency.resize(n * MAX_DEGREE);
+        degree.assign(n, 0);
+        visited.assign(n, 0);
+        for (std::size_t e = 0; e < edges.size(); ++e) {
+            if (!chosen[e])
+                continue;
+            const int from = edges[e].from;
+            const int to = edges[e].to;
+            adjacency[static_cast<std::size_t>(from) * MAX_DEGREE + degree[from]++] = to;
+            adjacency[static_cast<std::size_t>(to) * MAX_DEGREE + degree[to]++] = from;
         }
 
-        // Follow path starting from a node with edges (avoid start-node bias)
-        std::vector<bool> visited(n, false);
+        // Follow path starting from the first node with edges
         int current = 0;
-
-        // Find first node with edges to avoid bias and immediate repair
-        // TODO: For even better randomization, randomly select among all nodes with edges
-        // and randomly choose neighbors during path construction
         for (int i = 0; i < static_cast<int>(n); ++i) {
-            if (!adj[i].empty()) {
+            if (degree[i] > 0) {
                 current = i;
                 break;
             }
         }
 
-        // Validate starting node
-        if (current < 0 || current >= static_cast<int>(n)) {
-            // Fallback: use identity permutation if invalid
-            for (int i = 0; i < static_cast<int>(n); ++i) {
-                tour.push_back(i);
-            }
-            return tour;
-        }
-        int path_iterations = 0;
-        const int max_path_iterations = static_cast<int>(n * 2);
-
-        while (tour.size() < n && path_iterations < max_path_iterations) {
-            tour.push_back(current);
-            visited[current] = true;
-            path_iterations++;
+        tour.clear();
+        while (tour.size() < n) {
+            tour.push_back(static_cast<Gene>(current));
+            visited[current] = 1;
 
-            // Find unvisited neighbor with bounds checking
+            // Find unvisited neighbor
             int next = -1;
-            for (int neighbor : adj[current]) {
-                if (neighbor >= 0 && neighbor < static_cast<int>(n) && !visited[neighbor]) {
-                    next = neighbor;
+            const int* own = adjacency.data() + static_cast<std::size_t>(current) * MAX_DEGREE;
+            for (int k = 0; k < degree[current]; ++k) {
+                if (!visited[own[k]]) {
+                    next = own[k];
                     break;
                 }
             }
@@ -497,8 +542,7 @@ class EAXCrossover {
                 // Path ended, repair by adding remaining cities in order
                 for (int i = 0; i < static_cast<int>(n); ++i) {
                     if (!visited[i]) {
-                        tour.push_back(i);
-                        visited[i] = true;
+                        tour.push_back(static_cast<Gene>(i));
                     }
                 }
                 break;
@@ -506,23 +550,6 @@ class EAXCrossover {
 
             current = next;
         }
-
-        // Final safety check: ensure all cities are included
-        if (tour.size() < n) {
-            std::vector<bool> in_tour(n, false);
-            for (int city : tour) {
-                if (city >= 0 && city < static_cast<int>(n)) {
-                    in_tour[city] = true;
-                }
-            }
-            for (int i = 0; i < static_cast<int>(n); ++i) {
-                if (!in_tour[i]) {
-                    tour.push_back(i);
-                }
-            }
-        }
-
-        return tour;
     }
 };
 
@@ -537,15 +564,23 @@ class UniformCrossover {
 
     template <core::Problem P>
     std::pair<typename P::GenomeT, typename P::GenomeT>
-    cross([[maybe_unused]] const P& problem, const typename P::GenomeT& parent1,
+    cross(const P& problem, const typename P::GenomeT& parent1,
           const typename P::GenomeT& parent2, std::mt19937& rng) const {
+        typename P::GenomeT child1;
+        typename P::GenomeT child2;
+        cross_into(problem, parent1, parent2, child1, child2, rng);
+        return {std::move(child1), std::move(child2)};
+    }
 
-        using GenomeT = typename P::GenomeT;
-
+    /// Write the children into child1 and child2, reusing their storage
+    template <core::Problem P>
+    void cross_into([[maybe_unused]] const P& problem, const typename P::GenomeT& parent1,
+                    const typename P::GenomeT& parent2, typename P::GenomeT& child1,
+                    typename P::GenomeT& child2, std::mt19937& rng) const {
         assert(parent1.size() == parent2.size());
 
-        GenomeT child1 = parent1;
-        GenomeT child2 = parent2;
+        child1 = parent1;
+        child2 = parent2;
 
         std::uniform_real_distribution<double> dist(0.0, 1.0);
 
@@ -554,8 +589,6 @@ class UniformCrossover {
                 std::swap(child1[i], child2[i]);
             }
         }
-
-        return {std::move(child1), std::move(child2)};
     }
 
     double probability() const { return probability_; }
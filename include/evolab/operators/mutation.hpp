@@ -5,10 +5,16 @@
 ///
 /// This header provides various mutation strategies optimized for different problem types.
 /// All operators follow concept-based design for type safety and performance.
+///
+/// Operators whose move touches O(1) edges (swap, inversion, insertion, displacement, 2-opt)
+/// also provide mutate_with_delta() for problems satisfying core::PermutationDeltaProblem.
+/// It applies the same move as mutate() and returns the fitness change, letting the GA score a
+/// mutated copy of a parent without a full evaluation.
 
 #include <algorithm>
 #include <numeric>
 #include <random>
+#include <utility>
 #include <vector>
 
 // EvoLab core concepts - required for template type constraints
@@ -25,16 +31,35 @@ class SwapMutation {
         if (genome.size() < 2)
             return;
 
-        std::uniform_int_distribution<std::size_t> dist(0, genome.size() - 1);
+        const auto [pos1, pos2] = draw_positions(genome.size(), rng);
+        std::swap(genome[pos1], genome[pos2]);
+    }
+
+    /// Swap mutation returning the fitness change
+    template <core::PermutationDeltaProblem P>
+    double mutate_with_delta(const P& problem, typename P::GenomeT& genome,
+                             std::mt19937& rng) const {
+        if (genome.size() < 2)
+            return 0.0;
+
+        const auto [pos1, pos2] = draw_positions(genome.size(), rng);
+        const double delta = problem.swap_delta(genome, pos1, pos2);
+        std::swap(genome[pos1], genome[pos2]);
+        return delta;
+    }
+
+  private:
+    static std::pair<std::size_t, std::size_t> draw_positions(std::size_t size,
+                                                              std::mt19937& rng) {
+        std::uniform_int_distribution<std::size_t> dist(0, size - 1);
         std::size_t pos1 = dist(rng);
         std::size_t pos2 = dist(rng);
 
         // Ensure different positions
-        while (pos1 == pos2 && genome.size() > 1) {
+        while (pos1 == pos2 && size > 1) {
             pos2 = dist(rng);
         }
-
-        std::swap(genome[pos1], genome[pos2]);
+        return {pos1, pos2};
     }
 };
 
@@ -47,14 +72,32 @@ class InversionMutation {
         if (genome.size() < 2)
             return;
 
-        std::uniform_int_distribution<std::size_t> dist(0, genome.size() - 1);
+        const auto [pos1, pos2] = draw_range(genome.size(), rng);
+        std::reverse(genome.begin() + pos1, genome.begin() + pos2 + 1);
+    }
+
+    /// Inversion mutation returning the fitness change
+    template <core::PermutationDeltaProblem P>
+    double mutate_with_delta(const P& problem, typename P::GenomeT& genome,
+                             std::mt19937& rng) const {
+        if (genome.size() < 2)
+            return 0.0;
+
+        const auto [pos1, pos2] = draw_range(genome.size(), rng);
+        const double delta = problem.reversal_delta(genome, pos1, pos2);
+        std::reverse(genome.begin() + pos1, genome.begin() + pos2 + 1);
+        return delta;
+    }
+
+  private:
+    static std::pair<std::size_t, std::size_t> draw_range(std::size_t size, std::mt19937& rng) {
+        std::uniform_int_distribution<std::size_t> dist(0, size - 1);
         std::size_t pos1 = dist(rng);
         std::size_t pos2 = dist(rng);
 
         if (pos1 > pos2)
             std::swap(pos1, pos2);
-
-        std::reverse(genome.begin() + pos1, genome.begin() + pos2 + 1);
+        return {pos1, pos2};
     }
 };
 
@@ -87,23 +130,46 @@ class InsertionMutation {
         if (genome.size() < 2)
             return;
 
-        std::uniform_int_distribution<std::size_t> dist(0, genome.size() - 1);
+        const auto [remove_pos, insert_pos] = draw_move(genome.size(), rng);
+        apply(genome, remove_pos, insert_pos);
+    }
+
+    /// Insertion mutation returning the fitness change
+    template <core::PermutationDeltaProblem P>
+    double mutate_with_delta(const P& problem, typename P::GenomeT& genome,
+                             std::mt19937& rng) const {
+        if (genome.size() < 2)
+            return 0.0;
+
+        const auto [remove_pos, insert_pos] = draw_move(genome.size(), rng);
+        const double delta = problem.segment_move_delta(genome, remove_pos, remove_pos, insert_pos);
+        apply(genome, remove_pos, insert_pos);
+        return delta;
+    }
+
+  private:
+    /// Draw (remove_pos, insert_pos), with insert_pos relative to the genome after removal
+    static std::pair<std::size_t, std::size_t> draw_move(std::size_t size, std::mt19937& rng) {
+        std::uniform_int_distribution<std::size_t> dist(0, size - 1);
         std::size_t remove_pos = dist(rng);
         std::size_t insert_pos = dist(rng);
 
         // Ensure different positions
-        while (remove_pos == insert_pos && genome.size() > 1) {
+        while (remove_pos == insert_pos && size > 1) {
             insert_pos = dist(rng);
         }
 
-        auto element = genome[remove_pos];
-        genome.erase(genome.begin() + remove_pos);
-
         // Adjust insertion position if necessary
         if (insert_pos > remove_pos) {
             insert_pos--;
         }
+        return {remove_pos, insert_pos};
+    }
 
+    template <typename GenomeT>
+    static void apply(GenomeT& genome, std::size_t remove_pos, std::size_t insert_pos) {
+        auto element = genome[remove_pos];
+        genome.erase(genome.begin() + remove_pos);
         genome.insert(genome.begin() + insert_pos, element);
     }
 };
@@ -117,7 +183,33 @@ class DisplacementMutation {
         if (genome.size() < 3)
             return;
 
-        std::uniform_int_distribution<std::size_t> dist(0, genome.size() - 1);
+        const auto move = draw_move(genome.size(), rng);
+        apply(genome, move);
+    }
+
+    /// Displacement mutation returning the fitness change
+    template <core::PermutationDeltaProblem P>
+    double mutate_with_delta(const P& problem, typename P::GenomeT& genome,
+                             std::mt19937& rng) const {
+        if (genome.size() < 3)
+            return 0.0;
+
+        const auto move = draw_move(genome.size(), rng);
+        const double delta =
+            problem.segment_move_delta(genome, move.start, move.end, move.insert_pos);
+        apply(genome, move);
+        return delta;
+    }
+
+  private:
+    struct Move {
+        std::size_t start;
+        std::size_t end;
+        std::size_t insert_pos; // Relative to the genome with [start, end] removed
+    };
+
+    static Move draw_move(std::size_t size, std::mt19937& rng) {
+        std::uniform_int_distribution<std::size_t> dist(0, size - 1);
 
         // Select a subsequence to displace
         std::size_t start = dist(rng);
@@ -128,12 +220,6 @@ class DisplacementMutation {
         // Select insertion point
         std::size_t insert_pos = dist(rng);
 
-        // Extract subsequence
-        typename P::GenomeT subsequence(genome.begin() + start, genome.begin() + end + 1);
-
-        // Remove subsequence from original position
-        genome.erase(genome.begin() + start, genome.begin() + end + 1);
-
         // Adjust insertion position relative to erased range
         const std::size_t seg_len = end - start + 1;
         if (insert_pos >= start && insert_pos <= end) {
@@ -141,10 +227,20 @@ class DisplacementMutation {
         } else if (insert_pos > end) {
             insert_pos -= seg_len;
         }
-        insert_pos = std::min<std::size_t>(insert_pos, genome.size());
+        insert_pos = std::min<std::size_t>(insert_pos, size - seg_len);
+        return {start, end, insert_pos};
+    }
+
+    template <typename GenomeT>
+    static void apply(GenomeT& genome, const Move& move) {
+        // Extract subsequence
+        GenomeT subsequence(genome.begin() + move.start, genome.begin() + move.end + 1);
+
+        // Remove subsequence from original position
+        genome.erase(genome.begin() + move.start, genome.begin() + move.end + 1);
 
         // Insert subsequence at new position
-        genome.insert(genome.begin() + insert_pos, subsequence.begin(), subsequence.end());
+        genome.insert(genome.begin() + move.insert_pos, subsequence.begin(), subsequence.end());
     }
 };
 
@@ -226,6 +322,21 @@ class MultiSwapMutation {
         }
     }
 
+    /// Multiple swaps returning the total fitness change
+    template <core::PermutationDeltaProblem P>
+    double mutate_with_delta(const P& problem, typename P::GenomeT& genome,
+                             std::mt19937& rng) const {
+        if (genome.size() < 2)
+            return 0.0;
+
+        SwapMutation swap;
+        double delta = 0.0;
+        for (std::size_t i = 0; i < num_swaps_; ++i) {
+            delta += swap.mutate_with_delta(problem, genome, rng);
+        }
+        return delta;
+    }
+
     std::size_t num_swaps() const { return num_swaps_; }
 };
 
@@ -238,20 +349,51 @@ class TwoOptMutation {
         if (genome.size() < 4)
             return; // Need at least 4 cities for 2-opt
 
-        std::uniform_int_distribution<std::size_t> dist(0, genome.size() - 1);
+        const auto [i, j] = draw_edges(genome.size(), rng);
+        apply(problem, genome, i, j);
+    }
+
+    /// 2-opt move returning the fitness change
+    template <core::PermutationDeltaProblem P>
+    double mutate_with_delta(const P& problem, typename P::GenomeT& genome,
+                             std::mt19937& rng) const {
+        if (genome.size() < 4)
+            return 0.0;
+
+        const auto [i, j] = draw_edges(genome.size(), rng);
+        const double delta = problem.reversal_delta(genome, i + 1, j);
+        apply(problem, genome, i, j);
+        return delta;
+    }
+
+  private:
+    /// Reverse the segment between i+1 and j
+    ///
+    /// Problems with cyclic tours provide apply_two_opt, which reverses the shorter of the
+    /// segment and the rest of the tour; for other permutations only the segment is the move.
+    template <typename P>
+    static void apply(const P& problem, typename P::GenomeT& genome, std::size_t i,
+                      std::size_t j) {
+        if constexpr (requires { problem.apply_two_opt(genome, 0, 0); }) {
+            problem.apply_two_opt(genome, static_cast<int>(i), static_cast<int>(j));
+        } else {
+            std::reverse(genome.begin() + i + 1, genome.begin() + j + 1);
+        }
+    }
+
+    static std::pair<std::size_t, std::size_t> draw_edges(std::size_t size, std::mt19937& rng) {
+        std::uniform_int_distribution<std::size_t> dist(0, size - 1);
         std::size_t i = dist(rng);
         std::size_t j = dist(rng);
 
         // Ensure valid 2-opt move (i and j shouldn't be adjacent)
-        while (i == j || (i + 1) % genome.size() == j || (j + 1) % genome.size() == i) {
+        while (i == j || (i + 1) % size == j || (j + 1) % size == i) {
             j = dist(rng);
         }
 
         if (i > j)
             std::swap(i, j);
-
-        // Apply 2-opt: reverse the segment between i+1 and j
-        std::reverse(genome.begin() + i + 1, genome.begin() + j + 1);
+        return {i, j};
     }
 };
 
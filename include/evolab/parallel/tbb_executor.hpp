@@ -108,11 +108,10 @@ class TBBExecutor {
             [&problem, &fitnesses, &population](const tbb::blocked_range<std::size_t>& range) {
                 // Process assigned range with thread-safe, cache-efficient evaluation
                 // Each thread writes to distinct indices, preventing data races
-                for (std::size_t i = range.begin(); i != range.end(); ++i) {
-                    // Direct fitness evaluation for deterministic algorithms
-                    // Optimized for performance-critical scientific computing
-                    fitnesses[i] = problem.evaluate(population[i]);
-                }
+                // Problems with evaluate_batch() score the whole range in one call
+                evolab::core::evaluate_all(
+                    problem, population.subspan(range.begin(), range.size()),
+                    std::span<Fitness>(fitnesses).subspan(range.begin(), range.size()));
             },
             tbb::static_partitioner{});
 
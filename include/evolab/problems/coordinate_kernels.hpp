@@ -0,0 +1,105 @@
+#pragma once
+
+/// @file coordinate_kernels.hpp
+/// @brief Row kernels computing many Euclidean-family distances from one node at once
+///
+/// Matrix construction evaluates d(i, j) for a whole row of j. For the Euclidean family of
+/// TSPLIB metrics (EUC_2D, CEIL_2D, ATT and unrounded Euclidean) the AVX2 kernel processes
+/// four nodes per iteration: two loads deinterleave the (x, y) pairs, and sqrt, division and
+/// rounding map to single instructions.
+///
+/// The kernel reproduces the scalar io::tsp_distance routines bit for bit only when
+/// dx² + dy² is exact, because the compiler may contract the scalar expression into an FMA.
+/// Callers therefore enable it only for integral coordinates of moderate magnitude
+/// (exact_squares), which covers the TSPLIB benchmark instances.
+
+#include <cmath>
+#include <cstddef>
+
+#include <evolab/utils/cpu_features.hpp>
+
+#ifdef EVOLAB_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace evolab::problems::kernels {
+
+/// Rounding applied to a Euclidean-family distance
+enum class Rounding {
+    None,    ///< Raw distance
+    Nearest, ///< std::round (halfway cases away from zero), as TSPLIB nint
+    Ceil     ///< std::ceil
+};
+
+/// Largest coordinate magnitude for which dx² + dy² is exact in double precision
+inline constexpr double EXACT_SQUARES_COORD_LIMIT = 16777216.0; // 2^24
+
+/// Whether all coordinates are integers with |c| <= 2^24, so squared differences are exact
+template <typename NodeRange>
+bool exact_squares(const NodeRange& nodes) noexcept {
+    for (const auto& node : nodes) {
+        for (double c : {node.x, node.y}) {
+            if (!(std::abs(c) <= EXACT_SQUARES_COORD_LIMIT) || std::trunc(c) != c)
+                return false;
+        }
+    }
+    return true;
+}
+
+#ifdef EVOLAB_X86_SIMD
+
+/// AVX2 row kernel: out[k] = R(sqrt((dx² + dy²) / Scale)) for nodes [first, first + count)
+///
+/// @param xy Interleaved node coordinates (x0, y0, x1, y1, ...)
+/// @pre exact_squares() holds for all nodes involved
+template <Rounding R, int Scale>
+__attribute__((target("avx2"))) void euclidean_row_avx2(double x, double y, const double* xy,
+                                                        std::size_t first, std::size_t count,
+                                                        double* out) noexcept {
+    const __m256d vx = _mm256_set1_pd(x);
+    const __m256d vy = _mm256_set1_pd(y);
+    const __m256d scale = _mm256_set1_pd(static_cast<double>(Scale));
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d one = _mm256_set1_pd(1.0);
+
+    std::size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        const double* p = xy + 2 * (first + k);
+        const __m256d a = _mm256_loadu_pd(p);     // x0 y0 x1 y1
+        const __m256d b = _mm256_loadu_pd(p + 4); // x2 y2 x3 y3
+        // Lanes are in node order 0 2 1 3 until the final permute
+        const __m256d dx = _mm256_sub_pd(vx, _mm256_unpacklo_pd(a, b));
+        const __m256d dy = _mm256_sub_pd(vy, _mm256_unpackhi_pd(a, b));
+        __m256d d = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        if constexpr (Scale != 1) {
+            d = _mm256_div_pd(d, scale);
+        }
+        d = _mm256_sqrt_pd(d);
+
+        if constexpr (R == Rounding::Nearest) {
+            // round(d) for d >= 0: floor, plus one if the (exact) fraction is >= 0.5
+            const __m256d floor = _mm256_round_pd(d, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            const __m256d up = _mm256_cmp_pd(_mm256_sub_pd(d, floor), half, _CMP_GE_OQ);
+            d = _mm256_add_pd(floor, _mm256_and_pd(up, one));
+        } else if constexpr (R == Rounding::Ceil) {
+            d = _mm256_round_pd(d, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+        }
+        _mm256_storeu_pd(out + k, _mm256_permute4x64_pd(d, 0xD8));
+    }
+
+    for (; k < count; ++k) {
+        const double dx = x - xy[2 * (first + k)];
+        const double dy = y - xy[2 * (first + k) + 1];
+        double d = std::sqrt((dx * dx + dy * dy) / static_cast<double>(Scale));
+        if constexpr (R == Rounding::Nearest) {
+            d = std::round(d);
+        } else if constexpr (R == Rounding::Ceil) {
+            d = std::ceil(d);
+        }
+        out[k] = d;
+    }
+}
+
+#endif // EVOLAB_X86_SIMD
+
+} // namespace evolab::problems::kernels
@@ -0,0 +1,525 @@
+#pragma once
+
+/// @file distance_storage.hpp
+/// @brief Distance storage back-ends for the TSP problem class
+///
+/// Each storage type is a small callable `value_type operator()(int i, int j) const` that the
+/// TSP class holds in a std::variant. Hot loops resolve the variant once (TSP::visit_distance)
+/// and are then instantiated per storage type, so the inner loops contain no runtime dispatch.
+///
+/// - DenseMatrix<T>: precomputed row-major n×n matrix, O(n²) memory, one load per lookup
+/// - PackedTriangular<T>: strict upper triangle only, n(n-1)/2 entries, for symmetric instances
+/// - CoordinateDistance<Metric>: node coordinates only, O(n) memory, distance computed on demand
+///   with the TSPLIB metric selected at compile time
+///
+/// Matrix element types may be double, float or std::int32_t. Narrower elements cut memory
+/// and bandwidth 2× (and 4× together with the packed layout), which matters once the matrix no
+/// longer fits in the last-level cache.
+///
+/// Back-ends whose value_type is integral (int32 matrices, rounded TSPLIB metrics) are summed
+/// and differenced in std::int64_t (see distance_sum_t), which makes tour lengths and 2-opt
+/// gains exact.
+///
+/// Matrix back-ends are immutable views with shared ownership of their entries, which are
+/// either an owned std::vector or a memory-mapped instance cache (io/instance_cache.hpp).
+///
+/// Matrices are built row-parallel (see utils::for_each_matrix_row). When the source is a
+/// CoordinateDistance, each pair is computed once and whole rows go through the vectorized
+/// kernels in coordinate_kernels.hpp. Candidate lists of planar metrics are built with a k-d
+/// tree (CoordinateDistance::nearest_neighbors) instead of scanning rows.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <evolab/io/tsplib.hpp>
+#include <evolab/problems/coordinate_kernels.hpp>
+#include <evolab/utils/compiler_hints.hpp>
+#include <evolab/utils/kd_tree.hpp>
+#include <evolab/utils/matrix_build.hpp>
+
+namespace evolab::problems::storage {
+
+/// Convert a distance to a matrix element type
+/// @throws std::invalid_argument if an integral element type cannot hold the value exactly
+template <typename T>
+T narrow_distance(double value) {
+    if constexpr (std::is_integral_v<T>) {
+        const bool in_range = value >= static_cast<double>(std::numeric_limits<T>::min()) &&
+                              value <= static_cast<double>(std::numeric_limits<T>::max());
+        if (!in_range || std::nearbyint(value) != value) {
+            throw std::invalid_argument("Distance " + std::to_string(value) +
+                                        " is not representable as an integer matrix element");
+        }
+    }
+    return static_cast<T>(value);
+}
+
+namespace detail {
+
+/// Distance sources that can fill a row segment at once: row(i, j_begin, j_end, out)
+template <typename DistanceFn>
+concept RowDistanceSource = requires(const DistanceFn& distance, int i, double* out) {
+    distance.row(i, i, i, out);
+};
+
+/// Distance sources guaranteeing distance(i, j) == distance(j, i)
+template <typename DistanceFn>
+concept SymmetricDistanceSource = requires { requires DistanceFn::symmetric; };
+
+/// Write distance(i, j) for j in [j_begin, j_end) to out, converted with narrow_distance
+template <typename T, typename DistanceFn>
+void fill_row(const DistanceFn& distance, int i, int j_begin, int j_end, T* out) {
+    if constexpr (RowDistanceSource<DistanceFn>) {
+        if constexpr (std::is_same_v<T, double>) {
+            distance.row(i, j_begin, j_end, out);
+        } else {
+            constexpr int BLOCK = 256;
+            double buffer[BLOCK];
+            for (int block = j_begin; block < j_end; block += BLOCK) {
+                const int count = std::min(BLOCK, j_end - block);
+                distance.row(i, block, block + count, buffer);
+                T* dst = out + (block - j_begin);
+                if constexpr (std::is_integral_v<T>) {
+                    // Branch-free check so the conversion vectorizes; narrow_distance reports
+                    // the first offending value
+                    constexpr double lo = static_cast<double>(std::numeric_limits<T>::min());
+                    constexpr double hi = static_cast<double>(std::numeric_limits<T>::max());
+                    bool exact = true;
+                    for (int k = 0; k < count; ++k) {
+                        const double value = buffer[k];
+                        const bool ok = value >= lo && value <= hi && std::trunc(value) == value;
+                        exact &= ok;
+                        dst[k] = static_cast<T>(ok ? value : 0.0);
+                    }
+                    if (EVOLAB_UNLIKELY(!exact)) {
+                        for (int k = 0; k < count; ++k) {
+                            dst[k] = narrow_distance<T>(buffer[k]);
+                        }
+                    }
+                } else {
+                    for (int k = 0; k < count; ++k) {
+                        dst[k] = static_cast<T>(buffer[k]);
+                    }
+                }
+            }
+        }
+    } else {
+        for (int j = j_begin; j < j_end; ++j) {
+            out[j - j_begin] = narrow_distance<T>(distance(i, j));
+        }
+    }
+}
+
+} // namespace detail
+
+/// Take shared ownership of entries and return a view of them
+/// Used in member initializers, so owner must be declared before the view it backs
+template <typename T>
+std::span<const T> share_entries(std::vector<T> entries, std::shared_ptr<const void>& owner) {
+    auto owned = std::make_shared<const std::vector<T>>(std::move(entries));
+    std::span<const T> view(*owned);
+    owner = std::move(owned);
+    return view;
+}
+
+/// Dense row-major distance matrix: dist(i, j) = data[i * n + j]
+template <typename T>
+class DenseMatrix {
+    int n_ = 0;
+    std::shared_ptr<const std::vector<T>> entries_; // Owned entries; null for views
+    std::shared_ptr<const void> owner_;             // Keeps a view's entries alive
+    std::span<const T> data_;                       // Declared last: initialized from the above
+
+  public:
+    using value_type = T;
+
+    DenseMatrix() = default;
+
+    DenseMatrix(int n, std::vector<T> data)
+        : n_(n), entries_(std::make_shared<const std::vector<T>>(std::move(data))),
+          data_(*entries_) {
+        assert(data_.size() == static_cast<std::size_t>(n) * static_cast<std::size_t>(n));
+    }
+
+    /// View over entries owned elsewhere, e.g. a memory-mapped instance cache
+    /// @param owner Kept alive as long as any copy of this matrix exists
+    DenseMatrix(int n, std::span<const T> data, std::shared_ptr<const void> owner)
+        : n_(n), owner_(std::move(owner)), data_(data) {
+        assert(data_.size() == static_cast<std::size_t>(n) * static_cast<std::size_t>(n));
+    }
+
+    /// Build by evaluating distance(i, j) for every ordered pair
+    ///
+    /// Rows are filled in parallel. Symmetric sources (coordinate back-ends) evaluate each
+    /// pair once (see utils::fill_symmetric_matrix).
+    /// @throws std::invalid_argument if a value does not fit the element type
+    template <typename DistanceFn>
+    static DenseMatrix from_function(int n, const DistanceFn& distance) {
+        std::vector<T> data(static_cast<std::size_t>(n) * static_cast<std::size_t>(n));
+        if constexpr (detail::SymmetricDistanceSource<DistanceFn>) {
+            auto fill_segment = [&](int i, int j_begin, int j_end, T* out) {
+                detail::fill_row(distance, i, j_begin, j_end, out);
+            };
+            utils::fill_symmetric_matrix(data.data(), n, fill_segment);
+        } else {
+            utils::for_each_matrix_row(n, [&](int i) {
+                detail::fill_row(distance, i, 0, n, data.data() + static_cast<std::size_t>(i) * n);
+            });
+        }
+        return DenseMatrix(n, std::move(data));
+    }
+
+    EVOLAB_FORCE_INLINE value_type operator()(int i, int j) const noexcept {
+        return data_[static_cast<std::size_t>(i) * n_ + j];
+    }
+
+    [[nodiscard]] int size() const noexcept { return n_; }
+    [[nodiscard]] std::span<const T> data() const noexcept { return data_; }
+    [[nodiscard]] std::size_t memory_bytes() const noexcept { return data_.size_bytes(); }
+
+    /// The entries as the vector they were built from, or nullptr for a view over entries
+    /// owned elsewhere
+    [[nodiscard]] const std::vector<T>* owned_entries() const noexcept { return entries_.get(); }
+};
+
+/// Packed strict upper triangle of a symmetric matrix
+///
+/// Entry (i, j) with i < j lives at row_offset[i] + j, where row_offset already accounts for
+/// the skipped lower triangle and diagonal, so a lookup is one min/max, one offset load and one
+/// element load. The diagonal is implicitly zero.
+template <typename T>
+class PackedTriangular {
+    int n_ = 0;
+    std::vector<std::ptrdiff_t> row_offset_;
+    std::shared_ptr<const void> owner_; // Keeps data_ alive; declared first, see share_entries
+    std::span<const T> data_;
+
+    void init_row_offsets() {
+        assert(data_.size() == packed_size(n_));
+        row_offset_.resize(static_cast<std::size_t>(std::max(n_, 0)));
+        std::ptrdiff_t row_start = 0;
+        for (int i = 0; i < n_; ++i) {
+            // Row i holds columns i+1 .. n-1
+            row_offset_[i] = row_start - (i + 1);
+            row_start += n_ - 1 - i;
+        }
+    }
+
+  public:
+    using value_type = T;
+
+    PackedTriangular() = default;
+
+    /// @param data Row-wise upper triangle: (0,1), (0,2), ..., (0,n-1), (1,2), ...
+    PackedTriangular(int n, std::vector<T> data)
+        : n_(n), data_(share_entries(std::move(data), owner_)) {
+        init_row_offsets();
+    }
+
+    /// View over a packed triangle owned elsewhere, e.g. a memory-mapped instance cache
+    /// @param owner Kept alive as long as any copy of this matrix exists
+    PackedTriangular(int n, std::span<const T> data, std::shared_ptr<const void> owner)
+        : n_(n), owner_(std::move(owner)), data_(data) {
+        init_row_offsets();
+    }
+
+    /// Build by evaluating distance(i, j) for i < j only (half the work of a dense build)
+    /// Rows are filled in parallel
+    /// @throws std::invalid_argument if a value does not fit the element type
+    template <typename DistanceFn>
+    static PackedTriangular from_function(int n, const DistanceFn& distance) {
+        std::vector<T> data(packed_size(n));
+        utils::for_each_matrix_row(n, [&](int i) {
+            // Rows 0 .. i-1 hold n-1, n-2, ..., n-i entries
+            const auto row = static_cast<std::size_t>(i);
+            const std::size_t row_start = row * n - row * (row + 1) / 2;
+            detail::fill_row(distance, i, i + 1, n, data.data() + row_start);
+        });
+        return PackedTriangular(n, std::move(data));
+    }
+
+    /// Number of stored entries for n cities: n(n-1)/2
+    static constexpr std::size_t packed_size(int n) noexcept {
+        return n > 1 ? static_cast<std::size_t>(n) * static_cast<std::size_t>(n - 1) / 2 : 0;
+    }
+
+    EVOLAB_FORCE_INLINE value_type operator()(int i, int j) const noexcept {
+        if (EVOLAB_UNLIKELY(i == j))
+            return value_type{0};
+        if (i > j)
+            std::swap(i, j);
+        return data_[static_cast<std::size_t>(row_offset_[i] + j)];
+    }
+
+    [[nodiscard]] int size() const noexcept { return n_; }
+    [[nodiscard]] std::span<const T> data() const noexcept { return data_; }
+    [[nodiscard]] std::size_t memory_bytes() const noexcept {
+        return data_.size_bytes() + row_offset_.size() * sizeof(std::ptrdiff_t);
+    }
+};
+
+// Coordinate metrics. Each provides a prepared Node type (so that per-node work such as the
+// GEO degree/radian conversion is done once) and a distance function identical to the
+// corresponding io::tsp_distance routine.
+
+/// Unrounded Euclidean distance (used by TSP's coordinate constructor)
+struct Euclidean2D {
+    using value_type = double;
+    struct Node {
+        double x, y;
+    };
+    // Row kernel parameters: R(sqrt((dx² + dy²) / squared_scale))
+    static constexpr kernels::Rounding rounding = kernels::Rounding::None;
+    static constexpr int squared_scale = 1;
+
+    static Node make_node(double x, double y) noexcept { return {x, y}; }
+
+    static EVOLAB_FORCE_INLINE value_type distance(const Node& a, const Node& b) noexcept {
+        return io::tsp_distance::euclidean_2d_raw(a.x, a.y, b.x, b.y);
+    }
+};
+
+/// TSPLIB EUC_2D: Euclidean distance rounded to nearest integer
+struct RoundedEuclidean2D {
+    using value_type = std::int64_t;
+    using Node = Euclidean2D::Node;
+    static constexpr kernels::Rounding rounding = kernels::Rounding::Nearest;
+    static constexpr int squared_scale = 1;
+
+    static Node make_node(double x, double y) noexcept { return {x, y}; }
+
+    static EVOLAB_FORCE_INLINE value_type distance(const Node& a, const Node& b) noexcept {
+        return static_cast<value_type>(io::tsp_distance::euclidean_2d(a.x, a.y, b.x, b.y));
+    }
+};
+
+/// TSPLIB CEIL_2D: Euclidean distance rounded up
+struct CeilEuclidean2D {
+    using value_type = std::int64_t;
+    using Node = Euclidean2D::Node;
+    static constexpr kernels::Rounding rounding = kernels::Rounding::Ceil;
+    static constexpr int squared_scale = 1;
+
+    static Node make_node(double x, double y) noexcept { return {x, y}; }
+
+    static EVOLAB_FORCE_INLINE value_type distance(const Node& a, const Node& b) noexcept {
+        return static_cast<value_type>(
+            std::ceil(io::tsp_distance::euclidean_2d_raw(a.x, a.y, b.x, b.y)));
+    }
+};
+
+/// TSPLIB ATT: pseudo-Euclidean distance
+struct PseudoEuclidean {
+    using value_type = std::int64_t;
+    using Node = Euclidean2D::Node;
+    static constexpr kernels::Rounding rounding = kernels::Rounding::Nearest;
+    static constexpr int squared_scale = 10;
+
+    static Node make_node(double x, double y) noexcept { return {x, y}; }
+
+    static EVOLAB_FORCE_INLINE value_type distance(const Node& a, const Node& b) noexcept {
+        return static_cast<value_type>(io::tsp_distance::att_distance(a.x, a.y, b.x, b.y));
+    }
+};
+
+/// TSPLIB GEO: great-circle distance on the idealized earth sphere
+/// Nodes store latitude/longitude already converted from DDD.MM to radians
+struct Geographic {
+    using value_type = std::int64_t;
+    struct Node {
+        double latitude, longitude;
+    };
+
+    static double to_radians(double deg) noexcept {
+        const int int_deg = static_cast<int>(deg);
+        const double min_part = deg - int_deg;
+        return std::numbers::pi * (int_deg + 5.0 * min_part / 3.0) / 180.0;
+    }
+
+    static Node make_node(double x, double y) noexcept { return {to_radians(x), to_radians(y)}; }
+
+    static EVOLAB_FORCE_INLINE value_type distance(const Node& a, const Node& b) noexcept {
+        constexpr double RRR = 6378.388;
+        const double q1 = std::cos(a.longitude - b.longitude);
+        const double q2 = std::cos(a.latitude - b.latitude);
+        const double q3 = std::cos(a.latitude + b.latitude);
+        return static_cast<value_type>(
+            std::floor(RRR * std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 0.5));
+    }
+};
+
+/// Coordinate-backed distance: O(n) memory, distance evaluated on demand with Metric
+template <typename Metric>
+class CoordinateDistance {
+  public:
+    using metric_type = Metric;
+    using value_type = typename Metric::value_type;
+    using Node = typename Metric::Node;
+
+    /// All supported metrics are symmetric; matrix builders compute each pair once
+    static constexpr bool symmetric = true;
+
+    /// Metrics of the Euclidean family are monotone in the planar distance, so nearest
+    /// neighbors can be found with a spatial index
+    static constexpr bool planar = requires { Metric::rounding; };
+
+  private:
+    /// Planar metrics can use the vectorized row kernel
+    static constexpr bool has_row_kernel = planar;
+
+    std::vector<Node> nodes_;
+    bool exact_squares_ = false; // Row kernel matches the scalar metric bit for bit
+
+    void finish_construction() {
+        if constexpr (has_row_kernel) {
+            exact_squares_ = kernels::exact_squares(nodes_);
+        }
+    }
+
+  public:
+    CoordinateDistance() = default;
+
+    /// Build from (x, y) pairs, applying the metric's per-node preparation
+    template <typename PointRange>
+    static CoordinateDistance from_points(const PointRange& points) {
+        CoordinateDistance result;
+        result.nodes_.reserve(std::size(points));
+        for (const auto& p : points) {
+            const auto& [x, y] = p;
+            result.nodes_.push_back(Metric::make_node(x, y));
+        }
+        result.finish_construction();
+        return result;
+    }
+
+    /// Build from TSPLIB node coordinates (z is ignored by all supported 2D metrics)
+    static CoordinateDistance from_tsplib(const io::TSPInstance& instance) {
+        CoordinateDistance result;
+        result.nodes_.reserve(instance.node_coords.size());
+        for (const auto& coord : instance.node_coords) {
+            result.nodes_.push_back(Metric::make_node(coord[0], coord[1]));
+        }
+        result.finish_construction();
+        return result;
+    }
+
+    EVOLAB_FORCE_INLINE value_type operator()(int i, int j) const noexcept {
+        // Match TSPInstance::calculate_distance, which defines d(i, i) = 0 for every metric
+        if (EVOLAB_UNLIKELY(i == j))
+            return value_type{0};
+        return Metric::distance(nodes_[i], nodes_[j]);
+    }
+
+    /// Write d(i, j) for j in [j_begin, j_end) to out (as double, exact for integral metrics)
+    void row(int i, int j_begin, int j_end, double* out) const noexcept {
+#ifdef EVOLAB_X86_SIMD
+        if constexpr (has_row_kernel) {
+            if (exact_squares_ && utils::detected_simd_level() != utils::SimdLevel::Scalar) {
+                static_assert(sizeof(Node) == 2 * sizeof(double));
+                kernels::euclidean_row_avx2<Metric::rounding, Metric::squared_scale>(
+                    nodes_[i].x, nodes_[i].y, reinterpret_cast<const double*>(nodes_.data()),
+                    static_cast<std::size_t>(j_begin), static_cast<std::size_t>(j_end - j_begin),
+                    out);
+                return;
+            }
+        }
+#endif
+        for (int j = j_begin; j < j_end; ++j) {
+            out[j - j_begin] = static_cast<double>((*this)(i, j));
+        }
+    }
+
+    /// k nearest neighbors of every node (0 < k < n), row-major n × k
+    ///
+    /// Each row is ordered by (distance, index), exactly as selecting from full distance rows
+    /// would order it, but the search runs on a k-d tree in O(n log n) overall: the k-th
+    /// nearest planar distance bounds the k-th metric value, and every node within the radius
+    /// of that bound (including all nodes tied with it after rounding) is ranked exactly.
+    /// Nodes are processed in tree order, in parallel for large n.
+    [[nodiscard]] std::vector<int> nearest_neighbors(int k) const
+        requires planar
+    {
+        const int n = size();
+        assert(k > 0 && k < n);
+        std::vector<int> neighbors(static_cast<std::size_t>(n) * k);
+
+        static_assert(sizeof(Node) == 2 * sizeof(double));
+        const utils::KdTree2D tree(
+            std::span<const double>(reinterpret_cast<const double*>(nodes_.data()), 2 * n));
+        const std::vector<int> order = tree.tree_order();
+        constexpr double scale = Metric::squared_scale;
+
+        utils::detail::for_each_range(
+            n, n >= utils::PARALLEL_MATRIX_MIN_DIMENSION, 256, [&](int begin, int end) {
+                std::vector<double> heap;
+                std::vector<std::pair<double, int>> ranked;
+                for (int p = begin; p < end; ++p) {
+                    const int i = order[p];
+                    // Largest planar distance whose metric value can equal the k-th smallest
+                    const double kth = std::sqrt(tree.kth_nearest_squared(i, k, heap) / scale);
+                    double bound = kth;
+                    if constexpr (Metric::rounding == kernels::Rounding::Nearest) {
+                        bound = std::round(kth) + 0.5;
+                    } else if constexpr (Metric::rounding == kernels::Rounding::Ceil) {
+                        bound = std::ceil(kth);
+                    }
+                    // Slack covers rounding differences between the tree and the metric
+                    const double radius_squared = bound * bound * scale * (1.0 + 1e-9);
+
+                    ranked.clear();
+                    tree.for_each_within(i, radius_squared, [&](int j) {
+                        ranked.emplace_back(static_cast<double>(Metric::distance(nodes_[i],
+                                                                                 nodes_[j])),
+                                            j);
+                    });
+                    assert(static_cast<int>(ranked.size()) >= k);
+                    std::partial_sort(ranked.begin(), ranked.begin() + k, ranked.end());
+                    std::transform(ranked.begin(), ranked.begin() + k,
+                                   neighbors.begin() + static_cast<std::ptrdiff_t>(i) * k,
+                                   [](const auto& entry) { return entry.second; });
+                }
+            });
+        return neighbors;
+    }
+
+    [[nodiscard]] int size() const noexcept { return static_cast<int>(nodes_.size()); }
+    [[nodiscard]] const std::vector<Node>& nodes() const noexcept { return nodes_; }
+    [[nodiscard]] std::size_t memory_bytes() const noexcept {
+        return nodes_.size() * sizeof(Node);
+    }
+};
+
+/// Arithmetic type for sums and differences of distances from Storage
+/// Integral back-ends use std::int64_t so tour lengths and gains are exact; others use double
+template <typename Storage>
+using distance_sum_t = std::conditional_t<std::is_integral_v<typename Storage::value_type>,
+                                          std::int64_t, double>;
+
+/// True for DenseMatrix back-ends, which the SIMD tour-length kernels operate on directly
+template <typename Storage>
+inline constexpr bool is_dense_matrix_v = false;
+
+template <typename T>
+inline constexpr bool is_dense_matrix_v<DenseMatrix<T>> = true;
+
+/// True for back-ends that compute distances on demand instead of storing them
+template <typename Storage>
+inline constexpr bool is_coordinate_storage_v = false;
+
+template <typename Metric>
+inline constexpr bool is_coordinate_storage_v<CoordinateDistance<Metric>> = true;
+
+} // namespace evolab::problems::storage
@@ -0,0 +1,198 @@
+#pragma once
+
+/// @file tour_length_kernels.hpp
+/// @brief Tour length kernels for dense distance matrices (scalar, AVX2, AVX-512)
+///
+/// A tour length is a sum of n matrix lookups at data-dependent addresses. The SIMD kernels
+/// compute eight edge indices at once and fetch them with hardware gathers; the scalar kernel
+/// walks the tour with eight independent accumulators.
+///
+/// All kernels use the same summation order: edge k (from tour[k] to tour[k+1], the closing
+/// edge being k = n-1) is added to lane k % 8, and the eight lanes are reduced in a fixed
+/// pairwise tree. Floating-point results are therefore bit-identical across ISAs, so the
+/// dispatch decision never changes a run's outcome.
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <evolab/utils/compiler_hints.hpp>
+#include <evolab/utils/cpu_features.hpp>
+
+#ifdef EVOLAB_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace evolab::problems::kernels {
+
+/// Number of partial sums shared by every kernel
+inline constexpr int TOUR_SUM_LANES = 8;
+
+/// Accumulator type for matrix element type T: exact int64 for integers, double otherwise
+template <typename T>
+using tour_sum_t = std::conditional_t<std::is_integral_v<T>, std::int64_t, double>;
+
+template <typename Sum>
+EVOLAB_FORCE_INLINE Sum reduce_lanes(const Sum* acc) noexcept {
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+}
+
+/// Add edges [k, n-1] to acc (k must be a multiple of TOUR_SUM_LANES) and reduce
+template <typename Sum, typename DistanceFn>
+EVOLAB_FORCE_INLINE Sum finish_tour_sum(Sum* acc, const DistanceFn& dist, const int* tour, int n,
+                                        int k) noexcept {
+    for (; k + 1 < n; ++k) {
+        acc[k % TOUR_SUM_LANES] += static_cast<Sum>(dist(tour[k], tour[k + 1]));
+    }
+    acc[k % TOUR_SUM_LANES] += static_cast<Sum>(dist(tour[n - 1], tour[0]));
+    return reduce_lanes(acc);
+}
+
+/// Portable kernel for any distance callable
+/// @pre n >= 1
+template <typename Sum, typename DistanceFn>
+Sum tour_length_scalar(const DistanceFn& dist, const int* tour, int n) noexcept {
+    Sum acc[TOUR_SUM_LANES] = {};
+    int k = 0;
+    for (; k + TOUR_SUM_LANES < n; k += TOUR_SUM_LANES) {
+        for (int lane = 0; lane < TOUR_SUM_LANES; ++lane) {
+            acc[lane] += static_cast<Sum>(dist(tour[k + lane], tour[k + lane + 1]));
+        }
+    }
+    return finish_tour_sum(acc, dist, tour, n, k);
+}
+
+/// Whether 32-bit gather indices can address an n×n matrix
+constexpr bool gather_indexable(int n) noexcept {
+    return static_cast<std::int64_t>(n) * n <= std::numeric_limits<std::int32_t>::max();
+}
+
+#ifdef EVOLAB_X86_SIMD
+
+/// AVX2 kernel: two 4-lane accumulators cover lanes 0-3 and 4-7
+/// @pre n >= 1 and gather_indexable(n)
+template <typename T>
+__attribute__((target("avx2"))) tour_sum_t<T> tour_length_avx2(const T* matrix, const int* tour,
+                                                               int n) noexcept {
+    using Sum = tour_sum_t<T>;
+    const __m256i vn = _mm256_set1_epi32(n);
+    // Masked gathers with an explicit zero source: the unmasked intrinsics start from an
+    // undefined vector, which GCC reports as maybe-uninitialized wherever they are inlined
+    const __m256i all = _mm256_set1_epi32(-1);
+    [[maybe_unused]] __m256d dlo = _mm256_setzero_pd(), dhi = _mm256_setzero_pd();
+    [[maybe_unused]] __m256i ilo = _mm256_setzero_si256(), ihi = _mm256_setzero_si256();
+
+    int k = 0;
+    for (; k + TOUR_SUM_LANES < n; k += TOUR_SUM_LANES) {
+        const __m256i from = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tour + k));
+        const __m256i to = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tour + k + 1));
+        const __m256i idx = _mm256_add_epi32(_mm256_mullo_epi32(from, vn), to);
+
+        if constexpr (std::is_same_v<T, double>) {
+            const __m256d mask = _mm256_castsi256_pd(all);
+            const __m128i lo = _mm256_castsi256_si128(idx);
+            const __m128i hi = _mm256_extracti128_si256(idx, 1);
+            dlo = _mm256_add_pd(dlo,
+                                _mm256_mask_i32gather_pd(_mm256_setzero_pd(), matrix, lo, mask, 8));
+            dhi = _mm256_add_pd(dhi,
+                                _mm256_mask_i32gather_pd(_mm256_setzero_pd(), matrix, hi, mask, 8));
+        } else if constexpr (std::is_same_v<T, float>) {
+            const __m256 v = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), matrix, idx,
+                                                      _mm256_castsi256_ps(all), 4);
+            dlo = _mm256_add_pd(dlo, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+            dhi = _mm256_add_pd(dhi, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+        } else {
+            static_assert(std::is_same_v<T, std::int32_t>, "Unsupported matrix element type");
+            const __m256i v = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), matrix, idx,
+                                                          all, 4);
+            ilo = _mm256_add_epi64(ilo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            ihi = _mm256_add_epi64(ihi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+    }
+
+    alignas(32) Sum acc[TOUR_SUM_LANES];
+    if constexpr (std::is_integral_v<T>) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(acc), ilo);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(acc + 4), ihi);
+    } else {
+        _mm256_store_pd(acc, dlo);
+        _mm256_store_pd(acc + 4, dhi);
+    }
+    auto dist = [matrix, n](int i, int j) { return matrix[static_cast<std::size_t>(i) * n + j]; };
+    return finish_tour_sum(acc, dist, tour, n, k);
+}
+
+/// AVX-512 kernel: one 8-lane accumulator
+/// @pre n >= 1 and gather_indexable(n)
+template <typename T>
+__attribute__((target("avx512f,avx2"))) tour_sum_t<T>
+tour_length_avx512(const T* matrix, const int* tour, int n) noexcept {
+    using Sum = tour_sum_t<T>;
+    const __m256i vn = _mm256_set1_epi32(n);
+    // Masked gathers and conversions with zero sources, as in tour_length_avx2
+    const __m256i all = _mm256_set1_epi32(-1);
+    [[maybe_unused]] __m512d dacc = _mm512_setzero_pd();
+    [[maybe_unused]] __m512i iacc = _mm512_setzero_si512();
+
+    int k = 0;
+    for (; k + TOUR_SUM_LANES < n; k += TOUR_SUM_LANES) {
+        const __m256i from = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tour + k));
+        const __m256i to = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tour + k + 1));
+        const __m256i idx = _mm256_add_epi32(_mm256_mullo_epi32(from, vn), to);
+
+        if constexpr (std::is_same_v<T, double>) {
+            dacc = _mm512_add_pd(
+                dacc, _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, idx, matrix, 8));
+        } else if constexpr (std::is_same_v<T, float>) {
+            const __m256 v = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), matrix, idx,
+                                                      _mm256_castsi256_ps(all), 4);
+            dacc = _mm512_add_pd(dacc, _mm512_maskz_cvtps_pd(0xFF, v));
+        } else {
+            static_assert(std::is_same_v<T, std::int32_t>, "Unsupported matrix element type");
+            const __m256i v =
+                _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), matrix, idx, all, 4);
+            iacc = _mm512_add_epi64(iacc, _mm512_maskz_cvtepi32_epi64(0xFF, v));
+        }
+    }
+
+    alignas(64) Sum acc[TOUR_SUM_LANES];
+    if constexpr (std::is_integral_v<T>) {
+        _mm512_store_si512(acc, iacc);
+    } else {
+        _mm512_store_pd(acc, dacc);
+    }
+    auto dist = [matrix, n](int i, int j) { return matrix[static_cast<std::size_t>(i) * n + j]; };
+    return finish_tour_sum(acc, dist, tour, n, k);
+}
+
+#endif // EVOLAB_X86_SIMD
+
+/// Tour length over a dense row-major n×n matrix using the requested ISA
+///
+/// Falls back to the scalar kernel when the level is not compiled in or the matrix is too
+/// large for 32-bit gather indices (n > 46340). Callers pass utils::detected_simd_level()
+/// unless they need to pin a level (e.g. for testing).
+/// @pre n >= 1 and level is supported by the running CPU
+template <typename T>
+tour_sum_t<T> dense_tour_length(const T* matrix, const int* tour, int n,
+                                utils::SimdLevel level) noexcept {
+#ifdef EVOLAB_X86_SIMD
+    if (EVOLAB_LIKELY(gather_indexable(n))) {
+        switch (level) {
+        case utils::SimdLevel::AVX512:
+            return tour_length_avx512(matrix, tour, n);
+        case utils::SimdLevel::AVX2:
+            return tour_length_avx2(matrix, tour, n);
+        default:
+            break;
+        }
+    }
+#else
+    (void)level;
+#endif
+    auto dist = [matrix, n](int i, int j) { return matrix[static_cast<std::size_t>(i) * n + j]; };
+    return tour_length_scalar<tour_sum_t<T>>(dist, tour, n);
+}
+
+} // namespace evolab::problems::kernels
@@ -10,36 +10,98 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <numeric>
 #include <optional>
 #include <random>
 #include <shared_mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <variant>
 #include <vector>
 
 // EvoLab dependencies - core concepts and supporting utilities
 #include <evolab/core/concepts.hpp>        // Type constraints for problem interface
+#include <evolab/io/instance_cache.hpp>    // Memory-mapped binary instance cache
 #include <evolab/io/tsplib.hpp>            // TSPLIB file format support
+#include <evolab/problems/distance_storage.hpp> // Matrix and coordinate back-ends
+#include <evolab/problems/tour_length_kernels.hpp> // SIMD tour evaluation
 #include <evolab/utils/candidate_list.hpp> // Performance optimization for local search
 #include <evolab/utils/compiler_hints.hpp> // Branch prediction hints
-#include <evolab/utils/distance_cache.hpp> // Distance lookup cache
+#include <evolab/utils/cpu_features.hpp>   // Runtime ISA selection for kernels
+#include <evolab/utils/distance_cache.hpp> // Per-thread distance lookup caches
+#include <evolab/utils/space_filling_curve.hpp> // Locality-preserving city renumbering
+#include <evolab/utils/tour_reversal.hpp>  // Shorter-side 2-opt reversal
 
 namespace evolab::problems {
 
+/// How distances are stored for a TSP instance
+enum class DistanceMode {
+    Matrix, ///< Precompute the full n×n matrix (O(n²) memory, fastest lookups)
+    Lazy    ///< Keep coordinates only and compute distances on demand (O(n) memory)
+};
+
+/// Layout of a precomputed distance matrix
+enum class MatrixLayout {
+    Full,      ///< Row-major n×n matrix
+    Triangular ///< Packed upper triangle, n(n-1)/2 entries (symmetric instances only)
+};
+
+/// Element type of a precomputed distance matrix
+enum class DistancePrecision {
+    Auto,    ///< from_tsplib: Int32 for metrics that round to integers; Float64 otherwise
+    Float64, ///< double, exact for any metric
+    Float32, ///< float, half the memory; distances are rounded to ~7 significant digits
+    Int32    ///< std::int32_t, half the memory and exact for integral (rounded) metrics
+};
+
+/// City numbering used inside a TSP built by from_tsplib
+enum class CityOrdering {
+    Original, ///< Ids of the source instance
+    Hilbert,  ///< Renumbered along a Hilbert curve through the coordinates
+    Morton    ///< Renumbered along a Morton (Z-order) curve through the coordinates
+};
+
+/// Distance storage selection for TSP construction
+/// layout and precision apply to DistanceMode::Matrix; lazy instances keep double coordinates
+struct DistanceOptions {
+    DistanceMode mode = DistanceMode::Matrix;
+    MatrixLayout layout = MatrixLayout::Full;
+    DistancePrecision precision = DistancePrecision::Auto;
+    CityOrdering ordering = CityOrdering::Original;
+};
+
 /// Traveling Salesman Problem implementation
 class TSP {
   public:
     using Gene = int;
     using GenomeT = std::vector<int>;
 
+    /// All supported distance back-ends; see distance_storage.hpp
+    using DistanceStorage =
+        std::variant<storage::DenseMatrix<double>, storage::DenseMatrix<float>,
+                     storage::DenseMatrix<std::int32_t>, storage::PackedTriangular<double>,
+                     storage::PackedTriangular<float>, storage::PackedTriangular<std::int32_t>,
+                     storage::CoordinateDistance<storage::Euclidean2D>,
+                     storage::CoordinateDistance<storage::RoundedEuclidean2D>,
+                     storage::CoordinateDistance<storage::CeilEuclidean2D>,
+                     storage::CoordinateDistance<storage::PseudoEuclidean>,
+                     storage::CoordinateDistance<storage::Geographic>>;
+
   private:
-    int n_;
-    std::vector<double> distances_; // Row-major: dist[i*n + j]
+    int n_ = 0;
+    DistanceStorage distances_; // Matrix (dense or packed) or coordinate-backed metric
     mutable std::unordered_map<int, utils::CandidateList> candidate_lists_;
-    mutable std::shared_mutex candidate_lists_mutex_;     // RW lock for candidate list cache
-    mutable utils::DistanceCache<double> distance_cache_; // Cache for local search
+    mutable std::shared_mutex candidate_lists_mutex_; // RW lock for candidate list cache
+    mutable utils::ThreadDistanceCaches<double> distance_caches_; // Local search, per thread
+    std::vector<int> original_ids_; // Internal city -> source instance id; empty if identical
+    mutable std::once_flag dense_copy_once_; // Guards dense_copy_
+    mutable std::vector<double> dense_copy_; // distance_matrix() of non-Float64 storage
 
     /// Normalize k to match CandidateList constructor semantics
     /// Prevents duplicate cache entries for invalid k values that get clamped
@@ -51,35 +113,92 @@ class TSP {
         return k;
     }
 
+    /// Construct a renumbered instance (from_tsplib with a CityOrdering)
+    TSP(int n, DistanceStorage distances, std::vector<int> original_ids)
+        : n_(n), distances_(std::move(distances)), original_ids_(std::move(original_ids)) {}
+
+    /// Construct with a precomputed candidate list (from_cache)
+    TSP(int n, DistanceStorage distances, std::optional<utils::CandidateList> candidates)
+        : n_(n), distances_(std::move(distances)) {
+        if (candidates) {
+            const int k = candidates->k();
+            candidate_lists_.try_emplace(k, std::move(*candidates));
+        }
+    }
+
   public:
     TSP() = default;
 
     /// Construct TSP with distance matrix
-    TSP(int n, std::vector<double> distances) : n_(n), distances_(std::move(distances)) {
-        assert(distances_.size() == static_cast<std::size_t>(n * n));
+    TSP(int n, std::vector<double> distances)
+        : n_(n), distances_(storage::DenseMatrix<double>(n, std::move(distances))) {}
+
+    /// Construct TSP from a row-major distance matrix, converted to the requested layout
+    /// @throws std::invalid_argument if options.precision is Int32 and a distance is not integral
+    TSP(int n, const std::vector<double>& distances, const DistanceOptions& options)
+        : n_(n) {
+        assert(distances.size() == static_cast<std::size_t>(n) * static_cast<std::size_t>(n));
+        distances_ = make_matrix_storage(n, options, [&distances, n](int i, int j) {
+            return distances[static_cast<std::size_t>(i) * n + j];
+        });
     }
 
+    /// Construct TSP from any distance back-end
+    TSP(int n, DistanceStorage distances) : n_(n), distances_(std::move(distances)) {}
+
     /// Construct TSP from city coordinates (Euclidean distances)
-    TSP(const std::vector<std::pair<double, double>>& cities)
-        : n_(static_cast<int>(cities.size())), distances_(cities.size() * cities.size()) {
-
-        for (int i = 0; i < n_; ++i) {
-            for (int j = 0; j < n_; ++j) {
-                if (i == j) {
-                    distances_[i * n_ + j] = 0.0;
-                } else {
-                    double dx = cities[i].first - cities[j].first;
-                    double dy = cities[i].second - cities[j].second;
-                    distances_[i * n_ + j] = std::sqrt(dx * dx + dy * dy);
-                }
-            }
+    /// @param mode Matrix precomputes all n² distances; Lazy keeps only the coordinates
+    TSP(const std::vector<std::pair<double, double>>& cities,
+        DistanceMode mode = DistanceMode::Matrix)
+        : n_(static_cast<int>(cities.size())) {
+        auto coords = storage::CoordinateDistance<storage::Euclidean2D>::from_points(cities);
+        if (mode == DistanceMode::Lazy) {
+            distances_ = std::move(coords);
+            return;
+        }
+
+        distances_ = storage::DenseMatrix<double>::from_function(n_, coords);
+    }
+
+    /// Construct TSP from city coordinates with an explicit storage selection
+    /// @throws std::invalid_argument if options.precision is Int32 (Euclidean is not integral)
+    TSP(const std::vector<std::pair<double, double>>& cities, const DistanceOptions& options)
+        : n_(static_cast<int>(cities.size())) {
+        auto coords = storage::CoordinateDistance<storage::Euclidean2D>::from_points(cities);
+        if (options.mode == DistanceMode::Lazy) {
+            distances_ = std::move(coords);
+        } else {
+            distances_ = make_matrix_storage(n_, options, coords);
         }
     }
 
     /// Create TSP from TSPLIB instance
     /// Factory method that creates a TSP problem from a parsed TSPLIB instance
     /// This enables integration with the standard TSPLIB test suite
-    static TSP from_tsplib(const io::TSPInstance& instance) {
+    ///
+    /// @param mode DistanceMode::Lazy keeps only node coordinates and is supported for
+    ///        EUC_2D, CEIL_2D, GEO and ATT instances; it makes 100k-city instances feasible
+    /// @throws io::TSPLIBDataError if the instance is invalid or Lazy mode is unsupported
+    static TSP from_tsplib(const io::TSPInstance& instance,
+                           DistanceMode mode = DistanceMode::Matrix) {
+        return from_tsplib(instance, DistanceOptions{.mode = mode});
+    }
+
+    /// Create TSP from TSPLIB instance with an explicit storage selection
+    ///
+    /// Matrices are built straight from the instance without an intermediate double matrix,
+    /// in parallel and, for coordinate metrics, computing each pair once with vectorized row
+    /// kernels.
+    /// With DistancePrecision::Auto (the default), instances whose EDGE_WEIGHT_TYPE rounds to
+    /// integers (EUC_2D, EUC_3D, CEIL_2D, GEO, ATT) get an int32 matrix, so tour lengths and
+    /// 2-opt gains are computed exactly in 64-bit integer arithmetic.
+    /// With a CityOrdering other than Original, coordinate instances are renumbered along the
+    /// curve before the storage is built, so nearby cities get nearby ids and matrix rows.
+    /// Tours are then in internal ids; to_original() maps them back (the GA does so for its
+    /// result). Explicit-weight instances have no coordinates and keep their numbering.
+    /// @throws io::TSPLIBDataError if the instance is invalid, Lazy mode is unsupported, or
+    ///         Int32 precision is requested for non-integral distances
+    static TSP from_tsplib(const io::TSPInstance& instance, const DistanceOptions& options) {
         // Validate that this is actually a TSP problem (not ATSP, HCP, or SOP)
         if (instance.type != io::TSPType::TSP) {
             std::string type_name;
@@ -114,50 +233,281 @@ class TSP {
                 "TSP instance has neither node coordinates nor explicit distance matrix");
         }
 
-        // Get distance matrix and create TSP instance
-        auto distances = instance.get_full_distance_matrix();
-        return TSP(instance.dimension, std::move(distances));
+        if (options.ordering == CityOrdering::Original ||
+            instance.edge_weight_type == io::EdgeWeightType::EXPLICIT ||
+            instance.node_coords.size() != static_cast<std::size_t>(instance.dimension)) {
+            return TSP(instance.dimension, make_tsplib_storage(instance, options));
+        }
+
+        auto order = utils::curve_order(instance.node_coords,
+                                        options.ordering == CityOrdering::Hilbert
+                                            ? utils::SpaceFillingCurve::Hilbert
+                                            : utils::SpaceFillingCurve::Morton);
+        auto storage = make_tsplib_storage(renumber_instance(instance, order), options);
+        return TSP(instance.dimension, std::move(storage), std::move(order));
+    }
+
+    /// Open a TSP from a memory-mapped instance cache (see write_cache)
+    ///
+    /// Cached matrices are used in place: the back-end is a view into the mapping, which stays
+    /// mapped for the lifetime of the TSP. Cached candidate lists are adopted, so
+    /// get_candidate_list() with the cached k does not rebuild them.
+    /// @throws io::InstanceCacheError if the cache holds neither a matrix nor coordinates
+    static TSP from_cache(const io::InstanceCache& cache) {
+        const int n = cache.dimension();
+        auto view = [&]<typename T>() -> DistanceStorage {
+            if (cache.layout() == io::CacheMatrixLayout::Triangular) {
+                return storage::PackedTriangular<T>(n, cache.matrix<T>(), cache.keep_alive());
+            }
+            return storage::DenseMatrix<T>(n, cache.matrix<T>(), cache.keep_alive());
+        };
+
+        DistanceStorage distances;
+        switch (cache.element_type()) {
+        case io::CacheElementType::Float64:
+            distances = view.template operator()<double>();
+            break;
+        case io::CacheElementType::Float32:
+            distances = view.template operator()<float>();
+            break;
+        case io::CacheElementType::Int32:
+            distances = view.template operator()<std::int32_t>();
+            break;
+        case io::CacheElementType::None:
+        default:
+            if (cache.node_coords().empty()) {
+                throw io::InstanceCacheError("Cache holds neither a matrix nor coordinates");
+            }
+            distances = make_coordinate_storage(cache.instance());
+            break;
+        }
+
+        // Candidate distances are looked up again (O(nk)); only the neighbor ids are cached.
+        // The ids index the matrix and tour position arrays, so a corrupt file must not get
+        // past this point.
+        std::optional<utils::CandidateList> candidates;
+        if (cache.candidate_k() > 0) {
+            const auto ids = cache.candidates();
+            const auto k = static_cast<std::size_t>(cache.candidate_k());
+            for (std::size_t index = 0; index < ids.size(); ++index) {
+                const int id = ids[index];
+                if (id < 0 || id >= n || static_cast<std::size_t>(id) == index / k) {
+                    throw io::InstanceCacheError("Cache holds an invalid candidate list entry");
+                }
+            }
+            candidates = std::visit(
+                [&](const auto& dist) {
+                    return utils::CandidateList::from_neighbors(
+                        n, cache.candidate_k(), cache.candidates(),
+                        [&dist](int i, int j) { return static_cast<double>(dist(i, j)); });
+                },
+                distances);
+        }
+        return TSP(n, std::move(distances), std::move(candidates));
+    }
+
+    /// Invoke f with the concrete distance back-end
+    ///
+    /// This is the entry point for hot loops: the variant is resolved once and f is
+    /// instantiated per back-end, so calls to dist(i, j) inside f compile to a direct matrix
+    /// load or an inlined metric evaluation without any per-call dispatch.
+    template <typename F>
+    decltype(auto) visit_distance(F&& f) const {
+        return std::visit(std::forward<F>(f), distances_);
     }
 
     /// Get distance between two cities
+    /// Dispatches on the storage back-end per call; use visit_distance() in tight loops
     double distance(int i, int j) const noexcept {
         assert(i >= 0 && i < n_ && j >= 0 && j < n_);
-        return distances_[i * n_ + j];
+        return visit_distance([i, j](const auto& dist) { return static_cast<double>(dist(i, j)); });
+    }
+
+    /// Whether distances are computed on demand from coordinates (DistanceMode::Lazy)
+    bool is_lazy() const noexcept {
+        return visit_distance([](const auto& dist) {
+            return storage::is_coordinate_storage_v<std::decay_t<decltype(dist)>>;
+        });
+    }
+
+    /// Whether all distances are integers, making evaluate() and 2-opt gains exact
+    /// True for int32 matrices and for lazy instances with a rounded TSPLIB metric
+    bool has_integral_distances() const noexcept {
+        return visit_distance([](const auto& dist) {
+            return std::is_integral_v<typename std::decay_t<decltype(dist)>::value_type>;
+        });
+    }
+
+    /// Bytes held by the distance back-end (matrix entries, or n nodes for lazy mode)
+    std::size_t distance_memory_bytes() const noexcept {
+        return visit_distance([](const auto& dist) { return dist.memory_bytes(); });
+    }
+
+    /// Write this instance to a binary cache file for from_cache
+    ///
+    /// Stores the distance back-end as is (lazy instances store coordinates only), the
+    /// instance's header and coordinates, and optionally the candidate lists for one k.
+    /// @param instance The TSPLIB instance this TSP was created from
+    /// @param source_hash Key of the source, typically io::hash_file() of the .tsp file
+    /// @param candidate_k Candidate list size to store (built if needed); 0 stores none
+    /// @throws std::system_error if the file cannot be written
+    /// @throws std::logic_error if the instance is renumbered; caches hold source ids only
+    void write_cache(const std::string& path, const io::TSPInstance& instance,
+                     std::uint64_t source_hash, int candidate_k = 0) const {
+        if (is_renumbered()) {
+            throw std::logic_error("Renumbered TSP instances cannot be written to a cache");
+        }
+        io::InstanceCacheContents contents;
+        contents.source_hash = source_hash;
+        contents.name = instance.name;
+        contents.comment = instance.comment;
+        contents.type = instance.type;
+        contents.edge_weight_type = instance.edge_weight_type;
+        contents.dimension = n_;
+        if (instance.node_coords.size() == static_cast<std::size_t>(n_)) {
+            contents.node_coords = instance.node_coords;
+        }
+
+        visit_distance([&](const auto& dist) {
+            using Dist = std::decay_t<decltype(dist)>;
+            if constexpr (!storage::is_coordinate_storage_v<Dist>) {
+                using T = typename Dist::value_type;
+                contents.element_type = std::is_same_v<T, double>  ? io::CacheElementType::Float64
+                                        : std::is_same_v<T, float> ? io::CacheElementType::Float32
+                                                                   : io::CacheElementType::Int32;
+                contents.layout = storage::is_dense_matrix_v<Dist>
+                                      ? io::CacheMatrixLayout::Full
+                                      : io::CacheMatrixLayout::Triangular;
+                contents.matrix = std::as_bytes(dist.data());
+            }
+        });
+
+        std::vector<int> neighbors;
+        if (candidate_k > 0 && n_ > 1) {
+            const auto* list = get_candidate_list(candidate_k);
+            neighbors.reserve(static_cast<std::size_t>(n_) * list->k());
+            for (int city = 0; city < n_; ++city) {
+                const auto& row = list->get_candidates(city);
+                neighbors.insert(neighbors.end(), row.begin(), row.end());
+            }
+            contents.candidate_k = list->k();
+            contents.candidates = neighbors;
+        }
+
+        io::write_instance_cache(path, contents);
     }
 
     /// Get distance with cache (for local search hot paths)
     /// Significantly reduces memory latency in tight loops
     /// Canonicalizes indices for symmetric TSP to improve cache hit rate
-    double cached_distance(int i, int j) const noexcept {
+    /// Every thread uses its own cache, so concurrent local searches do not contend
+    /// @throws std::bad_alloc if the calling thread's first lookup cannot allocate its cache
+    double cached_distance(int i, int j) const {
+        return visit_distance(
+            [&](const auto& dist) { return static_cast<double>(cached_distance(dist, i, j)); });
+    }
+
+    /// Cached distance against an already resolved back-end (see visit_distance)
+    /// Returns std::int64_t for integral back-ends (exact, see storage::distance_sum_t)
+    template <typename Dist>
+    EVOLAB_FORCE_INLINE storage::distance_sum_t<Dist> cached_distance(const Dist& dist, int i,
+                                                                       int j) const {
         // Canonicalize indices for symmetric TSP: ensure i <= j
         // This doubles the cache hit rate by treating (i,j) and (j,i) as same entry
         if (i > j)
             std::swap(i, j);
 
+        // The cache holds doubles, which represent integral distances exactly
+        auto& cache = distance_caches_.local();
         double value;
-        if (EVOLAB_LIKELY(distance_cache_.try_get(i, j, value))) {
-            return value;
+        if (EVOLAB_LIKELY(cache.try_get(i, j, value))) {
+            return static_cast<storage::distance_sum_t<Dist>>(value);
         }
-        value = distances_[i * n_ + j];
-        distance_cache_.put(i, j, value);
-        return value;
+        const auto exact = static_cast<storage::distance_sum_t<Dist>>(dist(i, j));
+        cache.put(i, j, static_cast<double>(exact));
+        return exact;
     }
 
     /// Get problem size (number of cities)
     std::size_t size() const noexcept { return n_; }
 
+    /// Whether cities are numbered differently from the source instance (see CityOrdering)
+    bool is_renumbered() const noexcept { return !original_ids_.empty(); }
+
+    /// Source instance id of an internal city
+    int original_id(int city) const noexcept {
+        return original_ids_.empty() ? city : original_ids_[city];
+    }
+
+    /// Tour in source instance ids
+    GenomeT to_original(const GenomeT& tour) const {
+        GenomeT result(tour.size());
+        std::ranges::transform(tour, result.begin(),
+                               [this](int city) { return original_id(city); });
+        return result;
+    }
+
+    /// Tour given in source instance ids, in internal ids
+    GenomeT from_original(const GenomeT& tour) const {
+        if (original_ids_.empty())
+            return tour;
+        std::vector<int> internal_id(original_ids_.size());
+        for (int city = 0; city < n_; ++city) {
+            internal_id[original_ids_[city]] = city;
+        }
+        GenomeT result(tour.size());
+        std::ranges::transform(tour, result.begin(), [&](int id) { return internal_id[id]; });
+        return result;
+    }
+
     /// Evaluate a tour (lower is better)
     core::Fitness evaluate(const GenomeT& tour) const {
         assert(static_cast<int>(tour.size()) == n_);
 
-        double total_distance = 0.0;
-        for (int i = 0; i < n_; ++i) {
-            int from = tour[i];
-            int to = tour[(i + 1) % n_];
-            total_distance += distance(from, to);
-        }
+        return visit_distance([&](const auto& dist) {
+            return core::Fitness{static_cast<double>(tour_length(dist, tour))};
+        });
+    }
 
-        return core::Fitness{total_distance};
+    /// Evaluate many tours at once
+    /// The storage back-end and kernel ISA are resolved once for the whole batch, and every
+    /// out[i] is bit-identical to evaluate(tours[i])
+    void evaluate_batch(std::span<const GenomeT> tours, std::span<core::Fitness> out) const {
+        assert(tours.size() == out.size());
+        const auto level = utils::detected_simd_level();
+        visit_distance([&](const auto& dist) {
+            for (std::size_t t = 0; t < tours.size(); ++t) {
+                assert(static_cast<int>(tours[t].size()) == n_);
+                const auto length = tour_length(dist, tours[t].data(), level);
+                out[t] = core::Fitness{static_cast<double>(length)};
+            }
+        });
+    }
+
+    /// Evaluate many tours at once, returning one fitness per tour
+    std::vector<core::Fitness> evaluate_batch(std::span<const GenomeT> tours) const {
+        std::vector<core::Fitness> out(tours.size());
+        evaluate_batch(tours, std::span<core::Fitness>(out));
+        return out;
+    }
+
+    /// Evaluate a contiguous tour matrix: row r occupies tour_matrix[r*n, (r+1)*n)
+    void evaluate_batch(std::span<const int> tour_matrix, std::span<core::Fitness> out) const {
+        assert(tour_matrix.size() == out.size() * static_cast<std::size_t>(n_));
+        const auto level = utils::detected_simd_level();
+        visit_distance([&](const auto& dist) {
+            for (std::size_t t = 0; t < out.size(); ++t) {
+                const int* tour = tour_matrix.data() + t * static_cast<std::size_t>(n_);
+                out[t] = core::Fitness{static_cast<double>(tour_length(dist, tour, level))};
+            }
+        });
+    }
+
+    /// Tour length against an already resolved back-end (see visit_distance)
+    /// Integral back-ends sum exactly in 64 bits; other layouts accumulate in double
+    template <typename Dist>
+    storage::distance_sum_t<Dist> tour_length(const Dist& dist, const GenomeT& tour) const {
+        return tour_length(dist, tour.data(), utils::detected_simd_level());
     }
 
     /// Generate a random valid tour
@@ -193,8 +543,30 @@ class TSP {
     /// Get number of cities
     int num_cities() const noexcept { return n_; }
 
-    /// Get raw distance matrix (for advanced algorithms)
-    const std::vector<double>& distance_matrix() const noexcept { return distances_; }
+    /// Get the full distance matrix in double precision, row-major (for advanced algorithms)
+    /// A Float64 dense matrix built in memory is returned as is. Other back-ends, including
+    /// memory-mapped caches, are converted once, on the first call, and the copy is kept for
+    /// the instance's lifetime; that materializes all n² distances, also for packed and lazy
+    /// instances. visit_distance() reads the native storage without a copy.
+    /// @throws std::bad_alloc if the conversion cannot allocate (never for in-memory Float64)
+    const std::vector<double>& distance_matrix() const {
+        if (const auto* dense = std::get_if<storage::DenseMatrix<double>>(&distances_)) {
+            if (const auto* entries = dense->owned_entries())
+                return *entries;
+        }
+        std::call_once(dense_copy_once_, [this] {
+            dense_copy_.resize(static_cast<std::size_t>(n_) * static_cast<std::size_t>(n_));
+            visit_distance([this](const auto& dist) {
+                for (int i = 0; i < n_; ++i) {
+                    double* row = dense_copy_.data() + static_cast<std::size_t>(i) * n_;
+                    for (int j = 0; j < n_; ++j) {
+                        row[j] = static_cast<double>(dist(i, j));
+                    }
+                }
+            });
+        });
+        return dense_copy_;
+    }
 
     /// Calculate 2-opt gain for edge swap (for local search)
     double two_opt_gain(const GenomeT& tour, int i, int j) const {
@@ -212,17 +584,33 @@ class TSP {
         int city_j = tour[j];
         int city_j_next = tour[(j + 1) % n_];
 
-        double old_distance = distance(city_i, city_i_next) + distance(city_j, city_j_next);
-        double new_distance = distance(city_i, city_j) + distance(city_i_next, city_j_next);
+        return visit_distance([&](const auto& dist) {
+            // Integral back-ends compute the gain exactly before converting
+            using gain_type = storage::distance_sum_t<std::decay_t<decltype(dist)>>;
+
+            const gain_type old_distance = static_cast<gain_type>(dist(city_i, city_i_next)) +
+                                           static_cast<gain_type>(dist(city_j, city_j_next));
+            const gain_type new_distance = static_cast<gain_type>(dist(city_i, city_j)) +
+                                           static_cast<gain_type>(dist(city_i_next, city_j_next));
 
-        // Positive gain means improvement
-        return old_distance - new_distance;
+            // Positive gain means improvement
+            return static_cast<double>(old_distance - new_distance);
+        });
     }
 
     /// Optimized 2-opt gain with caching and branch prediction hints
     /// Uses distance cache to reduce memory latency in hot loops
-    EVOLAB_FORCE_INLINE double two_opt_gain_cached(const GenomeT& tour, int i,
-                                                   int j) const noexcept {
+    double two_opt_gain_cached(const GenomeT& tour, int i, int j) const {
+        return visit_distance([&](const auto& dist) {
+            return static_cast<double>(two_opt_gain_cached(dist, tour, i, j));
+        });
+    }
+
+    /// Cached 2-opt gain against an already resolved back-end (see visit_distance)
+    /// Exact std::int64_t gain for integral back-ends, double otherwise
+    template <typename Dist>
+    EVOLAB_FORCE_INLINE storage::distance_sum_t<Dist>
+    two_opt_gain_cached(const Dist& dist, const GenomeT& tour, int i, int j) const {
         // Ensure i < j for consistency
         // This is unlikely since callers typically use nested loops with i < j
         if (EVOLAB_UNLIKELY(i > j)) {
@@ -235,33 +623,141 @@ class TSP {
         const int city_j_next = tour[(j + 1) % n_];
 
         // Use cached distances for reduced memory latency
-        const double old_dist =
-            cached_distance(city_i, city_i_next) + cached_distance(city_j, city_j_next);
-        const double new_dist =
-            cached_distance(city_i, city_j) + cached_distance(city_i_next, city_j_next);
+        const auto old_dist = cached_distance(dist, city_i, city_i_next) +
+                              cached_distance(dist, city_j, city_j_next);
+        const auto new_dist = cached_distance(dist, city_i, city_j) +
+                              cached_distance(dist, city_i_next, city_j_next);
 
         return old_dist - new_dist;
     }
 
-    /// Apply 2-opt move
-    void apply_two_opt(GenomeT& tour, int i, int j) const {
+    // Move deltas (core::PermutationDeltaProblem): fitness(after) - fitness(before) in O(1)
+    // by re-scoring only the edges a move touches. Integral back-ends are exact.
+
+    /// Length change from exchanging tour[i] and tour[j]
+    double swap_delta(const GenomeT& tour, std::size_t i, std::size_t j) const {
+        assert(i < tour.size() && j < tour.size());
+        if (i == j)
+            return 0.0;
+
+        const int a = static_cast<int>(i);
+        const int b = static_cast<int>(j);
+        auto city_at = [&](int k) { return k == a ? tour[b] : k == b ? tour[a] : tour[k]; };
+
+        // Edges starting at positions before and at each swapped slot; adjacent swaps share one
+        const int starts[4] = {(a + n_ - 1) % n_, a, (b + n_ - 1) % n_, b};
+        return visit_distance([&](const auto& dist) {
+            storage::distance_sum_t<std::decay_t<decltype(dist)>> delta = 0;
+            for (int e = 0; e < 4; ++e) {
+                if (std::find(starts, starts + e, starts[e]) != starts + e)
+                    continue;
+                const int next = (starts[e] + 1) % n_;
+                delta += dist(city_at(starts[e]), city_at(next));
+                delta -= dist(tour[starts[e]], tour[next]);
+            }
+            return static_cast<double>(delta);
+        });
+    }
+
+    /// Length change from reversing tour[first..last]
+    /// Only the two boundary edges change because distances are symmetric
+    double reversal_delta(const GenomeT& tour, std::size_t first, std::size_t last) const {
+        assert(first <= last && last < tour.size());
+        const int i = static_cast<int>(first);
+        const int j = static_cast<int>(last);
+        const int before = (i + n_ - 1) % n_;
+        const int after = (j + 1) % n_;
+        if (i == j || before == j)
+            return 0.0; // Single city or whole tour: same cycle
+
+        return visit_distance([&](const auto& dist) {
+            using sum_type = storage::distance_sum_t<std::decay_t<decltype(dist)>>;
+            const sum_type removed = static_cast<sum_type>(dist(tour[before], tour[i])) +
+                                     static_cast<sum_type>(dist(tour[j], tour[after]));
+            const sum_type added = static_cast<sum_type>(dist(tour[before], tour[j])) +
+                                   static_cast<sum_type>(dist(tour[i], tour[after]));
+            return static_cast<double>(added - removed);
+        });
+    }
+
+    /// Length change from moving block tour[first..last] before index pos of the remainder
+    double segment_move_delta(const GenomeT& tour, std::size_t first, std::size_t last,
+                              std::size_t pos) const {
+        assert(first <= last && last < tour.size());
+        const int block = static_cast<int>(last - first) + 1;
+        const int rest = n_ - block;
+        assert(static_cast<int>(pos) <= rest);
+        if (rest < 2)
+            return 0.0; // Block plus at most one city: same cycle
+
+        // Remainder index r maps to tour index r (before the block) or r + block (after it)
+        auto rest_city = [&](int r) {
+            r = (r + rest) % rest;
+            return tour[r < static_cast<int>(first) ? r : r + block];
+        };
+
+        const int gap = static_cast<int>(first) % rest;
+        const int insert = static_cast<int>(pos) % rest;
+        if (insert == gap)
+            return 0.0; // Reinserted into the gap it left
+
+        const int head = tour[first];
+        const int tail = tour[last];
+        const int left = rest_city(gap - 1);
+        const int right = rest_city(gap);
+        const int prev = rest_city(insert - 1);
+        const int next = rest_city(insert);
+
+        return visit_distance([&](const auto& dist) {
+            using sum_type = storage::distance_sum_t<std::decay_t<decltype(dist)>>;
+            const sum_type removed = static_cast<sum_type>(dist(left, head)) +
+                                     static_cast<sum_type>(dist(tail, right)) +
+                                     static_cast<sum_type>(dist(prev, next));
+            const sum_type added = static_cast<sum_type>(dist(left, right)) +
+                                   static_cast<sum_type>(dist(prev, head)) +
+                                   static_cast<sum_type>(dist(tail, next));
+            return static_cast<double>(added - removed);
+        });
+    }
+
+    /// Apply 2-opt move: reverse tour[i+1..j], or the rest of the tour if that is shorter
+    ///
+    /// Both reversals give the same cycle, so the tour may afterwards read in the opposite
+    /// direction. If `position` (city -> index in tour) is given, it is kept in sync.
+    void apply_two_opt(GenomeT& tour, int i, int j, std::span<int> position = {}) const {
         if (i > j)
             std::swap(i, j);
-        std::reverse(tour.begin() + i + 1, tour.begin() + j + 1);
+        if (EVOLAB_UNLIKELY(i == j))
+            return;
+        utils::reverse_shorter_side(tour, i + 1, j, position);
     }
 
-    /// Clear distance cache (call before starting new local search)
-    void clear_distance_cache() const noexcept { distance_cache_.clear(); }
+    /// Clear the calling thread's distance cache (call before starting new local search)
+    /// A thread's first call creates its cache, so it may throw std::bad_alloc; later
+    /// cached_distance() calls on the same thread then find the cache without allocating.
+    void clear_distance_cache() const { distance_caches_.local().clear(); }
+
+    /// Reset cache statistics of all threads (thread-safe)
+    void reset_cache_stats() const { distance_caches_.reset_stats(); }
 
-    /// Reset cache statistics (thread-safe)
-    void reset_cache_stats() const noexcept { distance_cache_.reset_stats(); }
+    /// Get cache hit rate over all threads for performance monitoring
+    double cache_hit_rate() const { return distance_caches_.hit_rate(); }
+
+    /// Get cache statistics (hits, misses) summed over all threads
+    std::pair<std::size_t, std::size_t> cache_stats() const {
+        return distance_caches_.stats();
+    }
 
-    /// Get cache hit rate for performance monitoring
-    double cache_hit_rate() const noexcept { return distance_cache_.hit_rate(); }
+    /// Set the size and associativity of the per-thread distance caches
+    /// Existing caches are dropped; must not be called while a local search runs.
+    /// @throws std::invalid_argument unless both are powers of two with ways <= entries
+    void configure_distance_cache(std::size_t entries, std::size_t ways) const {
+        distance_caches_.configure(entries, ways);
+    }
 
-    /// Get cache statistics (hits, misses)
-    std::pair<std::size_t, std::size_t> cache_stats() const noexcept {
-        return distance_cache_.stats();
+    /// Entries and ways of the per-thread distance caches
+    std::pair<std::size_t, std::size_t> distance_cache_geometry() const noexcept {
+        return {distance_caches_.entries(), distance_caches_.ways()};
     }
 
     /// Create candidate list for efficient local search
@@ -284,16 +780,151 @@ class TSP {
         return candidate_lists_.contains(k);
     }
 
-    /// Convert distance matrix to 2D format for candidate list creation
+    /// Convert distance matrix to 2D format
+    /// Materializes all n² distances, including for lazy instances; avoid for large n
     std::vector<std::vector<double>> get_distance_matrix_2d() const {
         std::vector<std::vector<double>> matrix_2d(n_, std::vector<double>(n_));
-        for (int i = 0; i < n_; ++i) {
-            for (int j = 0; j < n_; ++j) {
-                matrix_2d[i][j] = distances_[i * n_ + j];
+        visit_distance([&](const auto& dist) {
+            for (int i = 0; i < n_; ++i) {
+                for (int j = 0; j < n_; ++j) {
+                    matrix_2d[i][j] = dist(i, j);
+                }
             }
-        }
+        });
         return matrix_2d;
     }
+
+  private:
+    /// Tour length kernel selection: dense matrices use the gather kernels, other back-ends
+    /// the scalar kernel with the same lane-wise summation order
+    template <typename Dist>
+    storage::distance_sum_t<Dist> tour_length(const Dist& dist, const int* tour,
+                                              utils::SimdLevel level) const {
+        if (EVOLAB_UNLIKELY(n_ == 0))
+            return storage::distance_sum_t<Dist>{0};
+
+        if constexpr (storage::is_dense_matrix_v<Dist>) {
+            return kernels::dense_tour_length(dist.data().data(), tour, n_, level);
+        } else {
+            return kernels::tour_length_scalar<storage::distance_sum_t<Dist>>(dist, tour, n_);
+        }
+    }
+
+    /// TSPLIB metrics defined with nint/floor/ceil rounding, i.e. integral distances
+    static constexpr bool has_integral_metric(io::EdgeWeightType type) noexcept {
+        switch (type) {
+        case io::EdgeWeightType::EUC_2D:
+        case io::EdgeWeightType::EUC_3D:
+        case io::EdgeWeightType::CEIL_2D:
+        case io::EdgeWeightType::GEO:
+        case io::EdgeWeightType::ATT:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /// Distance back-end for a validated TSPLIB instance (mode, layout and precision)
+    static DistanceStorage make_tsplib_storage(const io::TSPInstance& instance,
+                                               const DistanceOptions& options) {
+        if (options.mode == DistanceMode::Lazy) {
+            return make_coordinate_storage(instance);
+        }
+
+        DistanceOptions resolved = options;
+        if (resolved.precision == DistancePrecision::Auto) {
+            resolved.precision = has_integral_metric(instance.edge_weight_type)
+                                     ? DistancePrecision::Int32
+                                     : DistancePrecision::Float64;
+        }
+
+        try {
+            return make_instance_storage(instance, resolved);
+        } catch (const std::invalid_argument& e) {
+            // Auto only picks int32 for rounded metrics; coordinates too large for 32-bit
+            // distances fall back to doubles instead of failing
+            if (options.precision != DistancePrecision::Auto) {
+                throw io::TSPLIBDataError(e.what());
+            }
+        }
+        resolved.precision = DistancePrecision::Float64;
+        return make_instance_storage(instance, resolved);
+    }
+
+    /// Copy of a coordinate instance whose city k is city order[k] of the source
+    static io::TSPInstance renumber_instance(const io::TSPInstance& instance,
+                                             std::span<const int> order) {
+        io::TSPInstance renumbered = instance;
+        for (std::size_t k = 0; k < order.size(); ++k) {
+            renumbered.node_coords[k] = instance.node_coords[order[k]];
+            if (instance.display_coords.size() == order.size()) {
+                renumbered.display_coords[k] = instance.display_coords[order[k]];
+            }
+        }
+        return renumbered;
+    }
+
+    /// Build a precomputed matrix back-end with the requested layout and element type
+    template <typename DistanceFn>
+    static DistanceStorage make_matrix_storage(int n, const DistanceOptions& options,
+                                               const DistanceFn& distance) {
+        auto build = [&]<template <typename> class Layout>() -> DistanceStorage {
+            switch (options.precision) {
+            case DistancePrecision::Float32:
+                return Layout<float>::from_function(n, distance);
+            case DistancePrecision::Int32:
+                return Layout<std::int32_t>::from_function(n, distance);
+            case DistancePrecision::Auto:
+            case DistancePrecision::Float64:
+            default:
+                return Layout<double>::from_function(n, distance);
+            }
+        };
+
+        if (options.layout == MatrixLayout::Triangular) {
+            return build.template operator()<storage::PackedTriangular>();
+        }
+        return build.template operator()<storage::DenseMatrix>();
+    }
+
+    /// Build a matrix back-end for a TSPLIB instance
+    /// Coordinate metrics go through the storage metric and its row kernels; everything else
+    /// (explicit weights, 3D and Manhattan/maximum metrics) uses calculate_distance
+    static DistanceStorage make_instance_storage(const io::TSPInstance& instance,
+                                                const DistanceOptions& options) {
+        switch (instance.edge_weight_type) {
+        case io::EdgeWeightType::EUC_2D:
+        case io::EdgeWeightType::CEIL_2D:
+        case io::EdgeWeightType::ATT:
+        case io::EdgeWeightType::GEO:
+            return std::visit(
+                [&](const auto& coords) -> DistanceStorage {
+                    return make_matrix_storage(instance.dimension, options, coords);
+                },
+                make_coordinate_storage(instance));
+        default:
+            return make_matrix_storage(instance.dimension, options, [&instance](int i, int j) {
+                return instance.calculate_distance(i, j);
+            });
+        }
+    }
+
+    /// Select the compile-time metric matching the instance's EDGE_WEIGHT_TYPE
+    static DistanceStorage make_coordinate_storage(const io::TSPInstance& instance) {
+        switch (instance.edge_weight_type) {
+        case io::EdgeWeightType::EUC_2D:
+            return storage::CoordinateDistance<storage::RoundedEuclidean2D>::from_tsplib(instance);
+        case io::EdgeWeightType::CEIL_2D:
+            return storage::CoordinateDistance<storage::CeilEuclidean2D>::from_tsplib(instance);
+        case io::EdgeWeightType::ATT:
+            return storage::CoordinateDistance<storage::PseudoEuclidean>::from_tsplib(instance);
+        case io::EdgeWeightType::GEO:
+            return storage::CoordinateDistance<storage::Geographic>::from_tsplib(instance);
+        default:
+            throw io::TSPLIBDataError(
+                "Lazy distance mode requires EUC_2D, CEIL_2D, GEO or ATT edge weights");
+        }
+    }
 };
 
 // Implementations for candidate list methods
@@ -313,14 +944,33 @@ inline const utils::CandidateList* TSP::get_candidate_list(int k) const {
         }
     }
 
-    // Slow path: element doesn't exist - create matrix outside lock
-    // This expensive O(n²) operation should not block other threads
-    auto matrix_2d = get_distance_matrix_2d();
+    // Slow path: element doesn't exist - build the list outside the lock
+    // Planar coordinate instances use a k-d tree (O(n log n)); other back-ends scan rows read
+    // straight from the matrix or metric, so no n² copy is made
+    // This expensive operation should not block other threads
+    auto list = visit_distance([&](const auto& dist) {
+        using Dist = std::decay_t<decltype(dist)>;
+        if constexpr (storage::is_coordinate_storage_v<Dist>) {
+            if constexpr (Dist::planar) {
+                if (k > 0) {
+                    return utils::CandidateList::from_neighbors(
+                        n_, k, dist.nearest_neighbors(k),
+                        [&dist](int i, int j) { return static_cast<double>(dist(i, j)); });
+                }
+            }
+            // Whole rows go through the vectorized row kernels where available
+            return utils::CandidateList::from_rows(
+                n_, k, [&dist, this](int i, double* out) { dist.row(i, 0, n_, out); });
+        } else {
+            auto row_distance = [&dist](int i, int j) { return static_cast<double>(dist(i, j)); };
+            return utils::CandidateList(n_, row_distance, k);
+        }
+    });
 
     // Exclusive lock for writing. try_emplace handles race safely:
     // if another thread created the entry in the meantime, it won't overwrite
     std::lock_guard<std::shared_mutex> lock(candidate_lists_mutex_);
-    return &candidate_lists_.try_emplace(k, matrix_2d, k).first->second;
+    return &candidate_lists_.try_emplace(k, std::move(list)).first->second;
 }
 
 /// Create random TSP instance
@@ -1,11 +1,25 @@
 #pragma once
 
+/// @file candidate_list.hpp
+/// @brief k-nearest-neighbor candidate lists for TSP local search
+///
+/// Lists are stored in one flat, cache-line-aligned array. City i owns the block starting at
+/// line i * row_lines: its k neighbor ids, followed by the k distances d(i, neighbor). A
+/// local search scanning the candidates of a city therefore streams one contiguous block
+/// and gets d(i, candidate) without touching the distance matrix.
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <concepts>
+#include <cstddef>
 #include <numeric>
+#include <span>
+#include <utility>
 #include <vector>
 
+#include <evolab/utils/matrix_build.hpp>
+
 namespace evolab {
 namespace utils {
 
@@ -16,26 +30,80 @@ class CandidateList {
     /// @param distance_matrix Row-major distance matrix
     /// @param k Number of nearest neighbors to maintain
     explicit CandidateList(const std::vector<std::vector<double>>& distance_matrix, int k)
-        : n_(distance_matrix.size()), k_(k), candidates_(n_) {
-        // Handle trivial instances up-front
-        if (n_ <= 1) {
-            k_ = 0;
-            return; // candidates_ already sized to n_, nothing to build
-        }
+        : CandidateList(
+              static_cast<int>(distance_matrix.size()),
+              [&distance_matrix](int i, int j) { return distance_matrix[i][j]; }, k) {}
 
-        if (k_ <= 0 || k_ >= static_cast<int>(n_)) {
-            k_ = static_cast<int>(n_) - 1; // Use all other cities if k is invalid
+    /// Create candidate list from a distance function
+    /// Rows are scanned one at a time with a bounded heap, so only O(k) temporary memory is
+    /// needed per row; rows are processed in parallel for large n when TBB is available, so
+    /// distance must be safe to call concurrently
+    /// @param n Number of cities
+    /// @param distance Callable returning the distance between cities i and j
+    /// @param k Number of nearest neighbors to maintain
+    template <typename DistanceFn>
+        requires std::invocable<const DistanceFn&, int, int>
+    CandidateList(int n, const DistanceFn& distance, int k) : CandidateList(n, k, Clamp{}) {
+        if (n_ <= 1)
+            return; // Nothing to build for trivial instances
+
+        build_candidate_lists([&distance](int i, std::vector<double>&) {
+            return [&distance, i](int j) { return static_cast<double>(distance(i, j)); };
+        });
+    }
+
+    /// Create candidate list from a row function
+    /// row(i, out) writes the distances from city i to all n cities into out[0, n); use this
+    /// when whole rows can be produced faster than single distances (e.g. vectorized metrics)
+    template <typename RowFn>
+        requires std::invocable<const RowFn&, int, double*>
+    static CandidateList from_rows(int n, int k, const RowFn& row) {
+        CandidateList list(n, k, Clamp{});
+        if (list.n_ > 1) {
+            list.build_candidate_lists([&row, &list](int i, std::vector<double>& buffer) {
+                buffer.resize(list.n_);
+                row(i, buffer.data());
+                return [data = buffer.data()](int j) { return data[j]; };
+            });
         }
+        return list;
+    }
 
-        build_candidate_lists(distance_matrix);
+    /// Create candidate lists from precomputed neighbors, e.g. stored in an instance cache
+    /// @param n Number of cities
+    /// @param k Candidates per city (already clamped to [0, n-1])
+    /// @param neighbors n × k city indices, row-major, each row sorted by distance
+    /// @param distance Callable returning the distance between cities i and j
+    template <typename DistanceFn>
+        requires std::invocable<const DistanceFn&, int, int>
+    static CandidateList from_neighbors(int n, int k, std::span<const int> neighbors,
+                                        const DistanceFn& distance) {
+        assert(neighbors.size() == static_cast<std::size_t>(n) * static_cast<std::size_t>(k));
+        CandidateList list(n, k, Keep{});
+        for (int i = 0; i < list.size(); ++i) {
+            const auto row = neighbors.subspan(static_cast<std::size_t>(i) * k, k);
+            int* ids = list.ids(i);
+            double* distances = list.distances(i);
+            for (int r = 0; r < k; ++r) {
+                ids[r] = row[r];
+                distances[r] = static_cast<double>(distance(i, row[r]));
+            }
+        }
+        return list;
     }
 
     /// Get k nearest neighbors for a given city
     /// @param city City index (must be in [0, n))
-    /// @return Vector of nearest neighbor indices sorted by distance
-    [[nodiscard]] const std::vector<int>& get_candidates(int city) const {
+    /// @return Nearest neighbor indices sorted by distance
+    [[nodiscard]] std::span<const int> get_candidates(int city) const {
+        assert(city >= 0 && city < static_cast<int>(n_) && "City index out of bounds");
+        return {ids(city), static_cast<std::size_t>(k_)};
+    }
+
+    /// Distances from a city to its candidates, parallel to get_candidates(city)
+    [[nodiscard]] std::span<const double> get_candidate_distances(int city) const {
         assert(city >= 0 && city < static_cast<int>(n_) && "City index out of bounds");
-        return candidates_[city];
+        return {distances(city), static_cast<std::size_t>(k_)};
     }
 
     /// Get number of cities
@@ -56,15 +124,9 @@ class CandidateList {
         assert(city1 >= 0 && city1 < static_cast<int>(n_) && "City1 index out of bounds");
         assert(city2 >= 0 && city2 < static_cast<int>(n_) && "City2 index out of bounds");
 
-        const auto& candidates1 = candidates_[city1];
-        const auto& candidates2 = candidates_[city2];
-
-        bool city1_has_city2 =
-            std::find(candidates1.begin(), candidates1.end(), city2) != candidates1.end();
-        bool city2_has_city1 =
-            std::find(candidates2.begin(), candidates2.end(), city1) != candidates2.end();
-
-        return city1_has_city2 || city2_has_city1;
+        // Two contiguous scans of k ids each
+        return std::ranges::find(get_candidates(city1), city2) != get_candidates(city1).end() ||
+               std::ranges::find(get_candidates(city2), city1) != get_candidates(city2).end();
     }
 
     /// @deprecated Use has_candidate_edge() instead. The name "are_mutual_candidates"
@@ -85,7 +147,7 @@ class CandidateList {
         pairs.reserve(n_ * k_);
 
         for (int i = 0; i < static_cast<int>(n_); ++i) {
-            for (int j : candidates_[i]) {
+            for (int j : get_candidates(i)) {
                 // Normalize pair to (min, max) to represent an undirected edge
                 pairs.emplace_back(std::min(i, j), std::max(i, j));
             }
@@ -100,35 +162,107 @@ class CandidateList {
     }
 
   private:
-    void build_candidate_lists(const std::vector<std::vector<double>>& distance_matrix) {
-        // Pre-condition: n_ > 1 (enforced by constructor early return)
-        for (std::size_t i = 0; i < n_; ++i) {
-            // Create vector of (distance, city_index) pairs
-            std::vector<std::pair<double, int>> distances;
-            distances.reserve(n_ - 1);
-
-            for (std::size_t j = 0; j < n_; ++j) {
-                if (i != j) {
-                    distances.emplace_back(distance_matrix[i][j], static_cast<int>(j));
-                }
-            }
+    /// One cache line of row storage
+    struct alignas(64) Line {
+        std::byte bytes[64];
+    };
 
-            // Partially sort by distance to get k nearest neighbors
-            // Use partial_sort instead of nth_element+sort to avoid UB when k==distances.size()
-            const int k_eff = std::min(k_, static_cast<int>(distances.size()));
-            std::partial_sort(distances.begin(), distances.begin() + k_eff, distances.end());
+    struct Keep {}; // k is already valid
+    struct Clamp {}; // Clamp k to [1, n-1] (0 for trivial instances)
 
-            // Take k nearest neighbors
-            candidates_[i].reserve(k_eff);
-            for (int idx = 0; idx < k_eff; ++idx) {
-                candidates_[i].push_back(distances[idx].second);
+    /// Uninitialized lists for n cities
+    CandidateList(int n, int k, Keep) : n_(static_cast<std::size_t>(std::max(n, 0))), k_(k) {
+        allocate();
+    }
+
+    CandidateList(int n, int k, Clamp) : n_(static_cast<std::size_t>(std::max(n, 0))), k_(k) {
+        if (n_ <= 1) {
+            k_ = 0;
+        } else if (k_ <= 0 || k_ >= static_cast<int>(n_)) {
+            k_ = static_cast<int>(n_) - 1; // Use all other cities if k is invalid
+        }
+        allocate();
+    }
+
+    /// Size the rows: k ids, padded to 8 bytes, then k distances, padded to a cache line
+    void allocate() {
+        const std::size_t k = static_cast<std::size_t>(std::max(k_, 0));
+        distance_offset_ = (k * sizeof(int) + sizeof(double) - 1) / sizeof(double);
+        const std::size_t row_bytes = (distance_offset_ + k) * sizeof(double);
+        row_lines_ = (row_bytes + sizeof(Line) - 1) / sizeof(Line);
+        lines_.resize(n_ * row_lines_);
+    }
+
+    // Pointer arithmetic rather than lines_[...]: rows are empty when k is 0
+    std::byte* row(int city) noexcept {
+        return reinterpret_cast<std::byte*>(lines_.data() + city * row_lines_);
+    }
+    const std::byte* row(int city) const noexcept {
+        return reinterpret_cast<const std::byte*>(lines_.data() + city * row_lines_);
+    }
+
+    int* ids(int city) noexcept { return reinterpret_cast<int*>(row(city)); }
+    const int* ids(int city) const noexcept { return reinterpret_cast<const int*>(row(city)); }
+    double* distances(int city) noexcept {
+        return reinterpret_cast<double*>(row(city)) + distance_offset_;
+    }
+    const double* distances(int city) const noexcept {
+        return reinterpret_cast<const double*>(row(city)) + distance_offset_;
+    }
+
+    /// Select the k nearest cities of every row
+    /// make_row(i, buffer) returns a callable giving the distance from i to city j
+    template <typename MakeRow>
+    void build_candidate_lists(const MakeRow& make_row) {
+        // Pre-condition: n_ > 1 (enforced by callers)
+        const int n = static_cast<int>(n_);
+        utils::detail::for_each_range(
+            n, n >= PARALLEL_MATRIX_MIN_DIMENSION, 16, [&](int begin, int end) {
+                // Scratch buffers are reused across the rows of a range
+                std::vector<double> buffer;
+                std::vector<std::pair<double, int>> heap;
+                heap.reserve(k_);
+                for (int i = begin; i < end; ++i) {
+                    select_nearest(i, make_row(i, buffer), heap);
+                }
+            });
+    }
+
+    /// Keep the k smallest (distance, city) pairs of row i in a max-heap
+    /// Ties are broken by city index, exactly as a full sort of the row would
+    template <typename RowDistance>
+    void select_nearest(int i, const RowDistance& distance,
+                        std::vector<std::pair<double, int>>& heap) {
+        heap.clear();
+        for (int j = 0; j < static_cast<int>(n_); ++j) {
+            if (j == i)
+                continue;
+            const std::pair<double, int> entry{distance(j), j};
+            if (static_cast<int>(heap.size()) < k_) {
+                heap.push_back(entry);
+                std::push_heap(heap.begin(), heap.end());
+            } else if (entry < heap.front()) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = entry;
+                std::push_heap(heap.begin(), heap.end());
             }
         }
+        std::sort_heap(heap.begin(), heap.end());
+
+        assert(static_cast<int>(heap.size()) == k_);
+        int* row_ids = ids(i);
+        double* row_distances = distances(i);
+        for (int r = 0; r < k_; ++r) {
+            row_distances[r] = heap[r].first;
+            row_ids[r] = heap[r].second;
+        }
     }
 
-    std::size_t n_;                            // Number of cities
-    int k_;                                    // Number of candidates per city
-    std::vector<std::vector<int>> candidates_; // Candidate lists for each city
+    std::size_t n_;                   // Number of cities
+    int k_;                           // Number of candidates per city
+    std::size_t row_lines_ = 0;       // Cache lines per city
+    std::size_t distance_offset_ = 0; // Start of the distances within a row, in doubles
+    std::vector<Line> lines_;         // n_ rows of row_lines_ lines each
 };
 
 /// Factory function to create candidate list with automatic k selection
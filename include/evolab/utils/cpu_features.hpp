@@ -0,0 +1,52 @@
+#pragma once
+
+/// @file cpu_features.hpp
+/// @brief Runtime CPU feature detection for kernels with ISA-specific implementations
+///
+/// Kernels are compiled per ISA with function-level target attributes, so the library does not
+/// need -mavx2 / -mavx512f and one binary runs on any x86-64 machine. The best supported level
+/// is detected once per process.
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+/// Defined when AVX2 / AVX-512 kernels can be compiled with target attributes
+#define EVOLAB_X86_SIMD 1
+#endif
+
+namespace evolab::utils {
+
+/// Instruction set levels with dedicated kernels, in increasing order of capability
+enum class SimdLevel {
+    Scalar, ///< Portable C++ only
+    AVX2,   ///< AVX2 (256-bit integer ops and gathers)
+    AVX512  ///< AVX-512F (512-bit vectors)
+};
+
+/// Whether the running CPU supports the given level
+[[nodiscard]] inline bool cpu_supports(SimdLevel level) noexcept {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return true;
+#ifdef EVOLAB_X86_SIMD
+    case SimdLevel::AVX2:
+        return __builtin_cpu_supports("avx2");
+    case SimdLevel::AVX512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+/// Best level supported by the running CPU (detected once, thread-safe)
+[[nodiscard]] inline SimdLevel detected_simd_level() noexcept {
+    static const SimdLevel level = [] {
+        if (cpu_supports(SimdLevel::AVX512))
+            return SimdLevel::AVX512;
+        if (cpu_supports(SimdLevel::AVX2))
+            return SimdLevel::AVX2;
+        return SimdLevel::Scalar;
+    }();
+    return level;
+}
+
+} // namespace evolab::utils
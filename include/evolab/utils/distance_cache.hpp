@@ -1,55 +1,149 @@
 #pragma once
 
 /// @file distance_cache.hpp
-/// @brief Small cache for distance lookups in local search operations
+/// @brief Small per-thread caches for distance lookups in local search
 ///
-/// Implements a direct-mapped cache for distance matrix accesses.
-/// Reduces memory latency during local search by caching frequently
-/// accessed distances. Cache size is tuned for L1 cache efficiency.
+/// Local search looks up the same few distances repeatedly around the edges it is working
+/// on. DistanceCache keeps them in a small set-associative table that stays in L1 cache.
+/// Each cache belongs to one thread, so lookups take no locks and no read-modify-write
+/// atomics. ThreadDistanceCaches gives every thread that shares a problem instance its own
+/// cache and adds up their statistics on demand.
 
-#include <array>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <new>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "evolab/utils/compiler_hints.hpp"
 
 namespace evolab::utils {
 
-/// Direct-mapped cache for distance lookups
-/// Uses a small cache size (64 entries) to fit in L1 cache
-/// Thread-safe with atomic operations for parallel local search
-template <typename T = double, std::size_t CacheSize = 64>
+/// Set-associative cache for distance lookups, used by a single thread
+///
+/// `entries` slots are grouped into sets of `ways`; a key maps to one set and may occupy any
+/// slot in it. A miss that fills a full set evicts the oldest entry of that set. With one way
+/// the cache is direct-mapped.
+///
+/// try_get, put and clear must only be called by the owning thread. The hit and miss
+/// counters are atomics written with relaxed load/store pairs (no locked instructions), so
+/// other threads may read and reset them at any time.
+template <typename T = double>
 class DistanceCache {
-    static_assert(CacheSize > 0, "CacheSize must be greater than 0");
-    static_assert((CacheSize & (CacheSize - 1)) == 0, "CacheSize must be power of 2");
-
-    // Cache line size for false sharing prevention
-    // Use hardware value if available, otherwise typical 64 bytes
-#ifdef __cpp_lib_hardware_interference_size
-    static constexpr std::size_t cache_line_size = std::hardware_destructive_interference_size;
-#else
-    static constexpr std::size_t cache_line_size = 64;
-#endif
-
-    // Performance-critical design: Each entry is aligned to cache line (64 bytes)
-    // to prevent false sharing in concurrent access scenarios.
-    // Memory tradeoff: 256 entries × 64 bytes = 16 KB (vs ~4.5 KB without alignment)
-    // This is acceptable for performance-critical TSP solving where concurrent
-    // cache access patterns are unpredictable (hash-based) and false sharing
-    // would significantly degrade performance.
-    struct alignas(cache_line_size) CacheEntry {
-        std::uint64_t key{0}; // Packed (i, j) as single 64-bit value
-        T value{};
-        bool valid{false};
-        std::atomic_flag lock{}; // Spinlock for atomicity
+  public:
+    static constexpr std::size_t DEFAULT_ENTRIES = 256;
+    static constexpr std::size_t DEFAULT_WAYS = 4;
+
+    /// @throws std::invalid_argument unless entries and ways are powers of two with
+    ///         ways <= entries
+    explicit DistanceCache(std::size_t entries = DEFAULT_ENTRIES,
+                           std::size_t ways = DEFAULT_WAYS)
+        : ways_(ways) {
+        if (!is_power_of_two(entries) || !is_power_of_two(ways) || ways > entries) {
+            throw std::invalid_argument(
+                "DistanceCache: entries and ways must be powers of two with ways <= entries");
+        }
+        set_mask_ = entries / ways - 1;
+        entries_.resize(entries);
+        clear();
+    }
+
+    DistanceCache(const DistanceCache&) = delete;
+    DistanceCache& operator=(const DistanceCache&) = delete;
+
+    /// Try to retrieve distance from cache
+    /// Returns true if found, false otherwise
+    bool try_get(int i, int j, T& out_value) noexcept {
+        const std::uint64_t key = pack_key(i, j);
+        const Entry* set = set_of(key);
+        for (std::size_t w = 0; w < ways_; ++w) {
+            if (set[w].key == key) {
+                out_value = set[w].value;
+                count(hits_);
+                return true;
+            }
+        }
+        count(misses_);
+        return false;
+    }
+
+    /// Insert distance into cache, evicting the oldest entry of its set
+    void put(int i, int j, T value) noexcept {
+        const std::uint64_t key = pack_key(i, j);
+        Entry* set = set_of(key);
+        for (std::size_t w = 0; w < ways_; ++w) {
+            if (set[w].key == key) {
+                set[w].value = value;
+                return;
+            }
+        }
+        // Entries are kept newest first within a set
+        for (std::size_t w = ways_ - 1; w > 0; --w) {
+            set[w] = set[w - 1];
+        }
+        set[0] = {key, value};
+    }
+
+    /// Clear all cache entries
+    /// Statistics are not reset - use reset_stats() explicitly if needed.
+    void clear() noexcept {
+        for (auto& entry : entries_) {
+            entry.key = EMPTY_KEY;
+        }
+    }
+
+    /// Reset cache statistics (may be called from any thread)
+    void reset_stats() noexcept {
+        hits_.store(0, std::memory_order_relaxed);
+        misses_.store(0, std::memory_order_relaxed);
+    }
+
+    /// Get cache statistics (hits, misses) (may be called from any thread)
+    std::pair<std::size_t, std::size_t> stats() const noexcept {
+        return {hits_.load(std::memory_order_relaxed), misses_.load(std::memory_order_relaxed)};
+    }
+
+    /// Get cache hit rate (0.0 to 1.0)
+    double hit_rate() const noexcept {
+        const auto [h, m] = stats();
+        const std::size_t total = h + m;
+        return total > 0 ? static_cast<double>(h) / total : 0.0;
+    }
+
+    /// Number of entries
+    std::size_t size() const noexcept { return entries_.size(); }
+
+    /// Entries per set
+    std::size_t ways() const noexcept { return ways_; }
+
+  private:
+    struct Entry {
+        std::uint64_t key; // Packed (i, j) as single 64-bit value
+        T value;
     };
 
-    mutable std::array<CacheEntry, CacheSize> entries_;
-    mutable std::atomic<std::size_t> hits_{0};
-    mutable std::atomic<std::size_t> misses_{0};
+    /// Never produced by pack_key for non-negative indices
+    static constexpr std::uint64_t EMPTY_KEY = ~std::uint64_t{0};
+
+    std::vector<Entry> entries_; // Set s occupies [s * ways_, (s + 1) * ways_)
+    std::size_t ways_;
+    std::size_t set_mask_;
+    std::atomic<std::size_t> hits_{0};
+    std::atomic<std::size_t> misses_{0};
+
+    static constexpr bool is_power_of_two(std::size_t x) noexcept {
+        return x != 0 && (x & (x - 1)) == 0;
+    }
+
+    /// Single writer: a relaxed load/store pair instead of a locked fetch_add
+    static void count(std::atomic<std::size_t>& counter) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
 
     /// Pack two indices into a single 64-bit key
     /// Supports full 32-bit indices without collision
@@ -58,112 +152,185 @@ class DistanceCache {
                static_cast<std::uint64_t>(static_cast<std::uint32_t>(j));
     }
 
-    /// Get cache index from key using XOR folding to mix both i and j
-    /// Folds 64-bit key by XORing upper 32 bits (i) with lower 32 bits (j)
-    /// This ensures both indices influence the hash, preventing systematic collisions
-    static constexpr std::size_t cache_index(std::uint64_t key) noexcept {
-        return static_cast<std::size_t>((key ^ (key >> 32)) & (CacheSize - 1));
+    /// First entry of the set for `key`
+    /// XOR folding mixes i and j so that both indices influence the set
+    Entry* set_of(std::uint64_t key) noexcept {
+        const auto set = static_cast<std::size_t>((key ^ (key >> 32)) & set_mask_);
+        return entries_.data() + set * ways_;
     }
+};
 
+/// One DistanceCache per thread for an object shared between threads
+///
+/// local() returns the calling thread's cache, creating it on first use, so concurrent local
+/// searches on a shared problem never contend and clearing one thread's cache leaves the
+/// others intact. Each thread remembers the last cache it used in a thread_local, which makes
+/// local() a compare and a load unless the thread alternates between instances.
+///
+/// Caches sit on cache lines of their own, so the counters one thread updates on every lookup
+/// never share a line with another thread's cache. When a thread exits, its cache is handed
+/// to the next new thread instead of being kept for good; entries stay valid because they
+/// belong to the same instance, and statistics keep counting.
+template <typename T = double>
+class ThreadDistanceCaches {
   public:
-    DistanceCache() = default;
+    explicit ThreadDistanceCaches(std::size_t entries = DistanceCache<T>::DEFAULT_ENTRIES,
+                                  std::size_t ways = DistanceCache<T>::DEFAULT_WAYS)
+        : shared_(std::make_shared<Shared>(entries, ways)) {
+        DistanceCache<T> validate(entries, ways); // Throw on invalid geometry up front
+    }
 
-    /// Try to retrieve distance from cache (thread-safe)
-    /// Returns true if found, false otherwise
-    /// Uses spinlock to prevent data races with concurrent writers
-    bool try_get(int i, int j, T& out_value) const noexcept {
-        const std::uint64_t key = pack_key(i, j);
-        const std::size_t idx = cache_index(key);
-        auto& entry = entries_[idx];
+    ThreadDistanceCaches(const ThreadDistanceCaches&) = delete;
+    ThreadDistanceCaches& operator=(const ThreadDistanceCaches&) = delete;
 
-        // Acquire spinlock to prevent races with writers
-        // Spinlock provides all necessary memory synchronization
-        while (entry.lock.test_and_set(std::memory_order_acquire)) {
-            EVOLAB_PAUSE(); // Yield CPU to reduce contention
-        }
+    /// Cache of the calling thread
+    /// @throws std::bad_alloc (or std::system_error from the lock) when the thread has no cache
+    ///         yet and one cannot be created; once created, the lookup does not throw
+    DistanceCache<T>& local() {
+        auto& last = last_used();
+        if (EVOLAB_LIKELY(last.owner == shared_->id))
+            return *last.cache;
 
-        bool found = false;
-        if (entry.valid && entry.key == key) {
-            out_value = entry.value;
-            found = true;
+        std::lock_guard lock(shared_->mutex);
+        const auto thread = std::this_thread::get_id();
+        Slot* claimed = nullptr;
+        for (auto& slot : shared_->slots) {
+            if (slot.thread == thread)
+                return *(last = {shared_->id, &slot.cache}).cache;
+            if (claimed == nullptr && slot.thread == std::thread::id{})
+                claimed = &slot; // Left by a thread that has exited
         }
-
-        entry.lock.clear(std::memory_order_release);
-
-        // Update statistics outside critical section to minimize lock hold time
-        // Cache hit is the expected common case (hint to compiler for branch prediction)
-        if (EVOLAB_LIKELY(found)) {
-            hits_.fetch_add(1, std::memory_order_relaxed);
-        } else {
-            misses_.fetch_add(1, std::memory_order_relaxed);
+        if (claimed == nullptr) {
+            claimed = &shared_->slots.emplace_back(std::thread::id{}, shared_->entries,
+                                                   shared_->ways);
         }
-        return found;
+        // Register the exit hook first: if that throws, the slot stays free for reuse
+        thread_exit().claim(shared_, shared_->id, claimed);
+        claimed->thread = thread;
+        last = {shared_->id, &claimed->cache};
+        return claimed->cache;
     }
 
-    /// Insert distance into cache (thread-safe)
-    /// Uses spinlock to ensure atomic key-value pair updates
-    void put(int i, int j, T value) const noexcept {
-        const std::uint64_t key = pack_key(i, j);
-        const std::size_t idx = cache_index(key);
-        auto& entry = entries_[idx];
+    /// Replace every thread's cache with an empty one of the given geometry
+    /// Must not run concurrently with searches using the caches.
+    /// @throws std::invalid_argument as DistanceCache
+    void configure(std::size_t entries, std::size_t ways) {
+        DistanceCache<T> validate(entries, ways);
+        std::lock_guard lock(shared_->mutex);
+        shared_->entries = entries;
+        shared_->ways = ways;
+        shared_->slots.clear();
+        shared_->id = next_id(); // Invalidates every thread's remembered cache and claims
+    }
+
+    std::size_t entries() const noexcept { return shared_->entries; }
+    std::size_t ways() const noexcept { return shared_->ways; }
 
-        // Acquire spinlock to prevent interleaved writes from multiple threads
-        while (entry.lock.test_and_set(std::memory_order_acquire)) {
-            EVOLAB_PAUSE(); // Yield CPU to reduce contention on hyper-threaded cores
+    /// Number of caches, in use or left by exited threads
+    std::size_t thread_caches() const {
+        std::lock_guard lock(shared_->mutex);
+        return shared_->slots.size();
+    }
+
+    /// Reset the statistics of every thread's cache
+    void reset_stats() {
+        std::lock_guard lock(shared_->mutex);
+        for (auto& slot : shared_->slots) {
+            slot.cache.reset_stats();
         }
+    }
 
-        // Spinlock guarantees atomicity and provides memory synchronization
-        entry.key = key;
-        entry.value = value;
-        entry.valid = true;
+    /// Statistics (hits, misses) summed over all threads
+    std::pair<std::size_t, std::size_t> stats() const {
+        std::lock_guard lock(shared_->mutex);
+        std::pair<std::size_t, std::size_t> total{0, 0};
+        for (const auto& slot : shared_->slots) {
+            const auto [hits, misses] = slot.cache.stats();
+            total.first += hits;
+            total.second += misses;
+        }
+        return total;
+    }
 
-        // Release spinlock with release barrier to ensure visibility
-        entry.lock.clear(std::memory_order_release);
+    /// Hit rate over all threads (0.0 to 1.0)
+    double hit_rate() const {
+        const auto [h, m] = stats();
+        const std::size_t total = h + m;
+        return total > 0 ? static_cast<double>(h) / total : 0.0;
     }
 
-    /// Clear all cache entries (thread-safe)
-    /// Note: Entries are invalidated one by one. Concurrent put() calls may
-    /// re-populate entries during clear(). No global snapshot is guaranteed.
-    /// This incremental invalidation is suitable for advisory cache storage.
-    /// Statistics are not reset - use reset_stats() explicitly if needed.
-    void clear() const noexcept {
-        for (auto& entry : entries_) {
-            // Acquire spinlock to prevent races with concurrent put()
-            while (entry.lock.test_and_set(std::memory_order_acquire)) {
-                EVOLAB_PAUSE(); // Yield CPU to reduce contention on hyper-threaded cores
-            }
+  private:
+    struct alignas(64) Slot {
+        Slot(std::thread::id thread, std::size_t entries, std::size_t ways)
+            : thread(thread), cache(entries, ways) {}
+
+        std::thread::id thread; // Default-constructed once the owning thread has exited
+        DistanceCache<T> cache;
+    };
+
+    /// State shared with the exit hooks of the threads that hold a cache
+    struct Shared {
+        Shared(std::size_t entries, std::size_t ways) : entries(entries), ways(ways) {}
 
-            // Spinlock provides memory synchronization
-            entry.valid = false;
+        mutable std::mutex mutex; // Guards slots, the geometry and slot ownership
+        std::deque<Slot> slots;   // Deque: caches keep their address as threads are added
+        std::size_t entries;
+        std::size_t ways;
+        std::uint64_t id = next_id();
+    };
 
-            // Release spinlock
-            entry.lock.clear(std::memory_order_release);
+    struct LastUsed {
+        std::uint64_t owner = 0;
+        DistanceCache<T>* cache = nullptr;
+    };
+
+    /// Releases the calling thread's caches when it exits
+    ///
+    /// Holds the instances weakly, so an instance destroyed before the thread is skipped, and
+    /// checks the id so that a slot dropped by configure() is not touched.
+    class ThreadExit {
+      public:
+        void claim(const std::shared_ptr<Shared>& shared, std::uint64_t id, Slot* slot) {
+            std::erase_if(claims_, [](const Claim& c) { return c.shared.expired(); });
+            claims_.push_back({shared, id, slot});
         }
-    }
 
-    /// Reset cache statistics (thread-safe)
-    /// Note: This is separate from clear() to avoid race conditions with
-    /// concurrent try_get() operations that may increment counters.
-    void reset_stats() const noexcept {
-        hits_.store(0, std::memory_order_relaxed);
-        misses_.store(0, std::memory_order_relaxed);
+        ~ThreadExit() {
+            for (const auto& claim : claims_) {
+                if (const auto shared = claim.shared.lock()) {
+                    std::lock_guard lock(shared->mutex);
+                    if (shared->id == claim.id)
+                        claim.slot->thread = std::thread::id{};
+                }
+            }
+        }
+
+      private:
+        struct Claim {
+            std::weak_ptr<Shared> shared;
+            std::uint64_t id;
+            Slot* slot;
+        };
+        std::vector<Claim> claims_;
+    };
+
+    /// Ids are never reused, so a remembered cache of a destroyed instance cannot match
+    static std::uint64_t next_id() noexcept {
+        static std::atomic<std::uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
     }
 
-    /// Get cache statistics (thread-safe)
-    std::pair<std::size_t, std::size_t> stats() const noexcept {
-        return {hits_.load(std::memory_order_relaxed), misses_.load(std::memory_order_relaxed)};
+    static LastUsed& last_used() noexcept {
+        static thread_local LastUsed last;
+        return last;
     }
 
-    /// Get cache hit rate (0.0 to 1.0) (thread-safe)
-    double hit_rate() const noexcept {
-        const std::size_t h = hits_.load(std::memory_order_relaxed);
-        const std::size_t m = misses_.load(std::memory_order_relaxed);
-        const std::size_t total = h + m;
-        return total > 0 ? static_cast<double>(h) / total : 0.0;
+    static ThreadExit& thread_exit() noexcept {
+        static thread_local ThreadExit exit;
+        return exit;
     }
 
-    /// Get cache size
-    static constexpr std::size_t size() noexcept { return CacheSize; }
+    std::shared_ptr<Shared> shared_;
 };
 
 } // namespace evolab::utils
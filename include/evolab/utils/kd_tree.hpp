@@ -0,0 +1,195 @@
+#pragma once
+
+/// @file kd_tree.hpp
+/// @brief Static 2D k-d tree for nearest-neighbor queries on planar point sets
+///
+/// Candidate list construction needs the k nearest neighbors of every node. Scanning all
+/// n - 1 distances per node costs O(n²); the tree answers each query in O(log n + k) for
+/// typical inputs, which makes candidate setup negligible even at 100k nodes.
+///
+/// Points are stored in tree order, so a leaf is a contiguous run of points and queries
+/// issued in tree_order() touch memory that is already in cache.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace evolab::utils {
+
+class KdTree2D {
+  public:
+    /// Leaves hold at most this many points
+    static constexpr int LEAF_SIZE = 8;
+
+    /// Build the tree over interleaved coordinates (x0, y0, x1, y1, ...)
+    explicit KdTree2D(std::span<const double> xy) {
+        assert(xy.size() % 2 == 0);
+        const int n = static_cast<int>(xy.size() / 2);
+        points_.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            points_.push_back({xy[2 * i], xy[2 * i + 1], i});
+        }
+        position_.resize(points_.size());
+        if (n > 0) {
+            nodes_.reserve(2 * (n / LEAF_SIZE + 1));
+            build(0, n);
+        }
+    }
+
+    [[nodiscard]] int size() const noexcept { return static_cast<int>(points_.size()); }
+
+    /// Squared distance from `point` to its k-th nearest other point (infinity if fewer exist)
+    ///
+    /// The point itself is excluded by index, so duplicates of it still count as neighbors.
+    /// @param heap Scratch storage, reused across calls to avoid allocations
+    [[nodiscard]] double kth_nearest_squared(int point, int k,
+                                             std::vector<double>& heap) const {
+        assert(point >= 0 && point < size() && k > 0);
+        heap.clear();
+        const Point& q = points_[position_of(point)];
+        search_nearest(0, q, k, heap);
+        return static_cast<int>(heap.size()) < k ? std::numeric_limits<double>::infinity()
+                                                 : heap.front();
+    }
+
+    /// Invoke visit(index) for every point other than `point` with squared distance <= radius²
+    template <typename Visit>
+    void for_each_within(int point, double radius_squared, const Visit& visit) const {
+        assert(point >= 0 && point < size());
+        search_within(0, points_[position_of(point)], radius_squared, visit);
+    }
+
+    /// Point indices in tree order; nearby points are adjacent
+    [[nodiscard]] std::vector<int> tree_order() const {
+        std::vector<int> order(points_.size());
+        std::ranges::transform(points_, order.begin(), &Point::index);
+        return order;
+    }
+
+  private:
+    struct Point {
+        double x, y;
+        int index;
+    };
+
+    struct Node {
+        double min_x, min_y, max_x, max_y; // Bounding box of the node's points
+        int begin, end;                    // Range in points_
+        int left = -1, right = -1;         // Children; -1 for leaves
+    };
+
+    std::vector<Point> points_;
+    std::vector<Node> nodes_;
+    std::vector<int> position_; // Original index -> position in points_
+
+    int position_of(int point) const noexcept { return position_[point]; }
+
+    int build(int begin, int end) {
+        Node node{std::numeric_limits<double>::infinity(),
+                  std::numeric_limits<double>::infinity(),
+                  -std::numeric_limits<double>::infinity(),
+                  -std::numeric_limits<double>::infinity(),
+                  begin,
+                  end};
+        for (int p = begin; p < end; ++p) {
+            node.min_x = std::min(node.min_x, points_[p].x);
+            node.min_y = std::min(node.min_y, points_[p].y);
+            node.max_x = std::max(node.max_x, points_[p].x);
+            node.max_y = std::max(node.max_y, points_[p].y);
+        }
+
+        const int id = static_cast<int>(nodes_.size());
+        nodes_.push_back(node);
+        if (end - begin <= LEAF_SIZE) {
+            for (int p = begin; p < end; ++p) {
+                position_[points_[p].index] = p;
+            }
+            return id;
+        }
+
+        // Split the wider extent at its median
+        const int mid = begin + (end - begin) / 2;
+        const bool split_x = node.max_x - node.min_x >= node.max_y - node.min_y;
+        std::nth_element(points_.begin() + begin, points_.begin() + mid, points_.begin() + end,
+                         [split_x](const Point& a, const Point& b) {
+                             return split_x ? a.x < b.x : a.y < b.y;
+                         });
+        const int left = build(begin, mid);
+        const int right = build(mid, end);
+        nodes_[id].left = left;
+        nodes_[id].right = right;
+        return id;
+    }
+
+    static double box_distance_squared(const Node& node, const Point& q) noexcept {
+        const double dx = std::max({node.min_x - q.x, 0.0, q.x - node.max_x});
+        const double dy = std::max({node.min_y - q.y, 0.0, q.y - node.max_y});
+        return dx * dx + dy * dy;
+    }
+
+    /// heap is a max-heap of the k smallest squared distances found so far
+    void search_nearest(int id, const Point& q, int k, std::vector<double>& heap) const {
+        const Node& node = nodes_[id];
+        if (node.left < 0) {
+            for (int p = node.begin; p < node.end; ++p) {
+                const Point& candidate = points_[p];
+                if (candidate.index == q.index)
+                    continue;
+                const double dx = candidate.x - q.x;
+                const double dy = candidate.y - q.y;
+                const double d = dx * dx + dy * dy;
+                if (static_cast<int>(heap.size()) < k) {
+                    heap.push_back(d);
+                    std::push_heap(heap.begin(), heap.end());
+                } else if (d < heap.front()) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = d;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+            return;
+        }
+
+        // Descend into the closer child first so the bound tightens early
+        int near = node.left;
+        int far = node.right;
+        double near_d = box_distance_squared(nodes_[near], q);
+        double far_d = box_distance_squared(nodes_[far], q);
+        if (far_d < near_d) {
+            std::swap(near, far);
+            std::swap(near_d, far_d);
+        }
+        if (static_cast<int>(heap.size()) < k || near_d < heap.front()) {
+            search_nearest(near, q, k, heap);
+        }
+        if (static_cast<int>(heap.size()) < k || far_d < heap.front()) {
+            search_nearest(far, q, k, heap);
+        }
+    }
+
+    template <typename Visit>
+    void search_within(int id, const Point& q, double radius_squared, const Visit& visit) const {
+        const Node& node = nodes_[id];
+        if (box_distance_squared(node, q) > radius_squared)
+            return;
+        if (node.left < 0) {
+            for (int p = node.begin; p < node.end; ++p) {
+                const Point& candidate = points_[p];
+                const double dx = candidate.x - q.x;
+                const double dy = candidate.y - q.y;
+                if (candidate.index != q.index && dx * dx + dy * dy <= radius_squared) {
+                    visit(candidate.index);
+                }
+            }
+            return;
+        }
+        search_within(node.left, q, radius_squared, visit);
+        search_within(node.right, q, radius_squared, visit);
+    }
+};
+
+} // namespace evolab::utils
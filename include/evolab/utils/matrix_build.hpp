@@ -0,0 +1,114 @@
+#pragma once
+
+/// @file matrix_build.hpp
+/// @brief Building blocks for constructing n×n distance matrices
+///
+/// Matrix construction is O(n²) and dominates startup on large instances. Rows are
+/// independent, so they are filled in parallel (oneTBB when available); symmetric matrices
+/// compute the upper triangle only, tile by tile, and mirror each tile while it is in cache.
+
+#include <algorithm>
+#include <cstddef>
+
+#ifdef EVOLAB_HAVE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+namespace evolab::utils {
+
+/// Matrices below this dimension are built serially; task overhead would dominate
+inline constexpr int PARALLEL_MATRIX_MIN_DIMENSION = 256;
+
+namespace detail {
+
+/// Invoke body(begin, end) on consecutive ranges covering [0, count), each at most `grain`
+/// indices long when parallel; serially the whole range is a single call
+template <typename Body>
+void for_each_range(int count, bool parallel, int grain, const Body& body) {
+#ifdef EVOLAB_HAVE_TBB
+    if (parallel) {
+        tbb::parallel_for(tbb::blocked_range<int>(0, count, grain),
+                          [&body](const tbb::blocked_range<int>& range) {
+                              body(range.begin(), range.end());
+                          });
+        return;
+    }
+#else
+    (void)parallel;
+    (void)grain;
+#endif
+    if (count > 0) {
+        body(0, count);
+    }
+}
+
+/// Invoke body(i) for i in [0, count), split into ranges of `grain` indices when parallel
+template <typename Body>
+void for_each_index(int count, bool parallel, int grain, const Body& body) {
+    for_each_range(count, parallel, grain, [&body](int begin, int end) {
+        for (int i = begin; i != end; ++i) {
+            body(i);
+        }
+    });
+}
+
+} // namespace detail
+
+/// Invoke body(i) for every row i in [0, n), in parallel for large n when TBB is available
+///
+/// body must only write row-local state, so the result does not depend on scheduling.
+/// Exceptions thrown by body propagate to the caller.
+template <typename Body>
+void for_each_matrix_row(int n, const Body& body) {
+    // Small grain: row costs differ by up to n× when only the upper triangle is computed
+    detail::for_each_index(n, n >= PARALLEL_MATRIX_MIN_DIMENSION, 16, body);
+}
+
+/// Fill a symmetric row-major n×n matrix, computing each pair once
+///
+/// The upper triangle is processed in square tiles: fill_segment(i, j_begin, j_end, out)
+/// writes d(i, j) for j in [j_begin, j_end) (j_begin >= i) to out, and each finished tile is
+/// transposed into its lower-triangle mirror while it is still in cache. Tile rows run in
+/// parallel; a tile row only writes its own upper tiles and their mirrors, so tasks never
+/// touch the same element.
+template <typename T, typename SegmentFn>
+void fill_symmetric_matrix(T* data, int n, const SegmentFn& fill_segment) {
+    constexpr int TILE = 64;
+    const int tiles = (n + TILE - 1) / TILE;
+    const auto stride = static_cast<std::size_t>(n);
+
+    auto fill_tile_row = [&](int tile) {
+        const int i_begin = tile * TILE;
+        const int i_end = std::min(i_begin + TILE, n);
+        for (int j_begin = i_begin; j_begin < n; j_begin += TILE) {
+            const int j_end = std::min(j_begin + TILE, n);
+            for (int i = i_begin; i < i_end; ++i) {
+                const int first = std::max(j_begin, i);
+                if (first < j_end) {
+                    fill_segment(i, first, j_end, data + i * stride + first);
+                }
+            }
+
+            if (j_begin == i_begin) {
+                // Diagonal tile: mirror in place
+                for (int i = i_begin; i < i_end; ++i) {
+                    for (int j = i_begin; j < i; ++j) {
+                        data[i * stride + j] = data[j * stride + i];
+                    }
+                }
+            } else {
+                for (int j = j_begin; j < j_end; ++j) {
+                    T* mirror = data + j * stride;
+                    for (int i = i_begin; i < i_end; ++i) {
+                        mirror[i] = data[i * stride + j];
+                    }
+                }
+            }
+        }
+    };
+
+    detail::for_each_index(tiles, n >= PARALLEL_MATRIX_MIN_DIMENSION, 1, fill_tile_row);
+}
+
+} // namespace evolab::utils
@@ -595,4 +595,32 @@ get_resource_or_default(const std::unique_ptr<NumaMemoryResource>& owned_resourc
     return owned_resource ? owned_resource.get() : std::pmr::get_default_resource();
 }
 
+/// NUMA node of island `island_id`: the round-robin mapping of create_island_resource()
+///
+/// @return Node id, or -1 on single-node systems and for negative island ids
+[[nodiscard]] inline int island_numa_node(int island_id) {
+    const auto available = detail::get_available_numa_nodes();
+    if (available.size() <= 1 || island_id < 0) {
+        return -1;
+    }
+    return available[island_id % static_cast<int>(available.size())];
+}
+
+/// Restrict the calling thread to the CPUs of island `island_id`'s NUMA node
+///
+/// Combined with a resource from create_owned_island_resource(), this keeps an island off the
+/// interconnect: memory the thread takes from the global heap is then placed on the same node
+/// by first touch.
+///
+/// @return true if the thread was bound; false without NUMA support or on single-node systems
+inline bool bind_thread_to_island_node(int island_id) {
+#ifdef EVOLAB_NUMA_SUPPORT
+    const int node = island_numa_node(island_id);
+    return node >= 0 && numa_run_on_node(node) == 0;
+#else
+    (void)island_id;
+    return false;
+#endif
+}
+
 } // namespace evolab::utils
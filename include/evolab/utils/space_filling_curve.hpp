@@ -0,0 +1,101 @@
+#pragma once
+
+/// @file space_filling_curve.hpp
+/// @brief Hilbert and Morton orderings of planar points
+///
+/// Sorting points by their position along a space-filling curve puts points that are close in
+/// the plane close in the order. Renumbering cities this way makes rows of a distance matrix
+/// that belong to nearby cities adjacent in memory, so the distance lookups of a local search
+/// working on one region of the tour share cache lines and pages.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace evolab::utils {
+
+enum class SpaceFillingCurve {
+    Hilbert, ///< Continuous curve: consecutive cells are always adjacent
+    Morton   ///< Z-order: cheaper to compute, with jumps between quadrants
+};
+
+/// Grid resolution per axis, in bits, used to quantize coordinates
+inline constexpr int CURVE_BITS = 16;
+
+/// Position of cell (x, y) along the Hilbert curve over a 2^bits x 2^bits grid
+constexpr std::uint64_t hilbert_index(std::uint32_t x, std::uint32_t y,
+                                      int bits = CURVE_BITS) noexcept {
+    const std::uint32_t n = std::uint32_t{1} << bits;
+    std::uint64_t d = 0;
+    for (std::uint32_t s = n / 2; s > 0; s /= 2) {
+        const std::uint32_t rx = (x & s) != 0 ? 1 : 0;
+        const std::uint32_t ry = (y & s) != 0 ? 1 : 0;
+        d += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+        // Rotate the quadrant so the sub-curve starts and ends where the parent expects
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/// Position of cell (x, y) along the Morton (Z-order) curve: the bits of x and y interleaved
+constexpr std::uint64_t morton_index(std::uint32_t x, std::uint32_t y) noexcept {
+    auto spread = [](std::uint64_t v) {
+        v &= 0xFFFFFFFFu;
+        v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+        v = (v | (v << 8)) & 0x00FF00FF00FF00FFull;
+        v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        v = (v | (v << 2)) & 0x3333333333333333ull;
+        v = (v | (v << 1)) & 0x5555555555555555ull;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1);
+}
+
+/// Order of points along a space-filling curve over their bounding box
+///
+/// Only the first two coordinates are used. Ties (points in the same grid cell) keep their
+/// input order, so the result is deterministic.
+/// @return order[k] = index of the point at position k
+inline std::vector<int> curve_order(std::span<const std::array<double, 3>> points,
+                                    SpaceFillingCurve curve) {
+    const int n = static_cast<int>(points.size());
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    if (n < 2)
+        return order;
+
+    std::array<double, 2> low = {points[0][0], points[0][1]};
+    std::array<double, 2> high = low;
+    for (const auto& p : points) {
+        for (int axis = 0; axis < 2; ++axis) {
+            low[axis] = std::min(low[axis], p[axis]);
+            high[axis] = std::max(high[axis], p[axis]);
+        }
+    }
+
+    // One scale for both axes keeps the cells square
+    constexpr double max_cell = static_cast<double>((std::uint32_t{1} << CURVE_BITS) - 1);
+    const double extent = std::max(high[0] - low[0], high[1] - low[1]);
+    const double scale = extent > 0.0 ? max_cell / extent : 0.0;
+
+    std::vector<std::uint64_t> keys(n);
+    for (int i = 0; i < n; ++i) {
+        const auto x = static_cast<std::uint32_t>((points[i][0] - low[0]) * scale);
+        const auto y = static_cast<std::uint32_t>((points[i][1] - low[1]) * scale);
+        keys[i] = curve == SpaceFillingCurve::Hilbert ? hilbert_index(x, y) : morton_index(x, y);
+    }
+    std::ranges::stable_sort(order, {}, [&keys](int i) { return keys[i]; });
+    return order;
+}
+
+} // namespace evolab::utils
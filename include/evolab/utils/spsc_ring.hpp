@@ -0,0 +1,107 @@
+#pragma once
+
+/// @file spsc_ring.hpp
+/// @brief Bounded lock-free queue between one producer and one consumer thread
+///
+/// SpscRing hands records from one thread to another without locks or read-modify-write
+/// atomics: the producer only writes the tail index and the consumer only writes the head.
+/// Slots are constructed once and reused, and records are written into and read out of them
+/// in place, so a record that owns heap memory (a genome) keeps its buffer in the ring and a
+/// steady stream of records allocates nothing.
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace evolab::utils {
+
+/// Fixed-capacity single-producer/single-consumer ring buffer
+///
+/// The try_push functions must only be called by the producer thread and the try_pop
+/// functions only by the consumer thread. Neither ever blocks: a push into a full ring or a
+/// pop from an empty one returns false.
+template <typename T>
+class SpscRing {
+  public:
+    /// @param capacity Number of slots, rounded up to a power of two
+    /// @param prototype Initial value of every slot; give it the size of the records to come
+    ///        so that writing them does not allocate
+    /// @throws std::invalid_argument if capacity is 0
+    explicit SpscRing(std::size_t capacity, const T& prototype = T{}) {
+        if (capacity == 0) {
+            throw std::invalid_argument("SpscRing: capacity must be positive");
+        }
+        slots_.assign(std::bit_ceil(capacity), prototype);
+        mask_ = slots_.size() - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return slots_.size(); }
+
+    /// Producer: fill the next free slot with write(slot) and publish it
+    ///
+    /// The slot holds whatever record was last read from it. If write throws, nothing is
+    /// published.
+    /// @return false if the ring is full (write is not called)
+    template <typename Write>
+    bool try_push_with(Write&& write) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == slots_.size()) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == slots_.size())
+                return false;
+        }
+        std::forward<Write>(write)(slots_[tail & mask_]);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer: pass the oldest record to read(slot) and release its slot
+    ///
+    /// read may move from the slot or swap with it; the slot is reused as is by the next push.
+    /// If read throws, the record stays in the ring.
+    /// @return false if the ring is empty (read is not called)
+    template <typename Read>
+    bool try_pop_with(Read&& read) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_)
+                return false;
+        }
+        std::forward<Read>(read)(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Producer: copy-assign `value` into the next free slot
+    bool try_push(const T& value) {
+        return try_push_with([&value](T& slot) { slot = value; });
+    }
+
+    /// Consumer: swap the oldest record into `out`, leaving out's old value for reuse
+    bool try_pop(T& out) {
+        return try_pop_with([&out](T& slot) {
+            using std::swap;
+            swap(out, slot);
+        });
+    }
+
+  private:
+    std::vector<T> slots_;
+    std::size_t mask_ = 0;
+
+    // Each index is written by one side only; the other side's last seen value is cached
+    // next to it, so a non-full push or non-empty pop does not touch the other cache line
+    alignas(64) std::atomic<std::size_t> tail_{0}; // Written by the producer
+    std::size_t cached_head_ = 0;
+    alignas(64) std::atomic<std::size_t> head_{0}; // Written by the consumer
+    std::size_t cached_tail_ = 0;
+};
+
+} // namespace evolab::utils
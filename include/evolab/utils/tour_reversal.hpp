@@ -0,0 +1,75 @@
+#pragma once
+
+/// @file tour_reversal.hpp
+/// @brief Segment reversal on cyclic tours stored as arrays
+///
+/// A 2-opt move reverses one of the two paths between the edges it replaces, and on a cycle
+/// reversing either path yields the same tour read in opposite directions. Reversing the
+/// shorter one touches at most n/2 cities, where always reversing the inner segment of an
+/// array averages n/3 and degrades to n - 2 for moves near its ends.
+
+#include <cassert>
+#include <span>
+#include <utility>
+
+namespace evolab::utils {
+
+/// Reverse the `length` cities starting at array position `first`, wrapping around the end
+///
+/// If `position` is not empty it maps city -> array position and is updated for every city
+/// that moves.
+inline void reverse_cyclic(std::span<int> tour, int first, int length,
+                           std::span<int> position = {}) {
+    const int n = static_cast<int>(tour.size());
+    assert(first >= 0 && first < n && length >= 0 && length <= n);
+    int i = first;
+    int j = first + length - 1;
+    if (j >= n)
+        j -= n;
+
+    // Non-wrapping reversals (the common case) run without index wrap checks
+    if (i <= j && position.empty()) {
+        for (; i < j; ++i, --j) {
+            std::swap(tour[i], tour[j]);
+        }
+        return;
+    }
+    if (i <= j) {
+        for (; i < j; ++i, --j) {
+            std::swap(tour[i], tour[j]);
+            position[tour[i]] = i;
+            position[tour[j]] = j;
+        }
+        return;
+    }
+
+    for (int k = 0; k < length / 2; ++k) {
+        std::swap(tour[i], tour[j]);
+        if (!position.empty()) {
+            position[tour[i]] = i;
+            position[tour[j]] = j;
+        }
+        i = i + 1 < n ? i + 1 : 0;
+        j = j > 0 ? j - 1 : n - 1;
+    }
+}
+
+/// Reverse the path from array position `first` forward to `last` (cyclically), or the rest
+/// of the tour if that is shorter
+///
+/// Both results describe the same cycle. `position` is maintained as in reverse_cyclic.
+/// @return true if the rest of the tour was reversed, which also reverses the direction in
+///         which the array reads the tour
+inline bool reverse_shorter_side(std::span<int> tour, int first, int last,
+                                 std::span<int> position = {}) {
+    const int n = static_cast<int>(tour.size());
+    const int length = (last - first + n) % n + 1;
+    if (2 * length <= n) {
+        reverse_cyclic(tour, first, length, position);
+        return false;
+    }
+    reverse_cyclic(tour, last + 1 < n ? last + 1 : 0, n - length, position);
+    return true;
+}
+
+} // namespace evolab::utils
@@ -0,0 +1,243 @@
+#pragma once
+
+/// @file two_level_list.hpp
+/// @brief Two-level doubly-linked list tour with O(√n) reversals
+///
+/// An array tour reverses up to n/2 cities per 2-opt move, which dominates local search on
+/// tours of 10k+ cities. The two-level list splits the tour into about √n segments, each a
+/// window of a city array with its own reversal bit, chained in tour order. Reversing a path
+/// splits at most two segments and then reverses the order and bits of the segments in
+/// between, so next, prev and between are O(1) and flip is O(√n). Segments only shrink; the
+/// list is rebuilt in O(n) once splitting has doubled their number, which keeps the
+/// amortized cost of a flip at O(√n).
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace evolab::utils {
+
+class TwoLevelList {
+  public:
+    /// Build from a tour given as a permutation of [0, n)
+    explicit TwoLevelList(std::span<const int> tour)
+        : cities_(tour.begin(), tour.end()), index_(tour.size()), segment_(tour.size()),
+          n_(static_cast<int>(tour.size())) {
+        assert(n_ > 0);
+        segment_size_ = std::max(MIN_SEGMENT_SIZE, static_cast<int>(std::sqrt(n_)));
+        rebuild_segments();
+    }
+
+    [[nodiscard]] int size() const noexcept { return n_; }
+
+    /// City following `city` in tour order
+    [[nodiscard]] int next(int city) const noexcept {
+        return reversed_ ? raw_prev(city) : raw_next(city);
+    }
+
+    /// City preceding `city` in tour order
+    [[nodiscard]] int prev(int city) const noexcept {
+        return reversed_ ? raw_next(city) : raw_prev(city);
+    }
+
+    /// Whether b lies on the path from a forward to c (endpoints included)
+    [[nodiscard]] bool between(int a, int b, int c) const noexcept {
+        return reversed_ ? raw_between(c, b, a) : raw_between(a, b, c);
+    }
+
+    /// Reverse the path from a forward to b
+    void flip(int a, int b) {
+        if (reversed_) {
+            raw_flip(b, a);
+        } else {
+            raw_flip(a, b);
+        }
+    }
+
+    /// Write the tour in order, starting at `first`
+    void copy_to(std::span<int> out, int first) const {
+        assert(static_cast<int>(out.size()) == n_);
+        int city = first;
+        for (int& slot : out) {
+            slot = city;
+            city = next(city);
+        }
+    }
+
+  private:
+    /// Segments shorter than this are not worth their bookkeeping
+    static constexpr int MIN_SEGMENT_SIZE = 8;
+
+    /// Window [begin, end) of cities_, read backwards when reversed
+    struct Segment {
+        int begin;
+        int end;
+        int rank; // Position in order_
+        bool reversed;
+    };
+
+    std::vector<int> cities_;        // Storage; every segment is a window of it
+    std::vector<int> index_;         // City -> index in cities_
+    std::vector<int> segment_;       // City -> segment id
+    std::vector<Segment> segments_;  // Indexed by segment id
+    std::vector<int> order_;         // Segment ids in (raw) tour order
+    std::vector<int> scratch_;       // Rebuild buffer
+    int n_;
+    int segment_size_ = MIN_SEGMENT_SIZE; // Segment length after a rebuild
+    bool reversed_ = false; // Whether tour order is the reverse of the raw order
+
+    int first_of(const Segment& s) const noexcept {
+        return s.reversed ? cities_[s.end - 1] : cities_[s.begin];
+    }
+    int last_of(const Segment& s) const noexcept {
+        return s.reversed ? cities_[s.begin] : cities_[s.end - 1];
+    }
+    int segment_count() const noexcept { return static_cast<int>(order_.size()); }
+
+    int raw_next(int city) const noexcept {
+        const Segment& s = segments_[segment_[city]];
+        const int i = index_[city];
+        if (!s.reversed && i + 1 < s.end)
+            return cities_[i + 1];
+        if (s.reversed && i > s.begin)
+            return cities_[i - 1];
+        const int rank = s.rank + 1 < segment_count() ? s.rank + 1 : 0;
+        return first_of(segments_[order_[rank]]);
+    }
+
+    int raw_prev(int city) const noexcept {
+        const Segment& s = segments_[segment_[city]];
+        const int i = index_[city];
+        if (!s.reversed && i > s.begin)
+            return cities_[i - 1];
+        if (s.reversed && i + 1 < s.end)
+            return cities_[i + 1];
+        const int rank = s.rank > 0 ? s.rank - 1 : segment_count() - 1;
+        return last_of(segments_[order_[rank]]);
+    }
+
+    /// Position of a city in raw tour order, as a totally ordered key
+    std::int64_t raw_sequence(int city) const noexcept {
+        const Segment& s = segments_[segment_[city]];
+        const int offset = s.reversed ? s.end - 1 - index_[city] : index_[city] - s.begin;
+        return static_cast<std::int64_t>(s.rank) * n_ + offset;
+    }
+
+    bool raw_between(int a, int b, int c) const noexcept {
+        const auto sa = raw_sequence(a);
+        const auto sb = raw_sequence(b);
+        const auto sc = raw_sequence(c);
+        return sa <= sc ? (sa <= sb && sb <= sc) : (sb >= sa || sb <= sc);
+    }
+
+    /// Split the segment of `city` so that `city` starts a segment (in raw order)
+    void split_before(int city) {
+        const int id = segment_[city];
+        if (first_of(segments_[id]) == city)
+            return;
+
+        const Segment s = segments_[id];
+        const int i = index_[city];
+        // Storage windows of the parts before and from `city`, in raw tour order
+        const std::pair<int, int> before = s.reversed ? std::pair{i + 1, s.end}
+                                                      : std::pair{s.begin, i};
+        const std::pair<int, int> from = s.reversed ? std::pair{s.begin, i + 1}
+                                                    : std::pair{i, s.end};
+
+        // The smaller part moves to a new segment, so relabeling costs at most half a segment
+        const bool move_before = before.second - before.first < from.second - from.first;
+        const auto [moved_begin, moved_end] = move_before ? before : from;
+        const auto [kept_begin, kept_end] = move_before ? from : before;
+
+        const int new_id = static_cast<int>(segments_.size());
+        const int rank = move_before ? s.rank : s.rank + 1;
+        segments_.push_back({moved_begin, moved_end, rank, s.reversed});
+        segments_[id].begin = kept_begin;
+        segments_[id].end = kept_end;
+        for (int k = moved_begin; k < moved_end; ++k) {
+            segment_[cities_[k]] = new_id;
+        }
+
+        order_.insert(order_.begin() + rank, new_id);
+        for (int r = rank; r < segment_count(); ++r) {
+            segments_[order_[r]].rank = r;
+        }
+    }
+
+    /// Reverse `count` consecutive segments starting at rank `first` (cyclically)
+    void reverse_segments(int first, int count) {
+        const int m = segment_count();
+        for (int k = 0; k < count / 2; ++k) {
+            std::swap(order_[(first + k) % m], order_[(first + count - 1 - k) % m]);
+        }
+        for (int k = 0; k < count; ++k) {
+            const int rank = (first + k) % m;
+            Segment& s = segments_[order_[rank]];
+            s.rank = rank;
+            s.reversed = !s.reversed;
+        }
+    }
+
+    /// Reverse the raw path from a to b
+    void raw_flip(int a, int b) {
+        if (a == b)
+            return;
+        if (raw_next(b) == a) {
+            // The whole tour: reversing it only changes the orientation
+            reversed_ = !reversed_;
+            return;
+        }
+
+        split_before(a);
+        split_before(raw_next(b));
+
+        const int m = segment_count();
+        const int first = segments_[segment_[a]].rank;
+        const int last = segments_[segment_[b]].rank;
+        const int count = (last - first + m) % m + 1;
+        if (2 * count <= m) {
+            reverse_segments(first, count);
+        } else {
+            // Reversing the rest of the tour and the orientation is the same move
+            reverse_segments(last + 1 < m ? last + 1 : 0, m - count);
+            reversed_ = !reversed_;
+        }
+
+        // Splits only add segments; re-balance once they have roughly doubled
+        if (segment_count() > 2 * (n_ / segment_size_ + 1)) {
+            rebuild_segments();
+        }
+    }
+
+    /// Re-cut the tour into segments of segment_size_ cities in raw order
+    void rebuild_segments() {
+        if (!order_.empty()) {
+            scratch_.resize(n_);
+            int city = first_of(segments_[order_[0]]);
+            for (int& slot : scratch_) {
+                slot = city;
+                city = raw_next(city);
+            }
+            cities_.swap(scratch_);
+        }
+
+        segments_.clear();
+        order_.clear();
+        for (int begin = 0; begin < n_; begin += segment_size_) {
+            const int id = static_cast<int>(segments_.size());
+            const int end = std::min(begin + segment_size_, n_);
+            segments_.push_back({begin, end, id, false});
+            order_.push_back(id);
+            for (int k = begin; k < end; ++k) {
+                index_[cities_[k]] = k;
+                segment_[cities_[k]] = id;
+            }
+        }
+    }
+};
+
+} // namespace evolab::utils
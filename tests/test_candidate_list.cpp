@@ -4,13 +4,18 @@
 /// Tests verify correctness of k-NN pre-computation, API completeness, and integration
 /// with TSP problem instances following TDD methodology.
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <format>
 #include <functional>
 #include <iostream>
+#include <random>
+#include <span>
 #include <string>
 #include <vector>
 
+#include <evolab/io/tsplib.hpp>
 #include <evolab/problems/tsp.hpp>
 #include <evolab/utils/candidate_list.hpp>
 
@@ -319,7 +324,7 @@ int test_tsp_integration() {
         const auto& candidates1 = cl_ptr->get_candidates(i);
         const auto& candidates2 = cl_ptr2->get_candidates(i);
         result.assert_true(
-            candidates1 == candidates2,
+            std::ranges::equal(candidates1, candidates2),
             std::format("Cached list should have identical candidates for city {}", i));
     }
 
@@ -378,6 +383,131 @@ int test_large_instance_scalability() {
     return result.summary();
 }
 
+int test_spatial_candidate_lists() {
+    TestResult result;
+
+    // Reference: full sort of every row by (distance, index)
+    auto reference = [](const problems::TSP& tsp, int i, int k) {
+        std::vector<std::pair<double, int>> row;
+        for (int j = 0; j < tsp.num_cities(); ++j) {
+            if (j != i)
+                row.emplace_back(tsp.distance(i, j), j);
+        }
+        std::sort(row.begin(), row.end());
+        std::vector<int> nearest;
+        for (int r = 0; r < k; ++r)
+            nearest.push_back(row[r].second);
+        return nearest;
+    };
+    auto matches_reference = [&](const problems::TSP& tsp, int k) {
+        const auto* list = tsp.get_candidate_list(k);
+        for (int i = 0; i < tsp.num_cities(); ++i) {
+            if (!std::ranges::equal(list->get_candidates(i), reference(tsp, i, k)))
+                return false;
+        }
+        return true;
+    };
+
+    // Above the parallel threshold; a small coordinate range creates duplicates and many
+    // rounding ties, which must be broken by index exactly as a full row sort would
+    constexpr int n = 700;
+    std::mt19937 rng(5);
+    for (const std::string type : {"EUC_2D", "CEIL_2D", "ATT", "GEO"}) {
+        for (int range : {40, 5000}) {
+            std::uniform_int_distribution<int> coordinate(0, range);
+            std::string text = "NAME: knn\nTYPE: TSP\nDIMENSION: " + std::to_string(n) +
+                               "\nEDGE_WEIGHT_TYPE: " + type + "\nNODE_COORD_SECTION\n";
+            for (int i = 0; i < n; ++i) {
+                const double scale = type == "GEO" ? 0.01 : 1.0;
+                text += std::to_string(i + 1) + " " + std::to_string(coordinate(rng) * scale) +
+                        " " + std::to_string(coordinate(rng) * scale) + "\n";
+            }
+            const auto instance = io::TSPLIBParser::parse_string(text + "EOF\n");
+            const auto lazy = problems::TSP::from_tsplib(instance, problems::DistanceMode::Lazy);
+            const auto matrix = problems::TSP::from_tsplib(instance);
+
+            const std::string label = std::format("{} (range {})", type, range);
+            for (int k : {1, 10}) {
+                result.assert_true(matches_reference(lazy, k),
+                                   std::format("{}: lazy k={} matches full sort", label, k));
+            }
+            result.assert_true(matches_reference(matrix, 10),
+                               label + ": matrix k=10 matches full sort");
+        }
+    }
+
+    // Unrounded Euclidean with fractional coordinates, k = n - 1
+    std::uniform_real_distribution<double> real(0.0, 100.0);
+    std::vector<std::pair<double, double>> cities(300);
+    for (auto& [x, y] : cities) {
+        x = real(rng);
+        y = real(rng);
+    }
+    problems::TSP lazy(cities, problems::DistanceMode::Lazy);
+    result.assert_true(matches_reference(lazy, 8), "Euclidean lazy k=8 matches full sort");
+    result.assert_true(matches_reference(lazy, 299), "Euclidean lazy k=n-1 matches full sort");
+
+    return result.summary();
+}
+
+int test_candidate_distances() {
+    TestResult result;
+
+    auto tsp = problems::create_random_tsp(300, 1000.0, 11);
+    for (int k : {1, 7, 16}) {
+        const auto* list = tsp.get_candidate_list(k);
+
+        bool distances_match = true;
+        bool rows_aligned = true;
+        for (int i = 0; i < list->size(); ++i) {
+            const auto candidates = list->get_candidates(i);
+            const auto distances = list->get_candidate_distances(i);
+            distances_match = distances_match && distances.size() == candidates.size();
+            for (std::size_t r = 0; r < candidates.size(); ++r) {
+                distances_match =
+                    distances_match && distances[r] == tsp.distance(i, candidates[r]);
+            }
+            rows_aligned =
+                rows_aligned && reinterpret_cast<std::uintptr_t>(candidates.data()) % 64 == 0;
+        }
+        result.assert_true(distances_match,
+                           std::format("k={}: stored distances match the problem", k));
+        result.assert_true(rows_aligned, std::format("k={}: rows start on a cache line", k));
+
+        // Rebuilding from the neighbor ids alone restores the same lists
+        std::vector<int> neighbors;
+        for (int i = 0; i < list->size(); ++i) {
+            const auto row = list->get_candidates(i);
+            neighbors.insert(neighbors.end(), row.begin(), row.end());
+        }
+        auto distance = [&tsp](int i, int j) { return tsp.distance(i, j); };
+        const auto rebuilt =
+            utils::CandidateList::from_neighbors(list->size(), list->k(), neighbors, distance);
+        bool same = true;
+        for (int i = 0; i < list->size(); ++i) {
+            same = same &&
+                   std::ranges::equal(list->get_candidates(i), rebuilt.get_candidates(i)) &&
+                   std::ranges::equal(list->get_candidate_distances(i),
+                                      rebuilt.get_candidate_distances(i));
+        }
+        result.assert_true(same, std::format("k={}: from_neighbors round-trips", k));
+
+        const int first = list->get_candidates(0)[0];
+        result.assert_true(list->has_candidate_edge(0, first) &&
+                               list->has_candidate_edge(first, 0),
+                           std::format("k={}: candidate edges are found from both ends", k));
+    }
+
+    // Empty rows for trivial instances
+    const auto single = utils::CandidateList::from_neighbors(
+        1, 0, std::span<const int>{}, [](int, int) { return 0.0; });
+    result.assert_true(single.get_candidates(0).empty() &&
+                           single.get_candidate_distances(0).empty(),
+                       "Single-city list has empty rows");
+
+    return result.summary();
+}
+
 #ifdef ENABLE_ASAN_DEMONSTRATION_TESTS
 /// Demonstrates the use-after-free bug in TSP candidate list caching.
 /// This test is DISABLED by default and should only be enabled when running with
@@ -436,6 +566,8 @@ int main() {
         {"Factory Function", test_factory_function},
         {"TSP Integration", test_tsp_integration},
         {"Large Instance Scalability", test_large_instance_scalability},
+        {"Spatial Candidate Lists", test_spatial_candidate_lists},
+        {"Co-located Candidate Distances", test_candidate_distances},
     };
 
 #ifdef ENABLE_ASAN_DEMONSTRATION_TESTS
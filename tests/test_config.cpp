@@ -166,6 +166,43 @@ void test_validation_probabilities() {
     result.print_summary();
 }
 
+void test_validation_local_search_type() {
+    TestResult result;
+
+    for (const std::string type : {"2-opt", "or-opt", "LK"}) {
+        auto config = Config::from_string("[local_search]\nenabled = true\ntype = \"" + type +
+                                          "\"\n");
+        result.assert_eq(type, config.local_search.type, "Accepts local search type " + type);
+    }
+
+    try {
+        auto config = Config::from_string("[local_search]\ntype = \"3-opt\"\n");
+        result.assert_true(false, "Should throw exception for unknown local search type");
+    } catch (const ConfigValidationError& e) {
+        result.assert_true(true, "Correctly threw exception for unknown local search type");
+    }
+
+    result.print_summary();
+}
+
+void test_validation_diversity_measure() {
+    TestResult result;
+
+    for (const std::string measure : {"hamming", "edge_entropy"}) {
+        auto config = Config::from_string("[diversity]\nmeasure = \"" + measure + "\"\n");
+        result.assert_eq(measure, config.diversity.measure, "Accepts diversity measure " + measure);
+    }
+
+    try {
+        auto config = Config::from_string("[diversity]\nmeasure = \"entropy\"\n");
+        result.assert_true(false, "Should throw exception for unknown diversity measure");
+    } catch (const ConfigValidationError& e) {
+        result.assert_true(true, "Correctly threw exception for unknown diversity measure");
+    }
+
+    result.print_summary();
+}
+
 void test_complete_config() {
     TestResult result;
 
@@ -263,6 +300,39 @@ void test_defaults() {
     result.print_summary();
 }
 
+void test_checkpoint_config() {
+    TestResult result;
+
+    const std::string toml_content = R"(
+        [logging]
+        save_population_snapshots = true
+        checkpoint_path = "run.ckpt"
+        checkpoint_interval = 25
+        checkpoint_period_minutes = 0.5
+    )";
+
+    auto temp_file = create_temp_toml(toml_content);
+    auto config = Config::from_file(temp_file.string());
+
+    result.assert_eq(std::string("run.ckpt"), config.logging.checkpoint_path, "Checkpoint path");
+    result.assert_eq(static_cast<size_t>(25), config.logging.checkpoint_interval,
+                     "Checkpoint interval");
+    result.assert_eq(0.5, config.logging.checkpoint_period_minutes, "Checkpoint period");
+
+    const auto ga_config = config.to_ga_config();
+    result.assert_true(ga_config.enable_checkpoints, "Checkpoint path enables checkpoints");
+    result.assert_true(ga_config.save_population_snapshots, "Snapshots kept");
+    result.assert_eq(static_cast<size_t>(25), ga_config.checkpoint_interval,
+                     "GA checkpoint interval");
+    result.assert_eq(30000.0, static_cast<double>(ga_config.checkpoint_period.count()),
+                     "GA checkpoint period in milliseconds");
+    result.assert_true(!Config{}.to_ga_config().enable_checkpoints,
+                       "Checkpoints disabled by default");
+
+    std::filesystem::remove(temp_file);
+    result.print_summary();
+}
+
 int main() {
     std::cout << "=== Configuration System Tests ===\n\n";
 
@@ -284,12 +354,21 @@ int main() {
     std::cout << "\nTest: Validation - Probabilities\n";
     test_validation_probabilities();
 
+    std::cout << "\nTest: Local Search Type Validation\n";
+    test_validation_local_search_type();
+
+    std::cout << "\nTest: Diversity Measure Validation\n";
+    test_validation_diversity_measure();
+
     std::cout << "\nTest: Complete Configuration\n";
     test_complete_config();
 
     std::cout << "\nTest: Configuration Defaults\n";
     test_defaults();
 
+    std::cout << "\nTest: Checkpoint Configuration\n";
+    test_checkpoint_config();
+
     std::cout << "\n=== All Configuration Tests Completed ===\n";
     return 0;
 }
\ No newline at end of file
@@ -220,6 +220,7 @@ void test_diversity_settings_from_config() {
         
         [diversity]
         enabled = true
+        measure = "edge_entropy"
         
         [termination]
         stagnation_generations = 200
@@ -232,6 +233,8 @@ void test_diversity_settings_from_config() {
     auto ga_config = config.to_ga_config();
 
     result.assert_true(ga_config.enable_diversity_tracking, "Diversity tracking enabled");
+    result.assert_true(ga_config.diversity_measure == core::DiversityMeasure::EdgeEntropy,
+                       "Diversity measure from config");
     result.assert_eq(static_cast<size_t>(200), ga_config.stagnation_limit,
                      "Stagnation limit from termination");
 
@@ -239,6 +242,30 @@ void test_diversity_settings_from_config() {
     result.print_summary();
 }
 
+void test_parallel_settings_from_config() {
+    TestResult result;
+
+    const std::string toml_content = R"(
+        [parallel]
+        enabled = true
+        threads = 4
+        chunk_size = 16
+    )";
+
+    auto temp_file = create_test_config(toml_content);
+    auto config = Config::from_file(temp_file.string());
+
+    auto ga_config = config.to_ga_config();
+
+    result.assert_true(ga_config.parallel_generation, "Parallel generation enabled");
+    result.assert_eq(static_cast<size_t>(4), ga_config.num_threads, "Thread count from config");
+    result.assert_eq(static_cast<size_t>(16), ga_config.parallel_chunk_size,
+                     "Chunk size from config");
+
+    std::filesystem::remove(temp_file);
+    result.print_summary();
+}
+
 int main() {
     std::cout << "=== Configuration Integration Tests ===\n\n";
 
@@ -260,6 +287,9 @@ int main() {
     std::cout << "\nTest: Diversity Settings from Config\n";
     test_diversity_settings_from_config();
 
+    std::cout << "\nTest: Parallel Settings from Config\n";
+    test_parallel_settings_from_config();
+
     std::cout << "\n=== All Configuration Integration Tests Completed ===\n";
     return 0;
 }
\ No newline at end of file
@@ -1,8 +1,15 @@
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
 #include <iostream>
 #include <memory_resource>
+#include <numeric>
+#include <random>
 #include <span>
 #include <sstream>
+#include <thread>
 
 #include <evolab/evolab.hpp>
 
@@ -10,6 +17,24 @@
 
 using namespace evolab;
 
+/// Memory resource that counts allocations and forwards them to the default resource
+class CountingResource : public std::pmr::memory_resource {
+  public:
+    std::size_t allocations = 0;
+
+  private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::get_default_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
 void test_fitness() {
     TestResult result;
 
@@ -178,6 +203,72 @@ void test_population_custom_allocator() {
     result.print_summary();
 }
 
+void test_matrix_population() {
+    TestResult result;
+
+    CountingResource resource;
+    core::MatrixPopulation<int> population(4, 6, &resource);
+    result.assert_eq(size_t{4}, population.capacity(), "Matrix population has fixed capacity");
+    result.assert_eq(size_t{6}, population.genome_length(), "Rows have the genome length");
+    result.assert_true(population.empty(), "Matrix population starts empty");
+
+    auto tsp = problems::create_random_tsp(6, 100.0, 3);
+    std::mt19937 rng(3);
+    std::vector<std::vector<int>> tours;
+    for (int i = 0; i < 4; ++i) {
+        tours.push_back(tsp.random_genome(rng));
+        population.push_back(tours.back(), core::Fitness{});
+    }
+
+    // All genomes live in one aligned row-major buffer
+    const auto data = population.genome_data();
+    result.assert_eq(size_t{24}, data.size(), "Genome data spans every row");
+    const auto address = reinterpret_cast<std::uintptr_t>(data.data());
+    result.assert_true(address % core::MatrixPopulation<int>::ALIGNMENT == 0,
+                       "Genome buffer is cache-line aligned");
+    bool rows_match = true;
+    for (size_t i = 0; i < 4; ++i) {
+        rows_match = rows_match && population.genome(i).data() == data.data() + i * 6 &&
+                     std::ranges::equal(population.genome(i), tours[i]);
+    }
+    result.assert_true(rows_match, "Genome i is row i of the matrix");
+    result.assert_eq(size_t{2}, resource.allocations,
+                     "Genes and fitness values come from the memory resource");
+
+    // Batch evaluation streams the matrix
+    core::evaluate_all(tsp, population);
+    bool same_fitness = true;
+    for (size_t i = 0; i < 4; ++i) {
+        same_fitness = same_fitness && population.fitness(i) == tsp.evaluate(tours[i]);
+    }
+    result.assert_true(same_fitness, "Matrix evaluation matches evaluate()");
+
+    bool full = false;
+    try {
+        population.push_back(tours[0], core::Fitness{});
+    } catch (const std::length_error&) {
+        full = true;
+    }
+    result.assert_true(full, "Pushing past capacity throws");
+
+    bool wrong_length = false;
+    try {
+        const std::vector<int> short_genome = {0, 1};
+        population.push_back(short_genome, core::Fitness{});
+    } catch (const std::invalid_argument&) {
+        wrong_length = true;
+    }
+    result.assert_true(wrong_length, "Genomes of the wrong length are rejected");
+
+    core::MatrixPopulation<int> other(4, 6, &resource);
+    other.swap(population);
+    result.assert_true(population.empty() && other.size() == 4 &&
+                           std::ranges::equal(other.genome(3), tours[3]),
+                       "Matrix population swap exchanges contents");
+
+    result.print_summary();
+}
+
 void test_basic_ga() {
     TestResult result;
 
@@ -206,6 +297,506 @@ void test_basic_ga() {
     result.print_summary();
 }
 
+void test_ga_buffer_reuse() {
+    TestResult result;
+
+    auto tsp = problems::create_random_tsp(30, 100.0, 5);
+    auto ga = factory::make_ga_basic();
+
+    for (bool parallel : {false, true}) {
+        const std::string mode = parallel ? "parallel" : "serial";
+
+        // Population storage is allocated up front, so a longer run allocates no more
+        CountingResource short_run;
+        CountingResource long_run;
+        core::GAConfig config{.population_size = 25,
+                              .max_generations = 3,
+                              .stagnation_limit = 1000,
+                              .enable_diversity_tracking = false,
+                              .parallel_generation = parallel,
+                              .memory_resource = &short_run};
+        const auto short_result = ga.run(tsp, config);
+        config.max_generations = 40;
+        config.memory_resource = &long_run;
+        const auto long_result = ga.run(tsp, config);
+
+        result.assert_true(short_run.allocations > 0, mode + ": GA allocates from the resource");
+        result.assert_eq(short_run.allocations, long_run.allocations,
+                         mode + ": no population allocations after the first generation");
+        result.assert_true(tsp.is_valid_tour(long_result.best_genome) &&
+                               long_result.best_fitness <= short_result.best_fitness,
+                           mode + ": swapped populations keep evolving");
+
+        // Genome buffers are reused too: EAX writes its children into the existing genomes
+        auto eax_ga = core::make_ga(operators::TournamentSelection{4}, operators::EAXCrossover{},
+                                    operators::SwapMutation{});
+        config.memory_resource = std::pmr::get_default_resource();
+        auto state = eax_ga.initialize(tsp, config);
+        auto genome_buffers = [&state] {
+            std::vector<const int*> buffers{state.spare_child.data()};
+            for (std::size_t i = 0; i < state.population.size(); ++i) {
+                buffers.push_back(state.population.genome(i).data());
+                buffers.push_back(state.next.genome(i).data());
+            }
+            std::ranges::sort(buffers);
+            return buffers;
+        };
+        const auto buffers = genome_buffers();
+        for (int generation = 0; generation < 20; ++generation) {
+            eax_ga.evolve(tsp, state, config);
+        }
+        result.assert_true(genome_buffers() == buffers,
+                           mode + ": EAX children reuse the genome buffers");
+    }
+
+    core::Population<std::vector<int>> first(2);
+    core::Population<std::vector<int>> second(2);
+    first.push_back({0, 1}, core::Fitness{1.0});
+    first.swap(second);
+    result.assert_true(first.empty() && second.size() == 1 && second.fitness(0).value == 1.0,
+                       "Population swap exchanges contents");
+
+    result.print_summary();
+}
+
+void test_island_model() {
+    TestResult result;
+
+    auto tsp = problems::create_random_tsp(30, 100.0, 9);
+    auto ga = factory::make_ga_basic();
+    const core::GAConfig config{.population_size = 20,
+                                .max_generations = 60,
+                                .seed = 7,
+                                .stagnation_limit = 1000,
+                                .log_interval = 10};
+
+    // One island is the plain GA
+    const auto plain = ga.run(tsp, config);
+    auto single = core::make_island_model(ga, {.islands = 1, .migration_interval = 15});
+    const auto one = single.run(tsp, config);
+    result.assert_true(one.best_genome == plain.best_genome &&
+                           one.best_fitness.value == plain.best_fitness.value,
+                       "Single island reproduces GeneticAlgorithm::run");
+    result.assert_eq(one.generations, plain.generations, "Single island generation count");
+    result.assert_eq(one.history.size(), plain.history.size(), "Single island history");
+
+    for (auto topology : {core::MigrationTopology::Ring, core::MigrationTopology::FullyConnected}) {
+        const std::string name =
+            topology == core::MigrationTopology::Ring ? "ring" : "fully connected";
+        auto model = core::make_island_model(
+            ga, {.islands = 4, .migration_interval = 10, .migrants = 3, .topology = topology});
+        const auto first = model.run(tsp, config);
+        const auto second = model.run(tsp, config);
+
+        result.assert_true(tsp.is_valid_tour(first.best_genome), name + ": valid best tour");
+        result.assert_true(std::abs(tsp.evaluate(first.best_genome).value -
+                                    first.best_fitness.value) < 1e-9,
+                           name + ": best fitness matches best tour");
+        result.assert_true(first.best_genome == second.best_genome &&
+                               first.best_fitness.value == second.best_fitness.value,
+                           name + ": independent of thread scheduling");
+        result.assert_eq(first.generations, config.max_generations, name + ": all generations");
+        result.assert_eq(first.evaluations, 4 * plain.evaluations,
+                         name + ": evaluations summed over islands");
+        result.assert_eq(first.history.size(), plain.history.size(), name + ": merged history");
+    }
+
+    // Evaluation budget is shared between the islands
+    core::GAConfig budget = config;
+    budget.max_evaluations = 400;
+    auto isolated = core::make_island_model(ga, {.islands = 2, .migration_interval = 0});
+    const auto limited = isolated.run(tsp, budget);
+    result.assert_true(limited.evaluations < 2 * plain.evaluations &&
+                           tsp.is_valid_tour(limited.best_genome),
+                       "Islands stop at their share of max_evaluations");
+
+    // Asynchronous migration: islands never wait for each other
+    for (auto topology : {core::MigrationTopology::Ring, core::MigrationTopology::FullyConnected}) {
+        auto model = core::make_island_model(ga, {.islands = 4,
+                                                  .migration_interval = 5,
+                                                  .migrants = 3,
+                                                  .topology = topology,
+                                                  .mode = core::MigrationMode::Asynchronous});
+        const auto async = model.run(tsp, config);
+        result.assert_true(tsp.is_valid_tour(async.best_genome) &&
+                               std::abs(tsp.evaluate(async.best_genome).value -
+                                        async.best_fitness.value) < 1e-9,
+                           "Asynchronous migration: valid best tour");
+        result.assert_true(async.generations == config.max_generations &&
+                               async.evaluations == 4 * plain.evaluations,
+                           "Asynchronous migration: every island runs to completion");
+    }
+    auto async_single = core::make_island_model(
+        ga, {.islands = 1, .migration_interval = 15, .mode = core::MigrationMode::Asynchronous});
+    result.assert_true(async_single.run(tsp, config).best_genome == plain.best_genome,
+                       "Asynchronous single island reproduces GeneticAlgorithm::run");
+
+    bool threw = false;
+    try {
+        core::IslandModel model(ga, {.islands = 0});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    result.assert_true(threw, "Zero islands rejected");
+
+    result.print_summary();
+}
+
+void test_spsc_ring() {
+    TestResult result;
+
+    utils::SpscRing<std::vector<int>> ring(3, std::vector<int>(4));
+    result.assert_eq(ring.capacity(), std::size_t{4}, "Capacity rounded up to a power of two");
+
+    std::vector<int> out;
+    result.assert_true(!ring.try_pop(out), "Empty ring pops nothing");
+    for (int i = 0; i < 4; ++i) {
+        result.assert_true(ring.try_push(std::vector<int>{i, i, i, i}), "Push into free slot");
+    }
+    result.assert_true(!ring.try_push(std::vector<int>{9}), "Full ring rejects push");
+
+    result.assert_true(ring.try_pop(out) && out == std::vector<int>{0, 0, 0, 0},
+                       "Records pop in push order");
+    result.assert_true(ring.try_push_with([](std::vector<int>& slot) { slot.assign(4, 7); }),
+                       "Freed slot accepts a push");
+    for (int expected : {1, 2, 3, 7}) {
+        result.assert_true(ring.try_pop(out) && out.front() == expected,
+                           "FIFO order across the wrap");
+    }
+    result.assert_true(!ring.try_pop(out), "Drained ring pops nothing");
+
+    // The consumer's old buffer stays in the slot for the next push to write into
+    utils::SpscRing<std::vector<int>> single(1, std::vector<int>(4));
+    std::vector<int> mine(4, -1);
+    const int* mine_buffer = mine.data();
+    single.try_push(std::vector<int>{5, 5, 5, 5});
+    single.try_pop(mine);
+    bool reused = false;
+    single.try_push_with([&](std::vector<int>& slot) {
+        reused = slot.data() == mine_buffer;
+        slot.assign(4, 6);
+    });
+    result.assert_true(reused && mine == std::vector<int>{5, 5, 5, 5},
+                       "Pops swap buffers with the slots instead of copying");
+
+    bool threw = false;
+    try {
+        utils::SpscRing<int> empty(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    result.assert_true(threw, "Zero capacity rejected");
+
+    // One producer and one consumer thread: every value arrives once, in order
+    constexpr int items = 100000;
+    utils::SpscRing<int> queue(64);
+    std::size_t sum = 0;
+    bool ordered = true;
+    {
+        std::jthread consumer([&] {
+            int expected = 0;
+            int value = 0;
+            while (expected < items) {
+                if (queue.try_pop(value)) {
+                    ordered = ordered && value == expected;
+                    sum += static_cast<std::size_t>(value);
+                    ++expected;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        for (int i = 0; i < items;) {
+            if (queue.try_push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+    result.assert_true(ordered, "Concurrent transfer preserves order");
+    result.assert_eq(sum, std::size_t{items} * (items - 1) / 2,
+                     "Concurrent transfer delivers every value once");
+
+    result.print_summary();
+}
+
+void test_checkpoint_resume() {
+    TestResult result;
+
+    const auto path = (std::filesystem::temp_directory_path() /
+                       ("evolab_test_checkpoint_" + std::to_string(std::random_device{}())))
+                          .string();
+
+    auto tsp = problems::create_random_tsp(30, 100.0, 13);
+    auto ga = factory::make_ga_basic();
+
+    for (bool parallel : {false, true}) {
+        const std::string mode = parallel ? "parallel" : "serial";
+        // More individuals than diversity samples, so statistics draw from the generator too
+        const core::GAConfig config{.population_size = 60,
+                                    .max_generations = 40,
+                                    .seed = 11,
+                                    .stagnation_limit = 1000,
+                                    .diversity_max_samples = 20,
+                                    .log_interval = 5,
+                                    .parallel_generation = parallel};
+        const auto uninterrupted = ga.run(tsp, config);
+
+        // Interrupted after 17 generations, then resumed to the full length
+        std::filesystem::remove(path);
+        core::GAConfig checkpointed = config;
+        checkpointed.enable_checkpoints = true;
+        checkpointed.checkpoint_path = path;
+        checkpointed.checkpoint_interval = 5;
+        checkpointed.max_generations = 17;
+        ga.run(tsp, checkpointed);
+        result.assert_eq(core::read_checkpoint<int>(path).generation, std::uint64_t{17},
+                         mode + ": final checkpoint written when the run ends");
+
+        checkpointed.max_generations = config.max_generations;
+        const auto resumed = ga.run(tsp, checkpointed);
+        result.assert_true(resumed.best_genome == uninterrupted.best_genome &&
+                               resumed.best_fitness.value == uninterrupted.best_fitness.value,
+                           mode + ": resumed run matches the uninterrupted one");
+        result.assert_eq(resumed.generations, uninterrupted.generations,
+                         mode + ": generations count the resumed ones");
+        result.assert_eq(resumed.evaluations, uninterrupted.evaluations,
+                         mode + ": evaluations count the resumed ones");
+        result.assert_true(!resumed.history.empty() && resumed.history.front().generation == 20,
+                           mode + ": history starts after the resumed generation");
+
+        // The checkpoint now holds generation 40 and belongs to this configuration only
+        checkpointed.seed = 12;
+        bool rejected = false;
+        try {
+            ga.run(tsp, checkpointed);
+        } catch (const core::CheckpointError&) {
+            rejected = true;
+        }
+        result.assert_true(rejected, mode + ": checkpoint of another configuration rejected");
+    }
+
+    // Round trip and validation of the file format
+    core::Checkpoint<int> checkpoint;
+    checkpoint.config_hash = 42;
+    checkpoint.generation = 7;
+    checkpoint.evaluations = 99;
+    checkpoint.stagnation_count = 3;
+    checkpoint.genome_length = 3;
+    checkpoint.fitness = {1.5, 2.5};
+    checkpoint.genes = {0, 1, 2, 2, 1, 0};
+    checkpoint.best_genome = {0, 1, 2};
+    checkpoint.best_fitness = 1.5;
+    checkpoint.rng.seed(5);
+    checkpoint.rng.discard(10);
+    core::write_checkpoint(path, checkpoint);
+    const auto loaded = core::read_checkpoint<int>(path);
+    result.assert_true(loaded.config_hash == 42 && loaded.generation == 7 &&
+                           loaded.evaluations == 99 && loaded.stagnation_count == 3 &&
+                           loaded.fitness == checkpoint.fitness &&
+                           loaded.genes == checkpoint.genes &&
+                           loaded.best_genome == checkpoint.best_genome &&
+                           loaded.best_fitness == 1.5 && loaded.rng == checkpoint.rng,
+                       "Checkpoint round trip");
+
+    bool wrong_gene = false;
+    try {
+        (void)core::read_checkpoint<double>(path);
+    } catch (const core::CheckpointError&) {
+        wrong_gene = true;
+    }
+    result.assert_true(wrong_gene, "Checkpoint of another gene type rejected");
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    bool truncated = false;
+    try {
+        (void)core::read_checkpoint<int>(path);
+    } catch (const core::CheckpointError&) {
+        truncated = true;
+    }
+    result.assert_true(truncated, "Truncated checkpoint rejected");
+
+    // Background writer: the last published checkpoint wins; snapshots keep each one
+    {
+        core::CheckpointWriter<int> writer(path, true);
+        for (std::uint64_t generation : {10, 20}) {
+            auto& buffer = writer.buffer();
+            buffer = checkpoint;
+            buffer.generation = generation;
+            writer.publish();
+        }
+        writer.wait();
+    }
+    result.assert_eq(core::read_checkpoint<int>(path).generation, std::uint64_t{20},
+                     "Writer leaves the latest checkpoint in place");
+    result.assert_true(std::filesystem::exists(path + ".20"), "Writer keeps snapshots");
+
+    for (const std::string suffix : {"", ".10", ".20"}) {
+        std::filesystem::remove(path + suffix);
+    }
+    result.print_summary();
+}
+
+void test_operator_timing() {
+    TestResult result;
+    using core::Phase;
+
+    auto tsp = problems::create_random_tsp(25, 100.0, 17);
+    auto ga = factory::make_tsp_ga_basic();
+
+    for (bool parallel : {false, true}) {
+        const std::string mode = parallel ? "parallel" : "serial";
+        core::GAConfig config{.population_size = 50,
+                              .max_generations = 10,
+                              .elite_ratio = 0.04,
+                              .seed = 5,
+                              .stagnation_limit = 1000,
+                              .log_interval = 1,
+                              .parallel_generation = parallel};
+        const auto untracked = ga.run(tsp, config);
+        result.assert_true(untracked.operator_stats.total_time().count() == 0 &&
+                               untracked.operator_stats[Phase::Selection].executions == 0,
+                           mode + ": nothing recorded unless tracking is enabled");
+
+        config.track_operator_performance = true;
+        const auto tracked = ga.run(tsp, config);
+        result.assert_true(tracked.best_genome == untracked.best_genome &&
+                               tracked.best_fitness.value == untracked.best_fitness.value,
+                           mode + ": tracking does not change the run");
+
+        // 2 elites and 48 offspring per generation, each offspring from a local search
+        const auto& stats = tracked.operator_stats;
+        result.assert_eq(stats[Phase::Elites].executions, std::size_t{10},
+                         mode + ": elites extracted once per generation");
+        result.assert_eq(stats[Phase::LocalSearch].executions, std::size_t{480},
+                         mode + ": one local search per offspring");
+        result.assert_eq(stats[Phase::Statistics].executions, std::size_t{20},
+                         mode + ": best update and logged statistics per generation");
+        result.assert_true(stats[Phase::Selection].executions >= 480 &&
+                               stats[Phase::Crossover].executions > 0 &&
+                               stats[Phase::Mutation].executions > 0 &&
+                               stats[Phase::Evaluation].executions > 0,
+                           mode + ": breeding phases counted");
+        result.assert_eq(stats[Phase::Repair].executions, std::size_t{0},
+                         mode + ": no repair without a repair operator");
+        result.assert_true(stats[Phase::LocalSearch].successes > 0 &&
+                               stats[Phase::LocalSearch].average_improvement > 0.0,
+                           mode + ": local search improvements counted");
+        result.assert_true(stats.total_time().count() > 0, mode + ": time recorded");
+
+        std::size_t logged_searches = 0;
+        for (const auto& entry : tracked.history) {
+            logged_searches += entry.operator_stats[Phase::LocalSearch].executions;
+        }
+        result.assert_eq(logged_searches, std::size_t{480},
+                         mode + ": history breaks the totals down by generation");
+    }
+
+    result.assert_true(core::phase_name(Phase::LocalSearch) == "local_search",
+                       "Phase names for reports");
+    result.print_summary();
+}
+
+void test_edge_frequency() {
+    TestResult result;
+
+    // Two edge-disjoint tours of 5 cities, and A reversed and rotated
+    const std::vector<int> a = {0, 1, 2, 3, 4};
+    const std::vector<int> c = {0, 2, 4, 1, 3};
+    const std::vector<int> a_turned = {2, 1, 0, 4, 3};
+
+    core::EdgeFrequencyTable table(2, 5);
+    result.assert_eq(0.0, table.diversity(), "Empty table has no diversity");
+    table.insert(0, a);
+    table.insert(1, c);
+    result.assert_eq(std::size_t{2}, table.occupied(), "Both slots occupied");
+    result.assert_eq(1.0, table.diversity(), "Tours without common edges: diversity 1");
+    result.assert_eq(5 * std::log(2.0), table.entropy(), "Entropy n log P", 1e-12);
+    result.assert_eq(1, static_cast<int>(table.frequency(4, 0)), "Edge of one tour");
+
+    table.replace(1, c, a_turned);
+    result.assert_eq(0.0, table.diversity(), "Reversed rotation is the same tour", 1e-12);
+    result.assert_eq(2, static_cast<int>(table.frequency(0, 4)), "Edge shared by both");
+    result.assert_eq(0, static_cast<int>(table.frequency(0, 2)), "Replaced edges removed");
+
+    bool rejected = false;
+    try {
+        table.replace(0, a, std::vector<int>{0, 1, 2});
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    result.assert_true(rejected, "Tour of the wrong length rejected");
+
+    // Incremental updates agree with a table built from scratch
+    std::mt19937 rng(3);
+    std::vector<std::vector<int>> tours(8, std::vector<int>(40));
+    core::EdgeFrequencyTable incremental(tours.size(), 40);
+    for (int step = 0; step < 200; ++step) {
+        auto& tour = tours[step % tours.size()];
+        if (step < 8) {
+            std::iota(tour.begin(), tour.end(), 0);
+            std::shuffle(tour.begin(), tour.end(), rng);
+            incremental.insert(step, tour);
+        } else {
+            // Small changes, as mutation makes them
+            const auto previous = tour;
+            std::uniform_int_distribution<std::size_t> pos(0, tour.size() - 1);
+            auto i = pos(rng), j = pos(rng);
+            std::reverse(tour.begin() + std::min(i, j), tour.begin() + std::max(i, j) + 1);
+            incremental.replace(step % tours.size(), previous, tour);
+        }
+    }
+    core::EdgeFrequencyTable rebuilt(tours.size(), 40);
+    for (std::size_t i = 0; i < tours.size(); ++i) {
+        rebuilt.insert(i, tours[i]);
+    }
+    result.assert_eq(rebuilt.entropy(), incremental.entropy(),
+                     "Incremental entropy matches a rebuilt table");
+
+    // In the GA: edge entropy draws no random numbers, so the run is unchanged
+    auto tsp = problems::create_random_tsp(30, 100.0, 21);
+    auto ga = factory::make_ga_basic();
+    core::GAConfig config{.population_size = 60,
+                          .max_generations = 60,
+                          .seed = 4,
+                          .enable_diversity_tracking = false,
+                          .diversity_max_samples = 20,
+                          .log_interval = 10};
+    const auto untracked = ga.run(tsp, config);
+    config.enable_diversity_tracking = true;
+    config.diversity_measure = core::DiversityMeasure::EdgeEntropy;
+    const auto tracked = ga.run(tsp, config);
+    result.assert_true(tracked.best_genome == untracked.best_genome,
+                       "Edge entropy leaves the run unchanged");
+    result.assert_true(!tracked.history.empty() &&
+                           std::ranges::all_of(tracked.history,
+                                               [](const auto& stats) {
+                                                   return stats.diversity >= 0.0 &&
+                                                          stats.diversity <= 1.0;
+                                               }) &&
+                           tracked.history.back().diversity < tracked.history.front().diversity,
+                       "Edge entropy in [0, 1] and falling as the population converges");
+
+    // The table follows every replacement: breeding, and individuals swapped in by a driver
+    auto state = ga.initialize(tsp, config);
+    for (int generation = 0; generation < 5; ++generation) {
+        ga.evolve(tsp, state, config);
+    }
+    auto migrant = tsp.random_genome(rng);
+    state.track_replacement(3, state.population.genome(3), migrant);
+    state.population.genome(3) = migrant;
+    ga.evolve(tsp, state, config);
+    core::EdgeFrequencyTable population_edges(state.population.size(), 30);
+    for (std::size_t i = 0; i < state.population.size(); ++i) {
+        population_edges.insert(i, state.population.genome(i));
+    }
+    result.assert_eq(population_edges.entropy(), state.edge_frequencies.entropy(),
+                     "Tracked edges match the population's", 1e-9);
+
+    result.print_summary();
+}
+
 int main() {
     std::cout << "Running EvoLab Core Tests\n";
     std::cout << std::string(30, '=') << "\n\n";
@@ -228,9 +819,30 @@ int main() {
     std::cout << "\nTesting Population Custom Allocator...\n";
     test_population_custom_allocator();
 
+    std::cout << "\nTesting Matrix Population...\n";
+    test_matrix_population();
+
     std::cout << "\nTesting Basic GA...\n";
     test_basic_ga();
 
+    std::cout << "\nTesting GA Buffer Reuse...\n";
+    test_ga_buffer_reuse();
+
+    std::cout << "\nTesting Island Model...\n";
+    test_island_model();
+
+    std::cout << "\nTesting SPSC Ring...\n";
+    test_spsc_ring();
+
+    std::cout << "\nTesting Checkpoint Resume...\n";
+    test_checkpoint_resume();
+
+    std::cout << "\nTesting Operator Timing...\n";
+    test_operator_timing();
+
+    std::cout << "\nTesting Edge Frequency Table...\n";
+    test_edge_frequency();
+
     std::cout << "\n" << std::string(30, '=') << "\n";
     std::cout << "Core tests completed.\n";
 
@@ -8,8 +8,10 @@
 #include <cmath>
 #include <iostream>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <vector>
 
 #include <evolab/local_search/two_opt.hpp>
@@ -365,80 +367,149 @@ int test_compiler_hints_work() {
     return result.summary();
 }
 
-// Test concurrent access to distance cache
-int test_distance_cache_concurrent_access() {
+int test_distance_cache_associativity() {
     TestResult result;
 
-    utils::DistanceCache<double> cache;
-    constexpr int num_threads = 4;
-    constexpr int operations_per_thread = 1000;
-    std::atomic<int> validation_errors{0};
-    std::atomic<bool> start{false};
-
-    // Pre-populate cache with some entries using deterministic value function
-    for (int i = 0; i < 10; ++i) {
-        cache.put(i, i + 1, static_cast<double>(i * (i + 1)));
+    // (0, 1) and (0, 3) map to the same set of a two-entry cache
+    double value;
+    utils::DistanceCache<double> direct(2, 1);
+    direct.put(0, 1, 1.0);
+    direct.put(0, 3, 3.0);
+    result.assert_true(!direct.try_get(0, 1, value), "Direct-mapped cache evicts on conflict");
+    result.assert_true(direct.try_get(0, 3, value), "Direct-mapped cache keeps newest entry");
+
+    utils::DistanceCache<double> two_way(2, 2);
+    two_way.put(0, 1, 1.0);
+    two_way.put(0, 3, 3.0);
+    result.assert_true(two_way.try_get(0, 1, value) && two_way.try_get(0, 3, value),
+                       "Two-way set holds both conflicting entries");
+    two_way.put(0, 5, 5.0);
+    result.assert_true(!two_way.try_get(0, 1, value), "Full set evicts its oldest entry");
+    result.assert_true(two_way.try_get(0, 5, value) && value == 5.0, "New entry is cached");
+
+    for (auto [entries, ways] : {std::pair<std::size_t, std::size_t>{0, 1}, {48, 4}, {4, 8}}) {
+        bool rejected = false;
+        try {
+            utils::DistanceCache<double> invalid(entries, ways);
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        result.assert_true(rejected, "Invalid geometry " + std::to_string(entries) + "/" +
+                                         std::to_string(ways) + " is rejected");
     }
 
-    auto worker = [&cache, &validation_errors, &start](int thread_id) {
-        std::mt19937 rng(thread_id);
-        std::uniform_int_distribution<int> dist(0, 99);
+    return result.summary();
+}
 
-        // Synchronize start to maximize overlap and contention
-        while (!start.load(std::memory_order_acquire)) {
-            EVOLAB_PAUSE(); // Yield CPU to reduce power consumption
-        }
+// Threads sharing a TSP get their own caches; statistics add up across them
+int test_tsp_thread_private_caches() {
+    TestResult result;
 
-        for (int op = 0; op < operations_per_thread; ++op) {
-            int i = dist(rng);
-            int j = dist(rng);
-            // Deterministic value function: value = i * j
-            double expected_value = static_cast<double>(i * j);
-
-            // Mix of put and try_get operations
-            if (op % 3 == 0) {
-                cache.put(i, j, expected_value);
-            } else {
-                double retrieved;
-                // If we get a cache hit, validate the value is correct
-                if (cache.try_get(i, j, retrieved)) {
-                    if (std::abs(retrieved - expected_value) > 1e-9) {
-                        validation_errors.fetch_add(1, std::memory_order_relaxed);
-                    }
-                }
-            }
-
-            // Occasionally clear cache
-            if (op % 100 == 0) {
-                cache.clear();
-            }
-        }
-    };
+    auto tsp = problems::create_random_tsp(200, 1000.0, 9);
+    tsp.configure_distance_cache(128, 2);
+    const auto geometry = tsp.distance_cache_geometry();
+    result.assert_true(geometry.first == 128 && geometry.second == 2,
+                       "Cache geometry is configurable");
 
-    // Launch threads
+    tsp.reset_cache_stats();
+    tsp.cached_distance(0, 1); // Miss
+
+    constexpr int num_threads = 4;
+    std::atomic<int> validation_errors{0};
     std::vector<std::thread> threads;
     for (int t = 0; t < num_threads; ++t) {
-        threads.emplace_back(worker, t);
+        threads.emplace_back([&tsp, &validation_errors, t] {
+            // Clearing this thread's cache must not affect the main thread's entry
+            tsp.clear_distance_cache();
+            if (std::abs(tsp.cached_distance(0, 1) - tsp.distance(0, 1)) > 1e-9) // Miss
+                validation_errors.fetch_add(1, std::memory_order_relaxed);
+            tsp.cached_distance(1, 0); // Hit
+
+            // Local search on the shared instance stays exact
+            std::mt19937 rng(t);
+            auto tour = tsp.random_genome(rng);
+            const auto fitness = local_search::CandidateList2Opt(8).improve(tsp, tour, rng);
+            if (!tsp.is_valid_tour(tour) ||
+                std::abs(fitness.value - tsp.evaluate(tour).value) > 1e-6)
+                validation_errors.fetch_add(1, std::memory_order_relaxed);
+        });
     }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    result.assert_eq(0, validation_errors.load(), "Concurrent searches stay correct");
 
-    // Signal all threads to start simultaneously
-    start.store(true, std::memory_order_release);
+    tsp.reset_cache_stats();
+    tsp.cached_distance(0, 1);
+    auto [hits, misses] = tsp.cache_stats();
+    result.assert_eq(1, static_cast<int>(hits), "Other threads' clears leave this cache intact");
+    result.assert_eq(0, static_cast<int>(misses), "No miss on the retained entry");
 
-    // Wait for completion
+    // Each thread contributes one miss and one hit
+    tsp.reset_cache_stats();
+    threads.clear();
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&tsp] {
+            tsp.clear_distance_cache();
+            tsp.cached_distance(2, 3);
+            tsp.cached_distance(3, 2);
+        });
+    }
     for (auto& thread : threads) {
         thread.join();
     }
+    std::tie(hits, misses) = tsp.cache_stats();
+    result.assert_eq(num_threads, static_cast<int>(hits), "Hits are summed over threads");
+    result.assert_eq(num_threads, static_cast<int>(misses), "Misses are summed over threads");
 
-    // Verify no data corruption occurred during concurrent execution
-    result.assert_eq(0, validation_errors.load(),
-                     "No validation errors should occur during concurrent access");
+    return result.summary();
+}
 
-    // Verify cache is still functional after concurrent access
-    cache.clear();
-    cache.put(42, 43, 99.0);
-    double value;
-    result.assert_true(cache.try_get(42, 43, value), "Cache should work after concurrent access");
-    result.assert_eq(99.0, value, "Value should be correct", 1e-9);
+// Caches of threads that have exited are reused rather than accumulated
+int test_thread_caches_reuse_exited_threads() {
+    TestResult result;
+
+    utils::ThreadDistanceCaches<double> caches(64, 4);
+    std::thread([&caches] { caches.local().put(4, 5, 9.0); }).join();
+    result.assert_eq(std::size_t{1}, caches.thread_caches(), "First thread gets a cache");
+
+    for (int t = 0; t < 8; ++t) {
+        std::thread([&caches] {
+            double value = 0.0;
+            caches.local().try_get(4, 5, value);
+        }).join();
+    }
+    result.assert_eq(std::size_t{1}, caches.thread_caches(), "Exited threads' caches are reused");
+    auto [hits, misses] = caches.stats();
+    result.assert_eq(std::size_t{8}, hits, "Reused cache keeps its entries");
+    result.assert_eq(std::size_t{0}, misses, "No misses on the inherited entry");
+
+    // Live threads never share a cache
+    std::atomic<int> ready{0};
+    std::atomic<bool> release{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([&] {
+            caches.local();
+            ready.fetch_add(1);
+            while (!release.load())
+                std::this_thread::yield();
+        });
+    }
+    while (ready.load() < 3)
+        std::this_thread::yield();
+    result.assert_eq(std::size_t{3}, caches.thread_caches(), "Concurrent threads get own caches");
+    release.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // A reconfigured instance starts over; earlier claims must not touch its caches
+    caches.configure(32, 2);
+    std::thread([&caches] { caches.local(); }).join();
+    result.assert_eq(std::size_t{1}, caches.thread_caches(), "Reconfigured caches start over");
+    std::tie(hits, misses) = caches.stats();
+    result.assert_eq(std::size_t{0}, hits + misses, "Reconfigured caches have no statistics");
 
     return result.summary();
 }
@@ -456,12 +527,14 @@ int main() {
     total_failed += test_distance_cache_clear();
     total_failed += test_distance_cache_hit_rate();
     total_failed += test_distance_cache_large_indices();
-    total_failed += test_distance_cache_concurrent_access();
+    total_failed += test_distance_cache_associativity();
 
     std::cout << "\n--- TSP Cached Distance Tests ---\n";
     total_failed += test_tsp_cached_distance_matches_regular();
     total_failed += test_tsp_cache_improves_performance();
     total_failed += test_tsp_clear_cache_works();
+    total_failed += test_tsp_thread_private_caches();
+    total_failed += test_thread_caches_reuse_exited_threads();
     total_failed += test_two_opt_gain_cached_matches_regular();
 
     std::cout << "\n--- 2-opt Delta Evaluation Tests ---\n";
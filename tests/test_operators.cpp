@@ -2,6 +2,7 @@
 #include <cassert>
 #include <iostream>
 #include <numeric>
+#include <string>
 #include <unordered_set>
 
 #include <evolab/evolab.hpp>
@@ -161,6 +162,46 @@ void test_crossover_operators() {
     }
     result.assert_true(edges_from_parents > 0, "EAX preserves some edges from parents");
 
+    // In-place crossovers write the same children as cross() into the existing genomes
+    static_assert(core::InPlaceCrossoverOperator<operators::PMXCrossover, problems::TSP>);
+    static_assert(core::InPlaceCrossoverOperator<operators::OrderCrossover, problems::TSP>);
+    static_assert(core::InPlaceCrossoverOperator<operators::UniformCrossover, problems::TSP>);
+    static_assert(core::InPlaceCrossoverOperator<operators::CycleCrossover, problems::TSP>);
+    static_assert(
+        core::InPlaceCrossoverOperator<operators::EdgeRecombinationCrossover, problems::TSP>);
+    static_assert(core::InPlaceCrossoverOperator<operators::EAXCrossover, problems::TSP>);
+
+    auto large = problems::create_random_tsp(50, 100.0, 9);
+    std::mt19937 parent_rng(9);
+    const auto large_parent1 = large.random_genome(parent_rng);
+    const auto large_parent2 = large.random_genome(parent_rng);
+    auto check_in_place = [&](const auto& crossover, const std::string& name,
+                              bool permutation = true) {
+        bool same = true;
+        std::vector<int> target1(50);
+        std::vector<int> target2(50);
+        const int* storage = target1.data();
+        for (unsigned seed = 0; seed < 20; ++seed) {
+            std::mt19937 rng_cross(seed);
+            std::mt19937 rng_in_place(seed);
+            auto [expected1, expected2] =
+                crossover.cross(large, large_parent1, large_parent2, rng_cross);
+            crossover.cross_into(large, large_parent1, large_parent2, target1, target2,
+                                 rng_in_place);
+            same = same && target1 == expected1 && target2 == expected2 &&
+                   rng_cross() == rng_in_place() &&
+                   (!permutation || (large.is_valid_tour(target1) && large.is_valid_tour(target2)));
+        }
+        result.assert_true(same, name + " cross_into matches cross");
+        result.assert_true(target1.data() == storage, name + " cross_into reuses the storage");
+    };
+    check_in_place(pmx, "PMX");
+    check_in_place(ox, "OX");
+    check_in_place(operators::UniformCrossover{}, "Uniform", false);
+    check_in_place(cx, "CX");
+    check_in_place(erx, "ERX");
+    check_in_place(eax, "EAX");
+
     result.print_summary();
 }
 
@@ -245,6 +286,114 @@ void test_mutation_operators() {
     result.print_summary();
 }
 
+void test_delta_mutations() {
+    TestResult result;
+
+    // Random symmetric instance with integral weights, stored as int32 (exact deltas) and
+    // as double (deltas within rounding)
+    constexpr int n = 9;
+    std::mt19937 weight_rng(5);
+    std::uniform_int_distribution<int> weight(1, 500);
+    std::vector<double> matrix(n * n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            matrix[i * n + j] = matrix[j * n + i] = weight(weight_rng);
+        }
+    }
+    problems::TSP exact(n, matrix,
+                        problems::DistanceOptions{.precision = problems::DistancePrecision::Int32});
+    problems::TSP floating(n, matrix);
+
+    std::vector<int> tour(n);
+    std::iota(tour.begin(), tour.end(), 0);
+    std::shuffle(tour.begin(), tour.end(), weight_rng);
+
+    // Exhaustive check of the problem hooks against full re-evaluation
+    bool swap_ok = true;
+    bool reversal_ok = true;
+    bool segment_ok = true;
+    const double base = exact.evaluate(tour).value;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            auto swapped = tour;
+            std::swap(swapped[i], swapped[j]);
+            swap_ok &= exact.swap_delta(tour, i, j) == exact.evaluate(swapped).value - base;
+            swap_ok &= std::abs(floating.swap_delta(tour, i, j) -
+                                (floating.evaluate(swapped).value - base)) < 1e-9;
+
+            if (i > j)
+                continue;
+            auto reversed = tour;
+            std::reverse(reversed.begin() + i, reversed.begin() + j + 1);
+            reversal_ok &=
+                exact.reversal_delta(tour, i, j) == exact.evaluate(reversed).value - base;
+
+            for (std::size_t pos = 0; pos <= n - (j - i + 1); ++pos) {
+                std::vector<int> moved(tour.begin(), tour.begin() + i);
+                moved.insert(moved.end(), tour.begin() + j + 1, tour.end());
+                moved.insert(moved.begin() + pos, tour.begin() + i, tour.begin() + j + 1);
+                segment_ok &= exact.segment_move_delta(tour, i, j, pos) ==
+                              exact.evaluate(moved).value - base;
+            }
+        }
+    }
+    result.assert_true(swap_ok, "swap_delta matches full re-evaluation");
+    result.assert_true(reversal_ok, "reversal_delta matches full re-evaluation");
+    result.assert_true(segment_ok, "segment_move_delta matches full re-evaluation");
+
+    // mutate_with_delta must apply the same move as mutate and report its exact cost
+    auto check_operator = [&](const auto& op, const std::string& name) {
+        bool same_genome = true;
+        bool exact_delta = true;
+        for (unsigned seed = 0; seed < 200; ++seed) {
+            std::mt19937 rng_a(seed);
+            std::mt19937 rng_b(seed);
+            auto plain = tour;
+            auto incremental = tour;
+            op.mutate(exact, plain, rng_a);
+            const double delta = op.mutate_with_delta(exact, incremental, rng_b);
+            same_genome &= plain == incremental && rng_a == rng_b;
+            exact_delta &= base + delta == exact.evaluate(incremental).value;
+        }
+        result.assert_true(same_genome, name + " mutate_with_delta matches mutate");
+        result.assert_true(exact_delta, name + " delta is exact on integral distances");
+    };
+    check_operator(operators::SwapMutation{}, "Swap");
+    check_operator(operators::InversionMutation{}, "Inversion");
+    check_operator(operators::InsertionMutation{}, "Insertion");
+    check_operator(operators::DisplacementMutation{}, "Displacement");
+    check_operator(operators::TwoOptMutation{}, "TwoOpt");
+    check_operator(operators::MultiSwapMutation{3}, "MultiSwap");
+
+    // With exact deltas the GA trajectory must not depend on delta_evaluation
+    for (bool parallel : {false, true}) {
+        auto run = [&](bool delta) {
+            auto ga = core::make_ga(operators::TournamentSelection{3},
+                                    operators::OrderCrossover{}, operators::InversionMutation{});
+            return ga.run(exact, core::GAConfig{.population_size = 30,
+                                                .max_generations = 40,
+                                                .crossover_prob = 0.5,
+                                                .mutation_prob = 0.8,
+                                                .seed = 11,
+                                                .log_interval = 100,
+                                                .parallel_generation = parallel,
+                                                .delta_evaluation = delta});
+        };
+        const auto with_delta = run(true);
+        const auto without_delta = run(false);
+        const std::string mode = parallel ? " (parallel)" : " (serial)";
+        result.assert_true(with_delta.best_genome == without_delta.best_genome &&
+                               with_delta.best_fitness == without_delta.best_fitness,
+                           "Delta evaluation does not change the GA result" + mode);
+        result.assert_true(with_delta.best_fitness == exact.evaluate(with_delta.best_genome),
+                           "Delta-scored best fitness matches its tour" + mode);
+        result.assert_equals(without_delta.evaluations, with_delta.evaluations,
+                             "Delta evaluation keeps the evaluation count" + mode);
+    }
+
+    result.print_summary();
+}
+
 void test_local_search() {
     TestResult result;
 
@@ -308,6 +457,277 @@ void test_local_search() {
     result.print_summary();
 }
 
+void test_candidate_two_opt() {
+    TestResult result;
+
+    constexpr int n = 200;
+    auto tsp = problems::create_random_tsp(n, 1000.0, 7);
+    std::mt19937 rng(11);
+    const auto start = tsp.random_genome(rng);
+
+    for (bool first_improvement : {true, false}) {
+        const std::string mode = first_improvement ? "first" : "best";
+
+        // With every other city as a candidate, the queue-driven search must end 2-optimal
+        auto tour = start;
+        const auto fitness =
+            local_search::CandidateList2Opt(n - 1, first_improvement).improve(tsp, tour, rng);
+        result.assert_true(tsp.is_valid_tour(tour), mode + ": valid tour");
+        result.assert_equals(tsp.evaluate(tour).value, fitness.value,
+                             mode + ": tracked length matches evaluation", 1e-6);
+
+        auto checked = tour;
+        const auto full = local_search::TwoOpt(false).improve(tsp, checked, rng);
+        result.assert_equals(fitness.value, full.value, mode + ": result is 2-optimal", 1e-6);
+
+        // Nearly converged input (one random move away from a local optimum) is repaired
+        auto perturbed = tour;
+        std::reverse(perturbed.begin() + 40, perturbed.begin() + 120);
+        const auto perturbed_fitness = tsp.evaluate(perturbed);
+        const auto repaired =
+            local_search::CandidateList2Opt(10, first_improvement).improve(tsp, perturbed, rng);
+        result.assert_true(tsp.is_valid_tour(perturbed) &&
+                               repaired.value < perturbed_fitness.value,
+                           mode + ": perturbed optimum is improved");
+
+        // A converged tour is left untouched
+        auto again = tour;
+        local_search::CandidateList2Opt(n - 1, first_improvement).improve(tsp, again, rng);
+        result.assert_true(again == tour, mode + ": converged tour is unchanged");
+    }
+
+    result.print_summary();
+}
+
+void test_or_opt() {
+    TestResult result;
+
+    // Cities on a line; the optimal tour runs out and back, length 18
+    std::vector<std::pair<double, double>> line;
+    for (int i = 0; i < 10; ++i) {
+        line.emplace_back(static_cast<double>(i), 0.0);
+    }
+    problems::TSP tsp(line);
+    std::mt19937 rng(42);
+
+    const std::vector<std::vector<int>> defects = {
+        {0, 1, 2, 3, 5, 6, 4, 7, 8, 9}, // Single city out of place
+        {0, 1, 4, 5, 2, 3, 6, 7, 8, 9}, // Two-city segment out of place
+        {5, 2, 3, 6, 7, 8, 9, 0, 1, 4}, // Same, with the segment wrapping around the array end
+        {0, 1, 2, 6, 5, 3, 4, 7, 8, 9}, // Segment that must be reversed
+    };
+    for (const auto& defect : defects) {
+        auto tour = defect;
+        const auto fitness = local_search::OrOpt(9).improve(tsp, tour, rng);
+        result.assert_true(tsp.is_valid_tour(tour), "Or-opt produces valid tour");
+        result.assert_equals(18.0, tsp.evaluate(tour).value, "Or-opt repairs relocation defect");
+        result.assert_equals(18.0, fitness.value, "Or-opt reports the repaired length");
+    }
+
+    // Integral instance: tracked lengths are exact, and the chain never ends behind 2-opt
+    std::string text = "NAME: oropt\nTYPE: TSP\nDIMENSION: 300\nEDGE_WEIGHT_TYPE: EUC_2D\n"
+                       "NODE_COORD_SECTION\n";
+    std::uniform_int_distribution<int> coordinate(0, 2000);
+    for (int i = 0; i < 300; ++i) {
+        text += std::to_string(i + 1) + " " + std::to_string(coordinate(rng)) + " " +
+                std::to_string(coordinate(rng)) + "\n";
+    }
+    const auto instance = problems::TSP::from_tsplib(io::TSPLIBParser::parse_string(text));
+    const auto start = instance.random_genome(rng);
+
+    for (bool first_improvement : {true, false}) {
+        const std::string mode = first_improvement ? "first" : "best";
+
+        auto two_opt_tour = start;
+        const auto two_opt = local_search::CandidateList2Opt(10, first_improvement)
+                                 .improve(instance, two_opt_tour, rng);
+
+        auto or_opt_tour = two_opt_tour;
+        const auto or_opt =
+            local_search::OrOpt(10, 3, first_improvement).improve(instance, or_opt_tour, rng);
+        result.assert_true(instance.is_valid_tour(or_opt_tour), mode + ": Or-opt tour is valid");
+        result.assert_true(or_opt == instance.evaluate(or_opt_tour),
+                           mode + ": Or-opt length is exact");
+        result.assert_true(or_opt < two_opt, mode + ": Or-opt improves a 2-optimal tour");
+
+        auto chained_tour = start;
+        const auto chained = local_search::make_two_opt_or_opt(10, first_improvement)
+                                 .improve(instance, chained_tour, rng);
+        result.assert_true(instance.is_valid_tour(chained_tour), mode + ": chained tour is valid");
+        result.assert_true(chained == instance.evaluate(chained_tour),
+                           mode + ": chained length is exact");
+        result.assert_true(chained < two_opt, mode + ": 2-opt + Or-opt beats 2-opt alone");
+    }
+
+    static_assert(core::LocalSearchOperator<local_search::OrOpt, problems::TSP>);
+    static_assert(core::LocalSearchOperator<local_search::TwoOptOrOpt, problems::TSP>);
+
+    result.print_summary();
+}
+
+void test_tour_representations() {
+    TestResult result;
+    std::mt19937 rng(5);
+
+    // Random flips must keep ArrayTour and TwoLevelList in step with a reference array, in
+    // both orientations and across two-level rebuilds
+    for (int n : {5, 9, 64, 333}) {
+        std::vector<int> reference(n);
+        std::iota(reference.begin(), reference.end(), 0);
+        std::shuffle(reference.begin(), reference.end(), rng);
+        auto array_genome = reference;
+        local_search::ArrayTour array(array_genome);
+        utils::TwoLevelList list(reference);
+
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        bool consistent = true;
+        for (int step = 0; step < 40 * n && consistent; ++step) {
+            // Reverse the path from reference[i] forward to reference[j]
+            const int i = pick(rng);
+            const int j = pick(rng);
+            const int a = reference[i];
+            const int b = reference[j];
+            const int length = (j - i + n) % n + 1;
+            for (int k = 0; k < length / 2; ++k) {
+                std::swap(reference[(i + k) % n], reference[(j - k + n) % n]);
+            }
+            array.flip(a, b);
+            list.flip(a, b);
+
+            const int x = pick(rng);
+            for (int p = 0; p < n; ++p) {
+                const int city = reference[p];
+                const int succ = reference[(p + 1) % n];
+                consistent = consistent && array.next(city) == succ && list.next(city) == succ &&
+                             array.prev(succ) == city && list.prev(succ) == city;
+                // reference[x] lies on the path from reference[p] to reference[(p + 2) % n]
+                // exactly when x is one of those three positions
+                const int c = reference[(p + 2) % n];
+                const bool expected = (x - p + n) % n <= 2;
+                consistent = consistent && array.between(city, reference[x], c) == expected &&
+                             list.between(city, reference[x], c) == expected;
+            }
+        }
+        result.assert_true(consistent, "Tours follow random flips, n = " + std::to_string(n));
+
+        std::vector<int> copied(n);
+        list.copy_to(copied, reference[0]);
+        result.assert_true(copied == reference, "TwoLevelList copies out in tour order");
+    }
+
+    // Both engines make the same moves on either representation, so their results agree
+    using local_search::TourRepresentation;
+    auto tsp = problems::create_random_tsp(500, 1000.0, 3);
+    const auto start = tsp.random_genome(rng);
+    for (bool first_improvement : {true, false}) {
+        const std::string mode = first_improvement ? "first" : "best";
+        std::vector<double> two_opt_lengths;
+        std::vector<double> or_opt_lengths;
+        for (auto representation : {TourRepresentation::Array, TourRepresentation::TwoLevelList}) {
+            const local_search::CandidateList2Opt two_opt_search(10, first_improvement,
+                                                                 representation);
+            const local_search::OrOpt or_opt_search(10, 3, first_improvement, representation);
+
+            auto tour = start;
+            const auto two_opt = two_opt_search.improve(tsp, tour, rng);
+            result.assert_true(tsp.is_valid_tour(tour), mode + ": 2-opt tour is valid");
+            result.assert_equals(tsp.evaluate(tour).value, two_opt.value,
+                                 mode + ": 2-opt length matches evaluation", 1e-6);
+            two_opt_lengths.push_back(two_opt.value);
+
+            tour = start;
+            const auto or_opt = or_opt_search.improve(tsp, tour, rng);
+            result.assert_true(tsp.is_valid_tour(tour), mode + ": Or-opt tour is valid");
+            result.assert_equals(tsp.evaluate(tour).value, or_opt.value,
+                                 mode + ": Or-opt length matches evaluation", 1e-6);
+            or_opt_lengths.push_back(or_opt.value);
+        }
+        result.assert_equals(two_opt_lengths[0], two_opt_lengths[1],
+                             mode + ": 2-opt agrees across representations", 1e-6);
+        result.assert_equals(or_opt_lengths[0], or_opt_lengths[1],
+                             mode + ": Or-opt agrees across representations", 1e-6);
+    }
+
+    // LK chains undo their unprofitable tails by flipping paths back, on either representation
+    std::vector<double> lk_lengths;
+    for (auto representation : {TourRepresentation::Array, TourRepresentation::TwoLevelList}) {
+        const local_search::LinKernighan lk(10, local_search::LinKernighan::DEFAULT_MAX_DEPTH,
+                                            local_search::LinKernighan::DEFAULT_BREADTH,
+                                            representation);
+        auto tour = start;
+        const auto fitness = lk.improve(tsp, tour, rng);
+        result.assert_true(tsp.is_valid_tour(tour), "LK tour is valid");
+        result.assert_equals(tsp.evaluate(tour).value, fitness.value,
+                             "LK length matches evaluation", 1e-6);
+        lk_lengths.push_back(fitness.value);
+    }
+    result.assert_equals(lk_lengths[0], lk_lengths[1], "LK agrees across representations", 1e-6);
+
+    static_assert(local_search::FlipTour<local_search::ArrayTour>);
+    static_assert(local_search::FlipTour<utils::TwoLevelList>);
+
+    result.print_summary();
+}
+
+void test_lin_kernighan() {
+    TestResult result;
+    std::mt19937 rng(42);
+
+    // Relocation and reversal defects on a line are fixed by short chains
+    std::vector<std::pair<double, double>> line;
+    for (int i = 0; i < 10; ++i) {
+        line.emplace_back(static_cast<double>(i), 0.0);
+    }
+    problems::TSP tsp(line);
+    for (const auto& defect : std::vector<std::vector<int>>{{0, 1, 2, 3, 5, 6, 4, 7, 8, 9},
+                                                            {5, 2, 3, 6, 7, 8, 9, 0, 1, 4},
+                                                            {0, 1, 2, 6, 5, 3, 4, 7, 8, 9}}) {
+        auto tour = defect;
+        const auto fitness = local_search::LinKernighan(9).improve(tsp, tour, rng);
+        result.assert_true(tsp.is_valid_tour(tour), "LK produces valid tour");
+        result.assert_equals(18.0, fitness.value, "LK repairs defect on a line");
+    }
+
+    // Integral instance: exact tracked length, and deeper moves beat the 2-opt optimum
+    std::string text = "NAME: lk\nTYPE: TSP\nDIMENSION: 400\nEDGE_WEIGHT_TYPE: EUC_2D\n"
+                       "NODE_COORD_SECTION\n";
+    std::uniform_int_distribution<int> coordinate(0, 5000);
+    for (int i = 0; i < 400; ++i) {
+        text += std::to_string(i + 1) + " " + std::to_string(coordinate(rng)) + " " +
+                std::to_string(coordinate(rng)) + "\n";
+    }
+    const auto instance = problems::TSP::from_tsplib(io::TSPLIBParser::parse_string(text));
+    const auto start = instance.random_genome(rng);
+
+    auto two_opt_tour = start;
+    const auto two_opt = local_search::CandidateList2Opt(10).improve(instance, two_opt_tour, rng);
+
+    auto tour = start;
+    const auto lk = local_search::LinKernighan().improve(instance, tour, rng);
+    result.assert_true(instance.is_valid_tour(tour), "LK tour is valid");
+    result.assert_true(lk == instance.evaluate(tour), "LK length is exact");
+    result.assert_true(lk < two_opt, "LK beats candidate 2-opt");
+
+    // Restarting from its own result never loses ground, and LK also improves a 2-optimal tour
+    auto again = tour;
+    const auto restarted = local_search::LinKernighan().improve(instance, again, rng);
+    result.assert_true(restarted <= lk && restarted == instance.evaluate(again),
+                       "LK restarted on its own result does not get worse");
+    const auto polished = local_search::LinKernighan().improve(instance, two_opt_tour, rng);
+    result.assert_true(polished < two_opt && instance.is_valid_tour(two_opt_tour),
+                       "LK improves a 2-optimal tour");
+
+    // Shallow chains still work
+    auto shallow = start;
+    const auto depth_one = local_search::LinKernighan(10, 1, 1).improve(instance, shallow, rng);
+    result.assert_true(instance.is_valid_tour(shallow) && depth_one == instance.evaluate(shallow),
+                       "Depth-one LK is exact");
+
+    static_assert(core::LocalSearchOperator<local_search::LinKernighan, problems::TSP>);
+
+    result.print_summary();
+}
+
 void test_factory_functions() {
     TestResult result;
 
@@ -339,6 +759,31 @@ void test_factory_functions() {
     result.assert_true(std::isfinite(result_tsp_advanced.best_fitness.value),
                        "Best fitness is finite");
 
+    // Local search engine selected from configuration
+    config::Config cfg;
+    cfg.ga.population_size = 20;
+    cfg.ga.max_generations = 5;
+    cfg.local_search.enabled = true;
+    for (std::size_t i = 0; i < config::LocalSearchConfig::TYPES.size(); ++i) {
+        cfg.local_search.type = config::LocalSearchConfig::TYPES[i];
+        const factory::ConfiguredLocalSearch configured(cfg.local_search);
+        result.assert_eq(i, configured.index(), cfg.local_search.type + " selects its engine");
+
+        auto ga = factory::make_tsp_ga_with_local_search_from_config(cfg);
+        auto configured_result = ga.run(tsp, cfg.to_ga_config());
+        result.assert_true(tsp.is_valid_tour(configured_result.best_genome),
+                           cfg.local_search.type + " GA produces valid solution");
+    }
+
+    cfg.local_search.type = "3-opt";
+    bool rejected = false;
+    try {
+        factory::ConfiguredLocalSearch unknown(cfg.local_search);
+    } catch (const config::ConfigValidationError&) {
+        rejected = true;
+    }
+    result.assert_true(rejected, "Unknown local search type is rejected");
+
     result.print_summary();
 }
 
@@ -355,9 +800,24 @@ int main() {
     std::cout << "\nTesting Mutation Operators...\n";
     test_mutation_operators();
 
+    std::cout << "\nTesting Delta-Evaluated Mutations...\n";
+    test_delta_mutations();
+
     std::cout << "\nTesting Local Search...\n";
     test_local_search();
 
+    std::cout << "\nTesting Candidate List 2-opt...\n";
+    test_candidate_two_opt();
+
+    std::cout << "\nTesting Or-opt...\n";
+    test_or_opt();
+
+    std::cout << "\nTesting Tour Representations...\n";
+    test_tour_representations();
+
+    std::cout << "\nTesting Lin-Kernighan...\n";
+    test_lin_kernighan();
+
     std::cout << "\nTesting Factory Functions...\n";
     test_factory_functions();
 
@@ -271,6 +271,57 @@ std::vector<Fitness> evaluate_sequential(const TSP& tsp,
     return result.all_passed();
 }
 
+// Parallel offspring generation must not depend on the number of worker threads: every
+// offspring pair derives its own RNG stream from (seed, generation, pair index)
+[[nodiscard]] bool test_parallel_generation_determinism() {
+    TestResult result;
+
+    auto tsp = create_random_tsp(30, 100.0, 42);
+
+    auto run_with_threads = [&tsp](std::size_t threads) {
+        auto ga = evolab::core::make_ga(evolab::operators::TournamentSelection{4},
+                                        evolab::operators::OrderCrossover{},
+                                        evolab::operators::InversionMutation{},
+                                        evolab::local_search::TwoOpt{true, 20});
+        evolab::core::GAConfig config{.population_size = 41,
+                                      .max_generations = 15,
+                                      .mutation_prob = 0.3,
+                                      .elite_ratio = 0.05,
+                                      .seed = 7,
+                                      .log_interval = 1,
+                                      .parallel_generation = true,
+                                      .num_threads = threads,
+                                      .parallel_chunk_size = 2};
+        return ga.run(tsp, config);
+    };
+
+    const auto reference = run_with_threads(1);
+    result.assert_true(tsp.is_valid_tour(reference.best_genome),
+                       "Parallel generation produces a valid tour");
+
+    for (std::size_t threads : {2UZ, 4UZ, 0UZ}) {
+        const auto other = run_with_threads(threads);
+        result.assert_true(other.best_genome == reference.best_genome,
+                           std::format("Best tour identical with {} threads", threads));
+        result.assert_true(other.best_fitness.value == reference.best_fitness.value,
+                           std::format("Best fitness identical with {} threads", threads));
+        result.assert_eq(other.evaluations, reference.evaluations,
+                         std::format("Evaluation count identical with {} threads", threads));
+
+        bool history_matches = other.history.size() == reference.history.size();
+        for (std::size_t i = 0; history_matches && i < other.history.size(); ++i) {
+            history_matches =
+                other.history[i].mean_fitness.value == reference.history[i].mean_fitness.value;
+        }
+        result.assert_true(history_matches,
+                           std::format("Per-generation statistics identical with {} threads",
+                                       threads));
+    }
+
+    result.print_summary();
+    return result.all_passed();
+}
+
 } // anonymous namespace
 
 int main() {
@@ -291,8 +342,11 @@ int main() {
         const bool edge_cases_passed = test_edge_cases();
         std::cout << '\n';
 
-        const bool all_tests_passed =
-            correctness_passed && reproducibility_passed && performance_passed && edge_cases_passed;
+        const bool generation_passed = test_parallel_generation_determinism();
+        std::cout << '\n';
+
+        const bool all_tests_passed = correctness_passed && reproducibility_passed &&
+                                      performance_passed && edge_cases_passed && generation_passed;
 
         std::cout << "==============================" << '\n';
         std::cout << "Parallel tests completed." << '\n';
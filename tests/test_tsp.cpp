@@ -1,7 +1,15 @@
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <numeric>
+#include <span>
+#include <string>
 
 #include <evolab/evolab.hpp>
 
@@ -167,6 +175,43 @@ void test_two_opt_operations() {
     result.assert_true(improved_fitness < bad_fitness, "2-opt application improves fitness");
     result.assert_true(tsp.is_valid_tour(improved_tour), "2-opt result is valid tour");
 
+    // Long inner segments are applied by reversing the rest of the tour: same cycle, fewer
+    // cities moved, and a maintained position index stays in sync
+    auto ring = problems::create_random_tsp(12, 100.0, 3);
+    const auto base = ring.identity_genome();
+    auto successors = [](const std::vector<int>& t, bool backwards) {
+        std::vector<int> next(t.size());
+        for (std::size_t p = 0; p < t.size(); ++p) {
+            const int a = t[p];
+            const int b = t[(p + 1) % t.size()];
+            next[backwards ? b : a] = backwards ? a : b;
+        }
+        return next;
+    };
+    for (auto [i, j] : {std::pair{1, 4}, std::pair{0, 10}, std::pair{2, 11}}) {
+        auto expected = base;
+        std::reverse(expected.begin() + i + 1, expected.begin() + j + 1);
+
+        auto applied = base;
+        std::vector<int> position(base.size());
+        std::iota(position.begin(), position.end(), 0);
+        ring.apply_two_opt(applied, i, j, position);
+
+        const std::string move = std::to_string(i) + "," + std::to_string(j);
+        result.assert_true(successors(applied, false) == successors(expected, false) ||
+                               successors(applied, true) == successors(expected, false),
+                           "2-opt (" + move + ") gives the same cycle");
+        bool in_sync = true;
+        std::size_t moved = 0;
+        for (std::size_t p = 0; p < applied.size(); ++p) {
+            in_sync = in_sync && position[applied[p]] == static_cast<int>(p);
+            moved += applied[p] != base[p] ? 1 : 0;
+        }
+        result.assert_true(in_sync, "2-opt (" + move + ") keeps positions in sync");
+        result.assert_true(2 * moved <= base.size(),
+                           "2-opt (" + move + ") moves at most half the tour");
+    }
+
     result.print_summary();
 }
 
@@ -191,6 +236,702 @@ void test_tsp_with_ga() {
     result.print_summary();
 }
 
+// Node coordinates of TSPLIB burma14
+const std::string BURMA14_COORDS = R"(NODE_COORD_SECTION
+1 16.47 96.10
+2 16.47 94.44
+3 20.09 92.54
+4 22.39 93.37
+5 25.23 97.24
+6 22.00 96.05
+7 20.47 97.02
+8 17.20 96.29
+9 16.30 97.38
+10 14.05 98.12
+11 16.53 97.38
+12 21.52 95.59
+13 19.41 97.13
+14 20.09 94.55
+EOF
+)";
+
+void test_lazy_distance_mode() {
+    TestResult result;
+
+    // burma14 coordinates, evaluated under every metric lazy mode supports
+    for (const std::string type : {"EUC_2D", "CEIL_2D", "ATT", "GEO"}) {
+        auto instance = io::TSPLIBParser::parse_string(
+            "NAME: lazy\nTYPE: TSP\nDIMENSION: 14\nEDGE_WEIGHT_TYPE: " + type + "\n" +
+            BURMA14_COORDS);
+        auto dense = problems::TSP::from_tsplib(instance);
+        auto lazy = problems::TSP::from_tsplib(instance, problems::DistanceMode::Lazy);
+
+        bool all_equal = true;
+        for (int i = 0; i < 14; ++i) {
+            for (int j = 0; j < 14; ++j) {
+                all_equal = all_equal && dense.distance(i, j) == lazy.distance(i, j);
+            }
+        }
+        result.assert_true(all_equal, type + ": lazy distances match the matrix");
+        result.assert_true(lazy.is_lazy() && !dense.is_lazy(), type + ": storage mode reported");
+
+        std::mt19937 rng(7);
+        auto tour = dense.random_genome(rng);
+        result.assert_equals(dense.evaluate(tour).value, lazy.evaluate(tour).value,
+                             type + ": lazy evaluation matches the matrix");
+
+        auto dense_tour = tour;
+        auto lazy_tour = tour;
+        local_search::TwoOpt two_opt(false);
+        const auto dense_fitness = two_opt.improve(dense, dense_tour, rng);
+        const auto lazy_fitness = two_opt.improve(lazy, lazy_tour, rng);
+        result.assert_true(dense_tour == lazy_tour, type + ": 2-opt takes identical moves");
+        result.assert_equals(dense_fitness.value, lazy_fitness.value,
+                             type + ": 2-opt reaches identical fitness");
+
+        const auto* dense_candidates = dense.get_candidate_list(5);
+        const auto* lazy_candidates = lazy.get_candidate_list(5);
+        bool same_candidates = true;
+        for (int city = 0; city < 14; ++city) {
+            same_candidates =
+                same_candidates && std::ranges::equal(dense_candidates->get_candidates(city),
+                                                      lazy_candidates->get_candidates(city));
+        }
+        result.assert_true(same_candidates, type + ": candidate lists match the matrix");
+    }
+
+    // Memory footprint is linear in the number of cities
+    std::vector<std::pair<double, double>> cities;
+    for (int i = 0; i < 2000; ++i) {
+        cities.emplace_back(i % 97, i / 97);
+    }
+    problems::TSP lazy(cities, problems::DistanceMode::Lazy);
+    result.assert_true(lazy.distance_memory_bytes() == cities.size() * 2 * sizeof(double),
+                       "Lazy storage holds only coordinates");
+    result.assert_equals(std::sqrt(2.0), lazy.distance(0, 98), "Lazy Euclidean distance is exact",
+                         1e-12);
+
+    // Explicit-weight instances have no coordinates to compute from
+    auto explicit_instance = io::TSPLIBParser::parse_string(R"(NAME: explicit
+TYPE: TSP
+DIMENSION: 3
+EDGE_WEIGHT_TYPE: EXPLICIT
+EDGE_WEIGHT_FORMAT: FULL_MATRIX
+EDGE_WEIGHT_SECTION
+0 1 2
+1 0 3
+2 3 0
+EOF
+)");
+    bool threw = false;
+    try {
+        (void)problems::TSP::from_tsplib(explicit_instance, problems::DistanceMode::Lazy);
+    } catch (const io::TSPLIBDataError&) {
+        threw = true;
+    }
+    result.assert_true(threw, "Lazy mode rejects EXPLICIT instances");
+
+    result.print_summary();
+}
+
+void test_compact_distance_storage() {
+    TestResult result;
+
+    auto instance = io::TSPLIBParser::parse_string(
+        "NAME: burma14\nTYPE: TSP\nDIMENSION: 14\nEDGE_WEIGHT_TYPE: GEO\n" + BURMA14_COORDS);
+    auto reference = problems::TSP::from_tsplib(instance);
+    const int n = reference.num_cities();
+
+    std::mt19937 rng(11);
+    const auto tour = reference.random_genome(rng);
+    auto reference_tour = tour;
+    local_search::TwoOpt two_opt(false);
+    const auto reference_fitness = two_opt.improve(reference, reference_tour, rng);
+
+    using problems::DistancePrecision;
+    using problems::MatrixLayout;
+    for (auto layout : {MatrixLayout::Full, MatrixLayout::Triangular}) {
+        for (auto precision :
+             {DistancePrecision::Float64, DistancePrecision::Float32, DistancePrecision::Int32}) {
+            const std::string label =
+                std::string(layout == MatrixLayout::Full ? "Full" : "Triangular") + "/" +
+                (precision == DistancePrecision::Float64   ? "Float64"
+                 : precision == DistancePrecision::Float32 ? "Float32"
+                                                           : "Int32");
+            auto compact = problems::TSP::from_tsplib(
+                instance, problems::DistanceOptions{.layout = layout, .precision = precision});
+
+            bool all_equal = true;
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    all_equal = all_equal && compact.distance(i, j) == reference.distance(i, j);
+                }
+            }
+            result.assert_true(all_equal, label + ": distances match the double matrix");
+            result.assert_equals(reference.evaluate(tour).value, compact.evaluate(tour).value,
+                                 label + ": evaluation matches");
+            result.assert_equals(reference.two_opt_gain(tour, 2, 9),
+                                 compact.two_opt_gain(tour, 2, 9), label + ": 2-opt gain matches");
+
+            auto compact_tour = tour;
+            const auto compact_fitness = two_opt.improve(compact, compact_tour, rng);
+            result.assert_true(compact_tour == reference_tour,
+                               label + ": 2-opt takes identical moves");
+            result.assert_equals(reference_fitness.value, compact_fitness.value,
+                                 label + ": 2-opt reaches identical fitness");
+            result.assert_true(!compact.is_lazy(), label + ": reported as a matrix");
+        }
+    }
+
+    // Memory savings at a size where they matter
+    std::vector<std::pair<double, double>> cities;
+    for (int i = 0; i < 500; ++i) {
+        cities.emplace_back((i * 37) % 101, (i * 53) % 89);
+    }
+    problems::TSP dense(cities);
+    problems::TSP packed_float(cities, problems::DistanceOptions{
+                                           .layout = MatrixLayout::Triangular,
+                                           .precision = DistancePrecision::Float32});
+    result.assert_true(packed_float.distance_memory_bytes() * 3 < dense.distance_memory_bytes(),
+                       "Packed float32 matrix uses under a third of the double matrix");
+    result.assert_equals(dense.distance(3, 250), packed_float.distance(3, 250),
+                         "Float32 distance within single precision", 1e-4);
+    result.assert_equals(dense.distance(250, 3), packed_float.distance(250, 3),
+                         "Packed layout is symmetric", 1e-4);
+
+    // Int32 requires integral distances
+    bool threw = false;
+    try {
+        problems::TSP raw(cities, problems::DistanceOptions{.precision = DistancePrecision::Int32});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    result.assert_true(threw, "Int32 rejects unrounded Euclidean distances");
+
+    auto fractional = io::TSPLIBParser::parse_string(R"(NAME: fractional
+TYPE: TSP
+DIMENSION: 3
+EDGE_WEIGHT_TYPE: MAN_2D
+NODE_COORD_SECTION
+1 0.0 0.0
+2 1.5 0.0
+3 0.0 2.25
+EOF
+)");
+    threw = false;
+    try {
+        (void)problems::TSP::from_tsplib(
+            fractional, problems::DistanceOptions{.precision = DistancePrecision::Int32});
+    } catch (const io::TSPLIBDataError&) {
+        threw = true;
+    }
+    result.assert_true(threw, "Int32 from_tsplib reports non-integral distances");
+
+    auto packed_fractional = problems::TSP::from_tsplib(
+        fractional, problems::DistanceOptions{.layout = MatrixLayout::Triangular});
+    result.assert_equals(3.75, packed_fractional.distance(2, 1),
+                         "Packed layout serves non-coordinate metrics");
+
+    result.print_summary();
+}
+
+void test_integer_distance_path() {
+    TestResult result;
+
+    // Rounded TSPLIB metrics select int32 storage automatically
+    auto burma = problems::TSP::from_tsplib(io::TSPLIBParser::parse_string(
+        "NAME: burma14\nTYPE: TSP\nDIMENSION: 14\nEDGE_WEIGHT_TYPE: GEO\n" + BURMA14_COORDS));
+    result.assert_true(burma.has_integral_distances(), "GEO instance uses integral distances");
+    result.assert_true(burma.distance_memory_bytes() == 14 * 14 * sizeof(std::int32_t),
+                       "GEO instance stored as an int32 matrix");
+
+    // Build a 200-city EUC_2D instance with awkward coordinates
+    std::string euc = "NAME: euc200\nTYPE: TSP\nDIMENSION: 200\nEDGE_WEIGHT_TYPE: EUC_2D\n"
+                      "NODE_COORD_SECTION\n";
+    std::mt19937 coord_rng(5);
+    std::uniform_real_distribution<double> coord(0.0, 10000.0);
+    for (int i = 1; i <= 200; ++i) {
+        euc += std::to_string(i) + " " + std::to_string(coord(coord_rng)) + " " +
+               std::to_string(coord(coord_rng)) + "\n";
+    }
+    euc += "EOF\n";
+    auto euc_instance = io::TSPLIBParser::parse_string(euc);
+    auto exact = problems::TSP::from_tsplib(euc_instance);
+    auto lazy = problems::TSP::from_tsplib(euc_instance, problems::DistanceMode::Lazy);
+    auto floating = problems::TSP::from_tsplib(
+        euc_instance, problems::DistanceOptions{.precision = problems::DistancePrecision::Float64});
+    result.assert_true(exact.has_integral_distances() && lazy.has_integral_distances(),
+                       "EUC_2D matrix and lazy storage are integral");
+    result.assert_true(!floating.has_integral_distances(), "Explicit Float64 request is honored");
+
+    // Incremental tour length tracking is exact: no drift against a full re-evaluation
+    std::mt19937 rng(3);
+    const auto start = exact.random_genome(rng);
+    bool exact_everywhere = true;
+    for (const auto* problem : {&exact, &lazy}) {
+        auto tour = start;
+        const auto two_opt_fitness = local_search::TwoOpt(true).improve(*problem, tour, rng);
+        exact_everywhere = exact_everywhere && two_opt_fitness == problem->evaluate(tour);
+
+        tour = start;
+        const auto candidate_fitness =
+            local_search::CandidateList2Opt(10, false).improve(*problem, tour, rng);
+        exact_everywhere = exact_everywhere && candidate_fitness == problem->evaluate(tour);
+
+        tour = start;
+        const auto random_fitness = local_search::Random2Opt(500).improve(*problem, tour, rng);
+        exact_everywhere = exact_everywhere && random_fitness == problem->evaluate(tour);
+    }
+    result.assert_true(exact_everywhere, "2-opt engines report exact integral tour lengths");
+
+    auto tour = start;
+    const auto exact_fitness = local_search::TwoOpt(false).improve(exact, tour, rng);
+    auto floating_tour = start;
+    const auto floating_fitness = local_search::TwoOpt(false).improve(floating, floating_tour, rng);
+    result.assert_true(tour == floating_tour, "Integer and double paths take the same moves");
+    result.assert_equals(floating.evaluate(floating_tour).value, exact_fitness.value,
+                         "Integer path matches the double path");
+    result.assert_equals(floating_fitness.value, exact_fitness.value,
+                         "Double path agrees within tolerance", 1e-6);
+
+    // The double matrix accessor works for every back-end, not only Float64 storage
+    bool matrices_match = true;
+    for (const auto* problem : {&exact, &lazy, &floating}) {
+        const auto& matrix = problem->distance_matrix();
+        const int n = problem->num_cities();
+        matrices_match = matrices_match && matrix.size() == static_cast<std::size_t>(n) * n;
+        for (int i = 0; matrices_match && i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                matrices_match = matrices_match && matrix[i * n + j] == problem->distance(i, j);
+            }
+        }
+    }
+    result.assert_true(matrices_match, "distance_matrix() matches distance() for all storage");
+    const bool in_place = floating.visit_distance([&](const auto& dist) {
+        if constexpr (requires { dist.data(); }) {
+            return static_cast<const void*>(dist.data().data()) ==
+                   static_cast<const void*>(floating.distance_matrix().data());
+        } else {
+            return false;
+        }
+    });
+    result.assert_true(in_place, "Float64 matrix is returned without a copy");
+
+    // Non-rounding metrics and oversized distances stay in double precision
+    auto explicit_tsp = problems::TSP::from_tsplib(io::TSPLIBParser::parse_string(R"(NAME: explicit
+TYPE: TSP
+DIMENSION: 3
+EDGE_WEIGHT_TYPE: EXPLICIT
+EDGE_WEIGHT_FORMAT: FULL_MATRIX
+EDGE_WEIGHT_SECTION
+0 1 2
+1 0 3
+2 3 0
+EOF
+)"));
+    result.assert_true(!explicit_tsp.has_integral_distances(), "EXPLICIT instance stays double");
+    result.assert_equals(9.0, static_cast<double>(explicit_tsp.distance_matrix().size()),
+                         "EXPLICIT instance keeps the double matrix");
+
+    auto huge = problems::TSP::from_tsplib(io::TSPLIBParser::parse_string(R"(NAME: huge
+TYPE: TSP
+DIMENSION: 2
+EDGE_WEIGHT_TYPE: EUC_2D
+NODE_COORD_SECTION
+1 0 0
+2 5000000000 0
+EOF
+)"));
+    result.assert_true(!huge.has_integral_distances(), "Auto falls back to double on overflow");
+    result.assert_equals(5e9, huge.distance(0, 1), "Oversized distance kept exactly");
+
+    result.print_summary();
+}
+
+void test_batch_evaluation() {
+    TestResult result;
+
+    using problems::DistancePrecision;
+    using utils::SimdLevel;
+    std::vector<SimdLevel> levels{SimdLevel::Scalar};
+    for (auto level : {SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (utils::cpu_supports(level))
+            levels.push_back(level);
+    }
+
+    std::mt19937 rng(21);
+    for (int n : {1, 2, 7, 8, 9, 16, 17, 100, 257}) {
+        // Integral distances so the same matrix can be stored at every precision
+        std::uniform_int_distribution<int> weight(1, 1000);
+        std::vector<double> matrix(static_cast<std::size_t>(n) * n, 0.0);
+        for (int i = 0; i < n; ++i) {
+            for (int j = i + 1; j < n; ++j) {
+                matrix[i * n + j] = matrix[j * n + i] = weight(rng) + 0.25 * (j % 2);
+            }
+        }
+        std::vector<double> integral = matrix;
+        for (auto& d : integral) {
+            d = std::floor(d);
+        }
+
+        // TSP owns a mutex and is not movable, so the variants are held by pointer
+        std::vector<std::unique_ptr<problems::TSP>> problems_under_test;
+        problems_under_test.push_back(std::make_unique<problems::TSP>(n, matrix));
+        problems_under_test.push_back(std::make_unique<problems::TSP>(
+            n, matrix, problems::DistanceOptions{.precision = DistancePrecision::Float32}));
+        problems_under_test.push_back(std::make_unique<problems::TSP>(
+            n, integral, problems::DistanceOptions{.precision = DistancePrecision::Int32}));
+        problems_under_test.push_back(std::make_unique<problems::TSP>(
+            n, matrix, problems::DistanceOptions{.layout = problems::MatrixLayout::Triangular}));
+
+        std::vector<problems::TSP::GenomeT> tours;
+        std::vector<int> tour_matrix;
+        for (int t = 0; t < 5; ++t) {
+            tours.push_back(problems_under_test.front()->random_genome(rng));
+            tour_matrix.insert(tour_matrix.end(), tours.back().begin(), tours.back().end());
+        }
+
+        bool batch_matches = true;
+        for (const auto& tsp : problems_under_test) {
+            const auto batch = tsp->evaluate_batch(tours);
+            std::vector<core::Fitness> from_matrix(tours.size());
+            tsp->evaluate_batch(std::span<const int>(tour_matrix), from_matrix);
+            for (std::size_t t = 0; t < tours.size(); ++t) {
+                const auto single = tsp->evaluate(tours[t]);
+                batch_matches = batch_matches && batch[t] == single && from_matrix[t] == single;
+            }
+        }
+        result.assert_true(batch_matches,
+                           "n=" + std::to_string(n) + ": batch results equal evaluate()");
+
+        // Every ISA produces bit-identical lengths
+        bool kernels_match = true;
+        std::vector<float> matrix_f(matrix.begin(), matrix.end());
+        std::vector<std::int32_t> matrix_i(integral.begin(), integral.end());
+        for (const auto& tour : tours) {
+            const auto ref_d = problems::kernels::dense_tour_length(matrix.data(), tour.data(), n,
+                                                                    SimdLevel::Scalar);
+            const auto ref_f = problems::kernels::dense_tour_length(matrix_f.data(), tour.data(),
+                                                                    n, SimdLevel::Scalar);
+            const auto ref_i = problems::kernels::dense_tour_length(matrix_i.data(), tour.data(),
+                                                                    n, SimdLevel::Scalar);
+            for (auto level : levels) {
+                kernels_match =
+                    kernels_match &&
+                    problems::kernels::dense_tour_length(matrix.data(), tour.data(), n, level) ==
+                        ref_d &&
+                    problems::kernels::dense_tour_length(matrix_f.data(), tour.data(), n,
+                                                         level) == ref_f &&
+                    problems::kernels::dense_tour_length(matrix_i.data(), tour.data(), n,
+                                                         level) == ref_i;
+            }
+        }
+        result.assert_true(kernels_match,
+                           "n=" + std::to_string(n) + ": all kernel ISAs agree bit for bit");
+    }
+
+    // Lazy instances go through the scalar kernel
+    std::vector<std::pair<double, double>> cities;
+    for (int i = 0; i < 50; ++i) {
+        cities.emplace_back(std::cos(i) * 100.0, std::sin(i * 1.7) * 100.0);
+    }
+    problems::TSP lazy(cities, problems::DistanceMode::Lazy);
+    problems::TSP dense(cities);
+    auto tour = dense.random_genome(rng);
+    std::vector<problems::TSP::GenomeT> single_tour{tour};
+    result.assert_equals(dense.evaluate(tour).value, lazy.evaluate_batch(single_tour)[0].value,
+                         "Lazy batch evaluation matches the dense matrix");
+
+    result.print_summary();
+}
+
+void test_matrix_construction() {
+    TestResult result;
+
+    // Above utils::PARALLEL_MATRIX_MIN_DIMENSION and not a multiple of the SIMD width
+    constexpr int n = 301;
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> coordinate(0, 20000);
+
+    auto make_instance = [&](const std::string& type, bool integral) {
+        std::string text = "NAME: build\nTYPE: TSP\nDIMENSION: " + std::to_string(n) +
+                           "\nEDGE_WEIGHT_TYPE: " + type + "\nNODE_COORD_SECTION\n";
+        for (int i = 0; i < n; ++i) {
+            // GEO coordinates are DDD.MM latitudes/longitudes
+            const double scale = type == "GEO" ? 0.01 : 1.0;
+            const double fraction = integral ? 0.0 : 0.375;
+            text += std::to_string(i + 1) + " " +
+                    std::to_string(coordinate(rng) * scale + fraction) + " " +
+                    std::to_string(coordinate(rng) * scale + fraction) + "\n";
+        }
+        return io::TSPLIBParser::parse_string(text + "EOF\n");
+    };
+
+    for (const std::string type : {"EUC_2D", "CEIL_2D", "ATT", "GEO", "MAN_2D"}) {
+        for (bool integral : {true, false}) {
+            const auto instance = make_instance(type, integral);
+            const std::string label = type + (integral ? " (integral)" : " (fractional)");
+
+            bool full_matrix_ok = true;
+            const auto full = instance.get_full_distance_matrix();
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    full_matrix_ok &= full[i * n + j] == instance.calculate_distance(i, j);
+                }
+            }
+            result.assert_true(full_matrix_ok, label + ": get_full_distance_matrix is exact");
+
+            std::vector<problems::DistanceOptions> variants{
+                {.precision = problems::DistancePrecision::Float64},
+                {.precision = problems::DistancePrecision::Float32},
+                {.layout = problems::MatrixLayout::Triangular,
+                 .precision = problems::DistancePrecision::Float64}};
+            if (integral || type != "MAN_2D") {
+                variants.push_back({.precision = problems::DistancePrecision::Int32});
+                variants.push_back({.layout = problems::MatrixLayout::Triangular,
+                                    .precision = problems::DistancePrecision::Int32});
+            }
+            bool storage_ok = true;
+            for (const auto& options : variants) {
+                const auto tsp = problems::TSP::from_tsplib(instance, options);
+                for (int i = 0; i < n; ++i) {
+                    for (int j = 0; j < n; ++j) {
+                        storage_ok &= tsp.distance(i, j) ==
+                                      static_cast<double>(static_cast<float>(full[i * n + j]));
+                    }
+                }
+            }
+            result.assert_true(storage_ok, label + ": every storage layout matches");
+        }
+    }
+
+    // Coordinate constructor: unrounded Euclidean, integral (vectorized) and fractional input
+    for (double offset : {0.0, 0.1}) {
+        std::vector<std::pair<double, double>> cities;
+        for (int i = 0; i < n; ++i) {
+            cities.emplace_back(coordinate(rng) + offset, coordinate(rng) - offset);
+        }
+        problems::TSP dense(cities);
+        problems::TSP lazy(cities, problems::DistanceMode::Lazy);
+        bool same = true;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                same &= dense.distance(i, j) == lazy.distance(i, j);
+            }
+        }
+        result.assert_true(same, "Coordinate matrix matches on-demand distances (offset " +
+                                     std::to_string(offset) + ")");
+    }
+
+    result.print_summary();
+}
+
+void test_instance_cache() {
+    TestResult result;
+
+    constexpr int n = 150;
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> coordinate(0, 5000);
+    std::string text = "NAME: cached\nCOMMENT: cache round trip\nTYPE: TSP\nDIMENSION: " +
+                       std::to_string(n) + "\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n";
+    for (int i = 0; i < n; ++i) {
+        text += std::to_string(i + 1) + " " + std::to_string(coordinate(rng)) + " " +
+                std::to_string(coordinate(rng)) + "\n";
+    }
+    const auto instance = io::TSPLIBParser::parse_string(text + "EOF\n");
+    const std::uint64_t hash =
+        io::content_hash(std::as_bytes(std::span<const char>(text.data(), text.size())));
+
+    const auto path = (std::filesystem::temp_directory_path() /
+                       ("evolab_test_cache_" + std::to_string(rng()) + ".evc"))
+                          .string();
+
+    std::vector<problems::DistanceOptions> variants{
+        {},
+        {.precision = problems::DistancePrecision::Float64},
+        {.precision = problems::DistancePrecision::Float32},
+        {.layout = problems::MatrixLayout::Triangular,
+         .precision = problems::DistancePrecision::Int32},
+        {.mode = problems::DistanceMode::Lazy}};
+    for (const auto& options : variants) {
+        const auto source = problems::TSP::from_tsplib(instance, options);
+        source.write_cache(path, instance, hash, 8);
+
+        const io::InstanceCache cache(path);
+        const auto cached = problems::TSP::from_cache(cache);
+        const std::string label = std::to_string(source.distance_memory_bytes()) + "-byte storage";
+
+        result.assert_true(cache.source_hash() == hash, label + ": source hash stored");
+        result.assert_true(cache.name() == "cached" && cache.comment() == "cache round trip",
+                           label + ": header stored");
+        result.assert_eq(n, cached.num_cities(), label + ": dimension restored");
+        result.assert_eq(source.distance_memory_bytes(), cached.distance_memory_bytes(),
+                         label + ": same back-end restored");
+
+        bool same = true;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                same &= source.distance(i, j) == cached.distance(i, j);
+            }
+        }
+        result.assert_true(same, label + ": distances match");
+
+        result.assert_true(cached.has_candidate_list(8), label + ": candidate lists adopted");
+        const auto* original = source.get_candidate_list(8);
+        const auto* restored = cached.get_candidate_list(8);
+        bool same_candidates = true;
+        for (int city = 0; city < n; ++city) {
+            same_candidates &=
+                std::ranges::equal(original->get_candidates(city), restored->get_candidates(city));
+        }
+        result.assert_true(same_candidates, label + ": candidate lists match");
+    }
+
+    // The cached view stays valid after the InstanceCache object is gone
+    {
+        const auto source = problems::TSP::from_tsplib(instance);
+        source.write_cache(path, instance, hash);
+        const auto cached = problems::TSP::from_cache(io::InstanceCache(path));
+        result.assert_equals(source.distance(3, 7), cached.distance(3, 7),
+                             "Cache mapping outlives the InstanceCache object");
+        result.assert_true(!cached.has_candidate_list(), "No candidate lists unless requested");
+    }
+
+    auto rejects = [&](const std::string& label, auto&& corrupt) {
+        problems::TSP::from_tsplib(instance).write_cache(path, instance, hash, 8);
+        std::string bytes;
+        {
+            std::ifstream in(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), {});
+        }
+        corrupt(bytes);
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        }
+        bool threw = false;
+        try {
+            problems::TSP::from_cache(io::InstanceCache(path));
+        } catch (const io::InstanceCacheError&) {
+            threw = true;
+        }
+        result.assert_true(threw, label + " is rejected");
+    };
+    rejects("Truncated cache", [](std::string& bytes) { bytes.resize(bytes.size() / 2); });
+    rejects("Wrong magic", [](std::string& bytes) { bytes[0] = 'X'; });
+    rejects("Wrong version", [](std::string& bytes) { bytes[8] = '\x7f'; });
+    rejects("Tiny file", [](std::string& bytes) { bytes.resize(16); });
+
+    // Candidate ids index the matrix and tours, so each must name another city
+    using Header = io::detail::CacheHeader;
+    auto set_candidate = [](std::string& bytes, std::size_t index, int id) {
+        std::uint64_t offset = 0;
+        std::memcpy(&offset, bytes.data() + offsetof(Header, candidates), sizeof(offset));
+        std::memcpy(bytes.data() + offset + index * sizeof(int), &id, sizeof(id));
+    };
+    rejects("Candidate id past the last city",
+            [&](std::string& bytes) { set_candidate(bytes, 8 * 5 + 2, n); });
+    rejects("Negative candidate id", [&](std::string& bytes) { set_candidate(bytes, 3, -1); });
+    rejects("City listed as its own candidate",
+            [&](std::string& bytes) { set_candidate(bytes, 8 * 7, 7); });
+    rejects("Candidate count of n or more", [&](std::string& bytes) {
+        const std::int32_t k = n;
+        const std::uint64_t section_bytes = std::uint64_t{n} * n * sizeof(int);
+        std::memcpy(bytes.data() + offsetof(Header, candidate_k), &k, sizeof(k));
+        std::memcpy(bytes.data() + offsetof(Header, candidates) + sizeof(std::uint64_t),
+                    &section_bytes, sizeof(section_bytes));
+        bytes.resize(bytes.size() + section_bytes);
+    });
+
+    // File hashing keys the cache on content
+    {
+        std::ofstream(path, std::ios::binary) << text;
+        const auto first = io::hash_file(path);
+        std::ofstream(path, std::ios::binary) << text << " ";
+        result.assert_true(first == hash, "hash_file matches content_hash");
+        result.assert_true(io::hash_file(path) != first, "hash_file changes with the content");
+    }
+
+    std::filesystem::remove(path);
+    result.print_summary();
+}
+
+void test_city_reordering() {
+    TestResult result;
+
+    // Hilbert curve over a 2x2 grid visits (0,0), (0,1), (1,1), (1,0)
+    result.assert_true(utils::hilbert_index(0, 0, 1) == 0 && utils::hilbert_index(0, 1, 1) == 1 &&
+                           utils::hilbert_index(1, 1, 1) == 2 && utils::hilbert_index(1, 0, 1) == 3,
+                       "Hilbert index follows the curve");
+    result.assert_true(utils::morton_index(3, 0) == 5 && utils::morton_index(0, 3) == 10,
+                       "Morton index interleaves x and y bits");
+
+    std::string text = "NAME: grid\nTYPE: TSP\nDIMENSION: 400\nEDGE_WEIGHT_TYPE: EUC_2D\n"
+                       "NODE_COORD_SECTION\n";
+    std::mt19937 coord_rng(8);
+    std::uniform_int_distribution<int> coord(0, 5000);
+    for (int i = 1; i <= 400; ++i) {
+        text += std::to_string(i) + " " + std::to_string(coord(coord_rng)) + " " +
+                std::to_string(coord(coord_rng)) + "\n";
+    }
+    const auto instance = io::TSPLIBParser::parse_string(text);
+    const auto source = problems::TSP::from_tsplib(instance);
+    result.assert_true(!source.is_renumbered(), "Source numbering is kept by default");
+
+    for (auto ordering : {problems::CityOrdering::Hilbert, problems::CityOrdering::Morton}) {
+        const std::string name = ordering == problems::CityOrdering::Hilbert ? "Hilbert" : "Morton";
+        const auto reordered =
+            problems::TSP::from_tsplib(instance, problems::DistanceOptions{.ordering = ordering});
+        result.assert_true(reordered.is_renumbered(), name + ": instance is renumbered");
+
+        // Every internal distance is the source distance between the mapped cities
+        bool same_distances = true;
+        for (int i = 0; i < 400; i += 7) {
+            for (int j = 0; j < 400; j += 3) {
+                same_distances = same_distances &&
+                                 reordered.distance(i, j) ==
+                                     source.distance(reordered.original_id(i),
+                                                     reordered.original_id(j));
+            }
+        }
+        result.assert_true(same_distances, name + ": distances follow the renumbering");
+
+        // Consecutive ids are spatial neighbors: the identity tour is far shorter
+        const auto identity = reordered.identity_genome();
+        result.assert_true(reordered.evaluate(identity).value <
+                               0.5 * source.evaluate(source.identity_genome()).value,
+                           name + ": consecutive ids are close in the plane");
+
+        // Tours map back and forth without changing their length
+        std::mt19937 rng(2);
+        const auto tour = reordered.random_genome(rng);
+        const auto original = reordered.to_original(tour);
+        result.assert_true(source.is_valid_tour(original) &&
+                               source.evaluate(original) == reordered.evaluate(tour),
+                           name + ": mapped tour has the same length");
+        result.assert_true(reordered.from_original(original) == tour,
+                           name + ": from_original inverts to_original");
+
+        // The GA reports its best tour in source ids
+        auto ga = core::make_ga(operators::TournamentSelection{3}, operators::OrderCrossover{},
+                                operators::SwapMutation{});
+        const auto ga_result =
+            ga.run(reordered, {.population_size = 20, .max_generations = 5, .seed = 1});
+        result.assert_true(source.evaluate(ga_result.best_genome) == ga_result.best_fitness,
+                           name + ": GA result is in source ids");
+
+        bool rejected = false;
+        try {
+            reordered.write_cache("unused.evc", instance, 0);
+        } catch (const std::logic_error&) {
+            rejected = true;
+        }
+        result.assert_true(rejected, name + ": renumbered instance is not cached");
+    }
+
+    result.print_summary();
+}
+
 int main() {
     std::cout << "Running EvoLab TSP Tests\n";
     std::cout << std::string(30, '=') << "\n\n";
@@ -213,6 +954,27 @@ int main() {
     std::cout << "\nTesting TSP with GA...\n";
     test_tsp_with_ga();
 
+    std::cout << "\nTesting Lazy Distance Mode...\n";
+    test_lazy_distance_mode();
+
+    std::cout << "\nTesting Compact Distance Storage...\n";
+    test_compact_distance_storage();
+
+    std::cout << "\nTesting Integer Distance Path...\n";
+    test_integer_distance_path();
+
+    std::cout << "\nTesting Batch Evaluation...\n";
+    test_batch_evaluation();
+
+    std::cout << "\nTesting Matrix Construction...\n";
+    test_matrix_construction();
+
+    std::cout << "\nTesting Instance Cache...\n";
+    test_instance_cache();
+
+    std::cout << "\nTesting City Reordering...\n";
+    test_city_reordering();
+
     std::cout << "\n" << std::string(30, '=') << "\n";
     std::cout << "TSP tests completed.\n";
 
@@ -558,6 +558,94 @@ EOF
     result.assert_eq(expected, distance, "ATT distance matches manual calculation");
 }
 
+void test_parse_entry_points(TestResult& result) {
+    // CRLF line endings, a leading '+' and an optional z coordinate
+    std::string tsp_content = "NAME : entry\r\nTYPE : TSP\r\nDIMENSION : 3\r\n"
+                              "EDGE_WEIGHT_TYPE : EUC_2D\r\nNODE_COORD_SECTION\r\n"
+                              "1 +1.5 2e1\r\n2 -3 4 7\r\n3 0 0\r\nEOF\r\n";
+
+    TSPInstance from_string = TSPLIBParser::parse_string(tsp_content);
+    std::istringstream stream(tsp_content);
+    TSPInstance from_stream = TSPLIBParser::parse_stream(stream);
+
+    const std::string filename = "test_parse_entry_points.tsp";
+    std::ofstream(filename, std::ios::binary) << tsp_content;
+    TSPInstance from_file = TSPLIBParser::parse_file(filename);
+    std::filesystem::remove(filename);
+
+    result.assert_true(from_string.name == "entry", "CRLF header value is trimmed");
+    result.assert_true(from_string.node_coords[0] == std::array<double, 3>{1.5, 20.0, 0.0},
+                       "Leading '+' and exponent are parsed");
+    result.assert_true(from_string.node_coords[1] == std::array<double, 3>{-3.0, 4.0, 7.0},
+                       "Optional z coordinate is parsed");
+    result.assert_true(from_stream.node_coords == from_string.node_coords &&
+                           from_file.node_coords == from_string.node_coords,
+                       "parse_file, parse_string and parse_stream agree");
+
+    try {
+        TSPLIBParser::parse_file("does_not_exist.tsp");
+        result.assert_true(false, "Should throw TSPLIBFileError for a missing file");
+    } catch (const TSPLIBFileError&) {
+        result.assert_true(true, "Missing file throws TSPLIBFileError");
+    }
+
+    std::string short_matrix = "NAME : short\nTYPE : TSP\nDIMENSION : 3\n"
+                               "EDGE_WEIGHT_TYPE : EXPLICIT\nEDGE_WEIGHT_FORMAT : FULL_MATRIX\n"
+                               "EDGE_WEIGHT_SECTION\n0 1 2\n1 0 3\n\nEOF\n";
+    try {
+        TSPLIBParser::parse_string(short_matrix);
+        result.assert_true(false, "Should throw TSPLIBDataError for a short weight section");
+    } catch (const TSPLIBDataError&) {
+        result.assert_true(true, "Short weight section throws TSPLIBDataError");
+    }
+}
+
+void test_large_weight_section(TestResult& result) {
+    // Above TSPLIBParser::PARALLEL_PARSE_MIN_VALUES, so TBB builds parse it in chunks
+    constexpr int n = 1100;
+    auto weight = [](int i, int j) { return i == j ? 0 : (i * 7919 + j * 104729) % 100000; };
+
+    std::string content = "NAME : large\nTYPE : TSP\nDIMENSION : " + std::to_string(n) +
+                          "\nEDGE_WEIGHT_TYPE : EXPLICIT\nEDGE_WEIGHT_FORMAT : FULL_MATRIX\n"
+                          "EDGE_WEIGHT_SECTION\n";
+    for (int i = 0; i < n; ++i) {
+        // Irregular line breaks, as produced by TSPLIB generators
+        for (int j = 0; j < n; ++j) {
+            content += std::to_string(weight(i, j));
+            content += (i * n + j) % 17 == 16 ? "\n" : " ";
+        }
+    }
+    const std::string weights_only = content + "\nEOF\n";
+    content += "\nDISPLAY_DATA_SECTION\n";
+    for (int i = 0; i < n; ++i) {
+        content += std::to_string(i + 1) + " " + std::to_string(i) + ".5 1\n";
+    }
+    content += "EOF\n";
+
+    TSPInstance instance = TSPLIBParser::parse_string(content);
+    bool matrix_ok = instance.distance_matrix.size() == static_cast<std::size_t>(n) * n;
+    for (int i = 0; matrix_ok && i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            matrix_ok &= instance.distance_matrix[i * n + j] == weight(i, j);
+        }
+    }
+    result.assert_true(matrix_ok, "Large FULL_MATRIX section parsed exactly");
+    result.assert_true(instance.display_coords.size() == static_cast<std::size_t>(n) &&
+                           instance.display_coords[n - 1][0] == n - 0.5,
+                       "Section following a large weight section is parsed");
+
+    // A malformed value falls back to line-wise parsing, which ends the line at the bad token
+    std::string malformed = weights_only;
+    malformed.insert(malformed.find("EDGE_WEIGHT_SECTION\n") + 20, "x ");
+    bool threw = false;
+    try {
+        TSPLIBParser::parse_string(malformed);
+    } catch (const TSPLIBDataError&) {
+        threw = true;
+    }
+    result.assert_true(threw, "Malformed large section reports a size mismatch");
+}
+
 int main() {
     std::cout << "=== EvoLab TSPLIB Parser Tests ===\n\n";
 
@@ -580,6 +668,8 @@ int main() {
     test_error_handling(result);
     test_geographical_distance(result);
     test_att_distance(result);
+    test_parse_entry_points(result);
+    test_large_weight_section(result);
 
     return result.summary();
 }